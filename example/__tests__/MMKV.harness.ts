@@ -6,7 +6,19 @@ import {
   afterEach,
 } from 'react-native-harness';
 import { Platform } from 'react-native';
-import { MMKV, createMMKV, deleteMMKV, existsMMKV } from 'react-native-mmkv';
+import { NitroModules, type HybridObject } from 'react-native-nitro-modules';
+import {
+  MMKV,
+  type Configuration,
+  createMMKV,
+  deleteMMKV,
+  existsMMKV,
+  getMMKVInstanceCacheStats,
+  getMMKVStats,
+  preloadMMKV,
+  startMMKVTracing,
+  stopMMKVTracing,
+} from 'react-native-mmkv';
 
 const skipOnWeb = (reason: string): boolean => {
   if (Platform.OS === 'web') {
@@ -127,6 +139,57 @@ describe('MMKV Core Functionality', () => {
     });
   });
 
+  describe('Typed Setters', () => {
+    it('should store values with typed setters', () => {
+      storage.setString('stringKey', 'value');
+      storage.setNumber('numberKey', 123.5);
+      storage.setBoolean('booleanKey', true);
+
+      expect(storage.getString('stringKey')).toStrictEqual('value');
+      expect(storage.getNumber('numberKey')).toStrictEqual(123.5);
+      expect(storage.getBoolean('booleanKey')).toStrictEqual(true);
+    });
+
+    it('should throw for empty keys in typed setters', () => {
+      expect(() => storage.setString('', 'value')).toThrow();
+      expect(() => storage.setNumber('', 1)).toThrow();
+      expect(() => storage.setBoolean('', true)).toThrow();
+    });
+
+    it('should throw for missing arguments in typed setters and getters', () => {
+      // @ts-expect-error missing value
+      expect(() => storage.setString('stringKey')).toThrow();
+      // @ts-expect-error missing value
+      expect(() => storage.setNumber('numberKey')).toThrow();
+      // @ts-expect-error missing key
+      expect(() => storage.getBoolean()).toThrow();
+    });
+
+    it('should be faster than the generic set for small values', () => {
+      const iterations = 10000;
+
+      const genericStart = performance.now();
+      for (let i = 0; i < iterations; i++) {
+        storage.set('bench-string', 'value');
+        storage.set('bench-number', i);
+      }
+      const genericTime = performance.now() - genericStart;
+
+      const typedStart = performance.now();
+      for (let i = 0; i < iterations; i++) {
+        storage.setString('bench-string', 'value');
+        storage.setNumber('bench-number', i);
+      }
+      const typedTime = performance.now() - typedStart;
+
+      console.log(
+        `[typed setters] ${iterations}x2 writes: set() ${genericTime.toFixed(2)}ms, ` +
+          `setString()/setNumber() ${typedTime.toFixed(2)}ms`,
+      );
+      expect(storage.getNumber('bench-number')).toStrictEqual(iterations - 1);
+    });
+  });
+
   describe('Key Management', () => {
     it('should handle getAllKeys correctly', () => {
       const keys = ['key1', 'key2', 'key3'];
@@ -334,6 +397,45 @@ describe('MMKV Core Functionality', () => {
   });
 });
 
+describe('MMKV Reading Buffers Into Existing Buffers', () => {
+  let storage: MMKV;
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'buffer-into-test' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should read a buffer into an existing buffer', () => {
+    storage.set('buf', new Uint8Array([1, 2, 3, 4]).buffer);
+
+    const target = new ArrayBuffer(8);
+    const size = storage.getBufferInto('buf', target);
+
+    expect(size).toStrictEqual(4);
+    expect(new Uint8Array(target, 0, 4)).toEqual(new Uint8Array([1, 2, 3, 4]));
+  });
+
+  it('should return the required size without writing if the buffer is too small', () => {
+    storage.set('buf', new Uint8Array([1, 2, 3, 4]).buffer);
+
+    const target = new ArrayBuffer(2);
+    const size = storage.getBufferInto('buf', target);
+
+    expect(size).toStrictEqual(4);
+    expect(new Uint8Array(target)).toEqual(new Uint8Array([0, 0]));
+  });
+
+  it('should return undefined for non-existent keys', () => {
+    expect(
+      storage.getBufferInto('does-not-exist', new ArrayBuffer(8)),
+    ).toBeUndefined();
+  });
+});
+
 describe('MMKV Configuration & Multiple Instances', () => {
   afterEach(() => {
     // Clean up all test instances
@@ -394,6 +496,57 @@ describe('MMKV Configuration & Multiple Instances', () => {
     });
   });
 
+  describe('Lazy Instances', () => {
+    it('should open lazy instances on first use', () => {
+      const storage = createMMKV({ id: 'lazy-test', lazy: true });
+      storage.set('key', 'value');
+      expect(storage.getString('key')).toStrictEqual('value');
+      expect(createMMKV({ id: 'lazy-test' }).getString('key')).toStrictEqual(
+        'value',
+      );
+      storage.clearAll();
+    });
+
+    it('should throw opening errors on first use', () => {
+      const storage = createMMKV({
+        id: 'lazy-invalid-key-test',
+        encryptionKey: 'this-key-is-way-too-long-for-aes-128',
+        lazy: true,
+      });
+      expect(() => storage.getString('key')).toThrow();
+    });
+
+    it('should create lazy instances faster than eager instances', () => {
+      const count = 15;
+      const run = Date.now();
+
+      const eagerIds = Array.from(
+        { length: count },
+        (_, i) => `eager-bench-${run}-${i}`,
+      );
+      const eagerStart = performance.now();
+      eagerIds.forEach((id) => createMMKV({ id }));
+      const eagerTime = performance.now() - eagerStart;
+
+      const lazyIds = Array.from(
+        { length: count },
+        (_, i) => `lazy-bench-${run}-${i}`,
+      );
+      const lazyStart = performance.now();
+      lazyIds.forEach((id) => createMMKV({ id, lazy: true }));
+      const lazyTime = performance.now() - lazyStart;
+
+      console.log(
+        `[lazy] creating ${count} instances: eager ${eagerTime.toFixed(2)}ms, ` +
+          `lazy ${lazyTime.toFixed(2)}ms (saved ${(eagerTime - lazyTime).toFixed(2)}ms on the JS thread)`,
+      );
+
+      // Wait for the background warm-up before deleting the files again
+      lazyIds.forEach((id) => createMMKV({ id }));
+      [...eagerIds, ...lazyIds].forEach((id) => deleteMMKV(id));
+    });
+  });
+
   describe('Instance Management', () => {
     it('should handle multiple instances independently', () => {
       const instances = Array.from({ length: 5 }, (_, i) =>
@@ -769,6 +922,31 @@ describe('MMKV Compare Before Set', () => {
   });
 });
 
+describe('MMKV Sync Policies & Flushing', () => {
+  const policies = ['os', 'periodic', 'every-write', 'every-batch'] as const;
+
+  it('should read back values with every sync policy', () => {
+    for (const syncPolicy of policies) {
+      const storage = createMMKV({ id: `sync-${syncPolicy}-test`, syncPolicy });
+      storage.set('key', syncPolicy);
+      storage.writeBatch([{ key: 'batch', value: 1 }]);
+      expect(storage.getString('key')).toStrictEqual(syncPolicy);
+      expect(storage.getNumber('batch')).toStrictEqual(1);
+      storage.clearAll();
+    }
+  });
+
+  it('should flush without throwing', () => {
+    const storage = createMMKV({ id: 'flush-test' });
+    storage.set('key', 'value');
+    storage.flush();
+    storage.flush('async');
+    storage.flush('sync');
+    expect(storage.getString('key')).toStrictEqual('value');
+    storage.clearAll();
+  });
+});
+
 describe('MMKV Storage Management', () => {
   let storage: MMKV;
 
@@ -929,6 +1107,892 @@ describe('MMKV Storage Management', () => {
   });
 });
 
+describe('MMKV Batched Reads', () => {
+  let storage: MMKV;
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'batched-reads-test' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should read all keys as strings by default', () => {
+    storage.set('a', 'one');
+    storage.set('b', 'two');
+
+    expect(storage.getMany(['a', 'b', 'missing'])).toEqual([
+      'one',
+      'two',
+      undefined,
+    ]);
+  });
+
+  it('should read each key with its given type', () => {
+    storage.set('str', 'hello');
+    storage.set('num', 3.14);
+    storage.set('bool', true);
+    storage.set('buf', new Uint8Array([1, 2, 3]).buffer);
+
+    const [str, num, bool, buf] = storage.getMany(
+      ['str', 'num', 'bool', 'buf'],
+      ['string', 'number', 'boolean', 'buffer'],
+    );
+
+    expect(str).toStrictEqual('hello');
+    expect(num).toStrictEqual(3.14);
+    expect(bool).toStrictEqual(true);
+    expect(new Uint8Array(buf as ArrayBuffer)).toEqual(
+      new Uint8Array([1, 2, 3]),
+    );
+  });
+
+  it('should throw if types and keys have different lengths', () => {
+    expect(() => storage.getMany(['a', 'b'], ['string'])).toThrow();
+  });
+});
+
+describe('MMKV Key Handles', () => {
+  let storage: MMKV;
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'key-handles-test' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should read and write the same value as the instance', () => {
+    const handle = storage.key('handle-key');
+    expect(handle.key).toStrictEqual('handle-key');
+    expect(handle.contains()).toStrictEqual(false);
+    expect(handle.getString()).toBeUndefined();
+
+    handle.setString('hello');
+    expect(storage.getString('handle-key')).toStrictEqual('hello');
+    expect(handle.getString()).toStrictEqual('hello');
+
+    storage.set('handle-key', 42);
+    expect(handle.getNumber()).toStrictEqual(42);
+
+    handle.setBoolean(true);
+    expect(handle.getBoolean()).toStrictEqual(true);
+
+    handle.set(new Uint8Array([1, 2, 3]).buffer);
+    expect(new Uint8Array(handle.getBuffer() as ArrayBuffer)).toEqual(
+      new Uint8Array([1, 2, 3]),
+    );
+
+    expect(handle.remove()).toStrictEqual(true);
+    expect(storage.contains('handle-key')).toStrictEqual(false);
+  });
+
+  it('should notify listeners when writing through a handle', () => {
+    const changedKeys: string[] = [];
+    const listener = storage.addOnKeyChangedListener('handle-key', (key) =>
+      changedKeys.push(key),
+    );
+    storage.key('handle-key').setNumber(1);
+    listener.remove();
+    expect(changedKeys).toEqual(['handle-key']);
+  });
+
+  it('should throw for an empty key', () => {
+    expect(() => storage.key('')).toThrow();
+  });
+
+  it('should be faster than string keys for hot keys', () => {
+    const iterations = 10000;
+    const key = 'playback.position.of.the.currently.playing.episode';
+    const handle = storage.key(key);
+    storage.setNumber(key, 0);
+
+    const stringStart = performance.now();
+    for (let i = 0; i < iterations; i++) {
+      storage.setNumber(key, i);
+      storage.getNumber(key);
+    }
+    const stringTime = performance.now() - stringStart;
+
+    const handleStart = performance.now();
+    for (let i = 0; i < iterations; i++) {
+      handle.setNumber(i);
+      handle.getNumber();
+    }
+    const handleTime = performance.now() - handleStart;
+
+    console.log(
+      `[key handles] set+get: string key ${((stringTime / iterations) * 1000).toFixed(2)}µs, ` +
+        `key handle ${((handleTime / iterations) * 1000).toFixed(2)}µs`,
+    );
+    expect(handle.getNumber()).toStrictEqual(iterations - 1);
+  });
+});
+
+describe('MMKV Expiring Values', () => {
+  let storage: MMKV;
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'expiring-values-test' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  const wait = (ms: number) =>
+    new Promise<void>((resolve) => setTimeout(resolve, ms));
+
+  it('should treat expired values as if they did not exist', async () => {
+    if (skipOnWeb('Expiration is not supported on Web')) return;
+    storage.set('short', 'value', { ttlSeconds: 1 });
+    storage.set('long', 'value', { ttlSeconds: 60 });
+    storage.set('forever', 'value');
+    expect(storage.getString('short')).toStrictEqual('value');
+
+    await wait(2100);
+    expect(storage.getString('short')).toBeUndefined();
+    expect(storage.getString('long')).toStrictEqual('value');
+    expect(storage.getString('forever')).toStrictEqual('value');
+    expect(storage.getAllKeys().sort()).toEqual(['forever', 'long']);
+  });
+
+  it('should remove expired values and notify listeners', async () => {
+    if (skipOnWeb('Expiration is not supported on Web')) return;
+    for (let i = 0; i < 500; i++) {
+      storage.set(`expiring-${i}`, i, { ttlSeconds: 1 });
+    }
+    storage.set('kept', 'value');
+    const changedKeys: string[] = [];
+    const listener = storage.addOnValueChangedListener((key) =>
+      changedKeys.push(key),
+    );
+
+    await wait(2100);
+    const removed = await storage.removeExpiredKeys();
+    listener.remove();
+
+    expect(removed).toStrictEqual(500);
+    expect(changedKeys.length).toStrictEqual(500);
+    expect(storage.getAllKeys()).toEqual(['kept']);
+    expect(await storage.removeExpiredKeys()).toStrictEqual(0);
+  });
+
+  it('should use the default TTL of the instance', async () => {
+    if (skipOnWeb('Expiration is not supported on Web')) return;
+    const cache = createMMKV({
+      id: 'expiring-values-default-test',
+      defaultTTLSeconds: 1,
+    });
+    cache.set('default', 'value');
+    cache.set('never', 'value', { ttlSeconds: 0 });
+
+    await wait(2100);
+    expect(cache.getString('default')).toBeUndefined();
+    expect(cache.getString('never')).toStrictEqual('value');
+    cache.clearAll();
+  });
+
+  it('should throw for a negative TTL', () => {
+    if (skipOnWeb('Expiration is not supported on Web')) return;
+    expect(() => storage.set('key', 'value', { ttlSeconds: -1 })).toThrow();
+  });
+});
+
+describe('MMKV Size-limited Caches', () => {
+  const wait = (ms: number) =>
+    new Promise<void>((resolve) => setTimeout(resolve, ms));
+
+  // Eviction runs in the background, so wait until it settled
+  const waitUntil = async (condition: () => boolean) => {
+    for (let i = 0; i < 50 && !condition(); i++) {
+      await wait(20);
+    }
+  };
+
+  it('should evict the least recently used keys over maxEntries', async () => {
+    if (skipOnWeb('Size limits are not supported on Web')) return;
+    const cache = createMMKV({ id: 'lru-entries-test', maxEntries: 100 });
+    cache.clearAll();
+    for (let i = 0; i < 100; i++) {
+      cache.set(`key-${i}`, i);
+    }
+    // Make the oldest keys the most recently used ones
+    for (let i = 0; i < 10; i++) {
+      expect(cache.getNumber(`key-${i}`)).toStrictEqual(i);
+    }
+    const evictedKeys: string[] = [];
+    const listener = cache.addOnValueChangedListener((key) => {
+      if (!key.startsWith('new-')) evictedKeys.push(key);
+    });
+
+    cache.set('new-key', 'value');
+    await waitUntil(() => cache.length <= 90);
+    listener.remove();
+
+    expect(cache.length).toStrictEqual(90);
+    expect(evictedKeys.length).toStrictEqual(11);
+    expect(cache.getString('new-key')).toStrictEqual('value');
+    for (let i = 0; i < 10; i++) {
+      expect(cache.contains(`key-${i}`)).toBe(true);
+    }
+    expect(cache.contains('key-10')).toBe(false);
+    cache.clearAll();
+  });
+
+  it('should keep the file below maxBytes', async () => {
+    if (skipOnWeb('Size limits are not supported on Web')) return;
+    const maxBytes = 256 * 1024;
+    const cache = createMMKV({ id: 'lru-bytes-test', maxBytes });
+    cache.clearAll();
+    const value = 'x'.repeat(1024);
+    for (let i = 0; i < 1000; i++) {
+      cache.set(`key-${i}`, value);
+    }
+    await waitUntil(() => cache.byteSize <= maxBytes);
+
+    expect(cache.byteSize).toBeLessThanOrEqual(maxBytes);
+    expect(cache.length).toBeGreaterThan(0);
+    // The most recently written key is never evicted first
+    expect(cache.getString('key-999')).toStrictEqual(value);
+    expect(cache.contains('key-0')).toBe(false);
+    cache.clearAll();
+  });
+
+  it('should only evict what is needed for a maxBytes below one page', async () => {
+    if (skipOnWeb('Size limits are not supported on Web')) return;
+    const maxBytes = 1024;
+    const cache = createMMKV({ id: 'lru-small-bytes-test', maxBytes });
+    cache.clearAll();
+    const value = 'x'.repeat(100);
+    for (let i = 0; i < 20; i++) {
+      cache.set(`key-${i}`, value);
+    }
+    await waitUntil(() => cache.length < 20);
+    // Give further (wrong) evictions the time to run
+    await wait(200);
+
+    // Only the values count - the file itself does not shrink below one page
+    expect(cache.length).toBeGreaterThanOrEqual(5);
+    expect(cache.length).toBeLessThan(10);
+    expect(cache.getString('key-19')).toStrictEqual(value);
+    cache.clearAll();
+  });
+
+  it('should throw for invalid limits', () => {
+    if (skipOnWeb('Size limits are not supported on Web')) return;
+    expect(() =>
+      createMMKV({ id: 'lru-invalid-test', maxEntries: 0 }),
+    ).toThrow();
+    expect(() =>
+      createMMKV({ id: 'lru-invalid-test', maxBytes: 1.5 }),
+    ).toThrow();
+  });
+});
+
+describe('MMKV Compression', () => {
+  let storage: MMKV;
+
+  // A JSON array of objects, similar to what apps typically cache
+  const createJSON = (minLength: number) => {
+    const items: object[] = [];
+    let length = 0;
+    for (let i = 0; length < minLength; i++) {
+      const item = {
+        id: i,
+        name: `User ${i % 1000}`,
+        email: `user${i}@example.com`,
+        isActive: i % 2 === 0,
+        score: (i * 37) % 1000,
+      };
+      items.push(item);
+      length += JSON.stringify(item).length + 1;
+    }
+    return JSON.stringify(items);
+  };
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'compression-test', compression: 'lz4' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should transparently compress large strings and buffers', () => {
+    const json = createJSON(100 * 1024);
+    storage.set('json', json);
+    expect(storage.getString('json')).toStrictEqual(json);
+
+    const bytes = new Uint8Array(64 * 1024).map((_, i) => i % 16);
+    storage.set('buffer', bytes.buffer);
+    const result = storage.getBuffer('buffer');
+    expect(result).toBeDefined();
+    expect(new Uint8Array(result!)).toEqual(bytes);
+
+    const [manyString, manyBuffer] = storage.getMany(
+      ['json', 'buffer'],
+      ['string', 'buffer'],
+    );
+    expect(manyString).toStrictEqual(json);
+    expect(new Uint8Array(manyBuffer as ArrayBuffer)).toEqual(bytes);
+  });
+
+  it('should read compressed values into a buffer', () => {
+    if (skipOnWeb('Compression is not supported on Web')) return;
+    const bytes = new Uint8Array(64 * 1024).map((_, i) => i % 16);
+    storage.set('buffer', bytes.buffer);
+
+    let buffer = new ArrayBuffer(16);
+    let size = storage.getBufferInto('buffer', buffer);
+    expect(size).toStrictEqual(bytes.byteLength);
+    buffer = new ArrayBuffer(size!);
+    size = storage.getBufferInto('buffer', buffer);
+    expect(size).toStrictEqual(bytes.byteLength);
+    expect(new Uint8Array(buffer)).toEqual(bytes);
+  });
+
+  it('should read values written without compression and vice versa', () => {
+    if (skipOnWeb('Compression is not supported on Web')) return;
+    const json = createJSON(100 * 1024);
+    const plain = createMMKV({ id: 'compression-mixed-test' });
+    plain.clearAll();
+    plain.set('plain', json);
+
+    const compressed = createMMKV({
+      id: 'compression-mixed-test',
+      compression: 'lz4',
+    });
+    compressed.set('compressed', json);
+    expect(compressed.getString('plain')).toStrictEqual(json);
+    expect(plain.getString('compressed')).toStrictEqual(json);
+    plain.clearAll();
+  });
+
+  it('should decompress values imported into an instance without compression', () => {
+    if (skipOnWeb('Compression is not supported on Web')) return;
+    const json = createJSON(100 * 1024);
+    const bytes = new Uint8Array(64 * 1024).map((_, i) => i % 16);
+    storage.set('json', json);
+    storage.set('buffer', bytes.buffer);
+    storage.set('number', 42);
+
+    const plain = createMMKV({ id: 'compression-import-plain-test' });
+    plain.clearAll();
+    expect(plain.importAllFrom(storage)).toBe(3);
+    expect(plain.getString('json')).toStrictEqual(json);
+    expect(new Uint8Array(plain.getBuffer('buffer')!)).toEqual(bytes);
+    expect(plain.getNumber('number')).toStrictEqual(42);
+
+    // And compressed again when importing them back
+    storage.clearAll();
+    expect(storage.importAllFrom(plain)).toBe(3);
+    expect(storage.getString('json')).toStrictEqual(json);
+    expect(storage.byteSize).toBeLessThan(plain.byteSize);
+    plain.clearAll();
+  });
+
+  it('should make the file smaller', () => {
+    if (skipOnWeb('Compression is not supported on Web')) return;
+    const json = createJSON(1024 * 1024);
+    const plain = createMMKV({ id: 'compression-size-plain-test' });
+    plain.clearAll();
+    plain.set('json', json);
+    storage.set('json', json);
+    plain.trim();
+    storage.trim();
+
+    console.log(
+      `[compression] 1 MB JSON: file ${plain.byteSize} bytes uncompressed, ` +
+        `${storage.byteSize} bytes with lz4`,
+    );
+    expect(storage.byteSize).toBeLessThan(plain.byteSize / 2);
+    plain.clearAll();
+  });
+
+  it('should benchmark writes and reads against uncompressed values', () => {
+    if (skipOnWeb('Compression is not supported on Web')) return;
+    const json = createJSON(512 * 1024);
+    const plain = createMMKV({ id: 'compression-bench-plain-test' });
+    plain.clearAll();
+    const iterations = 20;
+
+    const measure = (fn: () => void) => {
+      const start = performance.now();
+      for (let i = 0; i < iterations; i++) fn();
+      return (performance.now() - start) / iterations;
+    };
+    const plainWrite = measure(() => plain.set('json', json));
+    const compressedWrite = measure(() => storage.set('json', json));
+    const plainRead = measure(() => plain.getString('json'));
+    const compressedRead = measure(() => storage.getString('json'));
+
+    console.log(
+      `[compression] 512 KB JSON: write ${plainWrite.toFixed(2)}ms -> ${compressedWrite.toFixed(2)}ms, ` +
+        `read ${plainRead.toFixed(2)}ms -> ${compressedRead.toFixed(2)}ms`,
+    );
+    expect(storage.getString('json')).toStrictEqual(json);
+    plain.clearAll();
+  });
+});
+
+describe('MMKV Large Values', () => {
+  let storage: MMKV;
+  const createBytes = (size: number, seed: number) =>
+    new Uint8Array(size).map((_, i) => (i * 31 + seed) % 251);
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'blobs-test', blobThresholdBytes: 64 * 1024 });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should transparently store large values in blobs', () => {
+    const bytes = createBytes(2 * 1024 * 1024, 1);
+    storage.set('buffer', bytes.buffer);
+    const result = storage.getBuffer('buffer');
+    expect(result).toBeDefined();
+    expect(new Uint8Array(result!)).toEqual(bytes);
+
+    const text = 'x'.repeat(200 * 1024);
+    storage.set('string', text);
+    expect(storage.getString('string')).toStrictEqual(text);
+    storage.set('small', 'hello');
+    expect(storage.getString('small')).toStrictEqual('hello');
+
+    const [manyString, manyBuffer] = storage.getMany(
+      ['string', 'buffer'],
+      ['string', 'buffer'],
+    );
+    expect(manyString).toStrictEqual(text);
+    expect(new Uint8Array(manyBuffer as ArrayBuffer)).toEqual(bytes);
+  });
+
+  it('should read blobs into a buffer', () => {
+    if (skipOnWeb('Blobs are not supported on Web')) return;
+    const bytes = createBytes(256 * 1024, 2);
+    storage.set('buffer', bytes.buffer);
+
+    let buffer = new ArrayBuffer(16);
+    let size = storage.getBufferInto('buffer', buffer);
+    expect(size).toStrictEqual(bytes.byteLength);
+    buffer = new ArrayBuffer(size!);
+    size = storage.getBufferInto('buffer', buffer);
+    expect(size).toStrictEqual(bytes.byteLength);
+    expect(new Uint8Array(buffer)).toEqual(bytes);
+  });
+
+  it('should keep the file small when updating large values', () => {
+    if (skipOnWeb('Blobs are not supported on Web')) return;
+    for (let i = 0; i < 10; i++) {
+      storage.set('draft', createBytes(1024 * 1024, i).buffer);
+    }
+    expect(storage.byteSize).toBeLessThan(64 * 1024);
+    expect(new Uint8Array(storage.getBuffer('draft')!)).toEqual(
+      createBytes(1024 * 1024, 9),
+    );
+    // The referenced blob must survive garbage collection
+    storage.trim();
+    expect(new Uint8Array(storage.getBuffer('draft')!)).toEqual(
+      createBytes(1024 * 1024, 9),
+    );
+  });
+
+  it('should copy blobs into the importing instance', () => {
+    if (skipOnWeb('Blobs are not supported on Web')) return;
+    const bytes = createBytes(256 * 1024, 3);
+    const source = createMMKV({
+      id: 'blobs-import-source-test',
+      blobThresholdBytes: 64 * 1024,
+    });
+    source.clearAll();
+    source.set('buffer', bytes.buffer);
+
+    const plain = createMMKV({ id: 'blobs-import-plain-test' });
+    plain.clearAll();
+    expect(plain.importAllFrom(source)).toBe(1);
+    expect(storage.importAllFrom(source)).toBe(1);
+
+    // Neither may still point to a blob of the source
+    deleteMMKV('blobs-import-source-test');
+    expect(new Uint8Array(plain.getBuffer('buffer')!)).toEqual(bytes);
+    expect(new Uint8Array(storage.getBuffer('buffer')!)).toEqual(bytes);
+    expect(storage.byteSize).toBeLessThan(plain.byteSize);
+    plain.clearAll();
+  });
+
+  it('should not allow blobs with encryption', () => {
+    if (skipOnWeb('Blobs are not supported on Web')) return;
+    expect(() =>
+      createMMKV({
+        id: 'blobs-encrypted-test',
+        blobThresholdBytes: 1024,
+        encryptionKey: 'secret',
+      }),
+    ).toThrow();
+    expect(() => storage.encrypt('secret')).toThrow();
+  });
+
+  it('should benchmark updates against values in the MMKV file', () => {
+    if (skipOnWeb('Blobs are not supported on Web')) return;
+    const plain = createMMKV({ id: 'blobs-bench-plain-test' });
+    plain.clearAll();
+    const iterations = 10;
+    const drafts = [0, 1, 2, 3].map((seed) =>
+      createBytes(5 * 1024 * 1024, seed),
+    );
+
+    const measure = (target: MMKV) => {
+      const start = performance.now();
+      for (let i = 0; i < iterations; i++) {
+        target.set('draft', drafts[i % drafts.length]!.buffer);
+      }
+      return (performance.now() - start) / iterations;
+    };
+    const plainWrite = measure(plain);
+    const blobWrite = measure(storage);
+
+    console.log(
+      `[blobs] 5 MB update: ${plainWrite.toFixed(2)}ms (file ${plain.byteSize} bytes) -> ` +
+        `${blobWrite.toFixed(2)}ms (file ${storage.byteSize} bytes)`,
+    );
+    expect(storage.byteSize).toBeLessThan(plain.byteSize);
+    plain.clearAll();
+  });
+});
+
+describe('MMKV Automatic Compaction', () => {
+  const wait = (ms: number) =>
+    new Promise<void>((resolve) => setTimeout(resolve, ms));
+  const value = 'x'.repeat(64 * 1024);
+
+  // Leaves ~5% of the written data live
+  const fragment = (storage: MMKV) => {
+    for (let i = 0; i < 60; i++) {
+      storage.set(`key-${i}`, value);
+    }
+    for (let i = 3; i < 60; i++) {
+      storage.remove(`key-${i}`);
+    }
+  };
+
+  it('should count compactions caused by trim()', () => {
+    if (skipOnWeb('Compaction is not supported on Web')) return;
+    const storage = createMMKV({ id: 'compaction-trim-test' });
+    storage.clearAll();
+    const before = storage.getCompactionStats();
+    fragment(storage);
+    storage.trim();
+
+    const after = storage.getCompactionStats();
+    expect(after.count).toBeGreaterThan(before.count);
+    expect(after.bytesReclaimed).toBeGreaterThan(before.bytesReclaimed);
+    expect(after.maxDurationMs).toBeGreaterThanOrEqual(after.lastDurationMs);
+    expect(storage.getString('key-0')).toStrictEqual(value);
+    storage.clearAll();
+  });
+
+  it('should compact fragmented files once idle', async () => {
+    if (skipOnWeb('Compaction is not supported on Web')) return;
+    const storage = createMMKV({
+      id: 'compaction-auto-test',
+      autoCompactionThreshold: 0.5,
+    });
+    storage.clearAll();
+    const before = storage.getCompactionStats();
+    fragment(storage);
+    const fragmentedSize = storage.byteSize;
+
+    // Compaction waits for two seconds without writes
+    for (let i = 0; i < 50; i++) {
+      if (storage.getCompactionStats().count > before.count) break;
+      await wait(100);
+    }
+    const after = storage.getCompactionStats();
+    console.log(
+      `[compaction] ${fragmentedSize} -> ${storage.byteSize} bytes ` +
+        `in ${after.lastDurationMs.toFixed(2)}ms`,
+    );
+    expect(after.count).toBeGreaterThan(before.count);
+    expect(storage.byteSize).toBeLessThan(fragmentedSize);
+    for (let i = 0; i < 3; i++) {
+      expect(storage.getString(`key-${i}`)).toStrictEqual(value);
+    }
+    storage.clearAll();
+  });
+
+  it('should not allow invalid thresholds', () => {
+    if (skipOnWeb('Compaction is not supported on Web')) return;
+    expect(() =>
+      createMMKV({ id: 'compaction-invalid-test', autoCompactionThreshold: 1 }),
+    ).toThrow();
+  });
+});
+
+describe('MMKV Integers & Atomic Counters', () => {
+  let storage: MMKV;
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'integers-test' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should store 32-bit integers', () => {
+    storage.setInt('int', 2147483647);
+    expect(storage.getInt('int')).toStrictEqual(2147483647);
+    storage.setInt('int', -5);
+    expect(storage.getInt('int')).toStrictEqual(-5);
+    expect(storage.getInt('missing')).toBeUndefined();
+  });
+
+  it('should throw for non-integers or values outside of the 32-bit range', () => {
+    expect(() => storage.setInt('int', 1.5)).toThrow();
+    expect(() => storage.setInt('int', 2147483648)).toThrow();
+  });
+
+  it('should store 64-bit integers as BigInt', () => {
+    const value = BigInt('9007199254740993');
+    storage.setInt64('int64', value);
+    expect(storage.getInt64('int64')).toStrictEqual(value);
+    expect(storage.getInt64('missing')).toBeUndefined();
+  });
+
+  it('should increment counters', () => {
+    expect(storage.increment('counter')).toStrictEqual(1);
+    expect(storage.increment('counter', 10)).toStrictEqual(11);
+    expect(storage.increment('counter', -2)).toStrictEqual(9);
+    expect(storage.getInt64('counter')).toStrictEqual(BigInt(9));
+    expect(() => storage.increment('counter', 0.5)).toThrow();
+  });
+
+  it('should throw instead of overflowing counters', () => {
+    storage.setInt64('big', BigInt('9223372036854775807'));
+    expect(() => storage.increment('big')).toThrow();
+    expect(storage.getInt64('big')).toStrictEqual(BigInt('9223372036854775807'));
+
+    storage.setInt64('big', BigInt(Number.MAX_SAFE_INTEGER - 1));
+    expect(storage.increment('big')).toStrictEqual(Number.MAX_SAFE_INTEGER);
+    expect(() => storage.increment('big')).toThrow();
+    expect(storage.getInt64('big')).toStrictEqual(
+      BigInt(Number.MAX_SAFE_INTEGER),
+    );
+  });
+
+  it('should only set the value if it matches the expected value', () => {
+    expect(storage.compareAndSet('cas', 0, 1)).toStrictEqual(false);
+    storage.setInt64('cas', BigInt(5));
+    expect(storage.compareAndSet('cas', 4, 6)).toStrictEqual(false);
+    expect(storage.compareAndSet('cas', 5, 6)).toStrictEqual(true);
+    expect(storage.getInt64('cas')).toStrictEqual(BigInt(6));
+  });
+
+  it('should notify listeners on increment', () => {
+    const changedKeys: string[] = [];
+    const listener = storage.addOnKeyChangedListener('counter', (key) =>
+      changedKeys.push(key),
+    );
+    storage.increment('counter');
+    listener.remove();
+    expect(changedKeys).toEqual(['counter']);
+  });
+
+  it('should benchmark increment against a JS read-add-write', () => {
+    const iterations = 10000;
+
+    const jsStart = performance.now();
+    for (let i = 0; i < iterations; i++) {
+      const current = storage.getNumber('js-counter') ?? 0;
+      storage.setNumber('js-counter', current + 1);
+    }
+    const jsTime = performance.now() - jsStart;
+
+    const nativeStart = performance.now();
+    for (let i = 0; i < iterations; i++) {
+      storage.increment('native-counter');
+    }
+    const nativeTime = performance.now() - nativeStart;
+
+    console.log(
+      `[increment] JS read-add-write ${((jsTime / iterations) * 1000).toFixed(2)}µs, ` +
+        `native increment ${((nativeTime / iterations) * 1000).toFixed(2)}µs`,
+    );
+    expect(storage.getInt64('native-counter')).toStrictEqual(
+      BigInt(iterations),
+    );
+  });
+});
+
+describe('MMKV Write Batches', () => {
+  let storage: MMKV;
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'write-batch-test' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should write all entries and apply removals', () => {
+    storage.set('to-remove', 'value');
+
+    storage.writeBatch(
+      [
+        { key: 'str', value: 'hello' },
+        { key: 'num', value: 42 },
+        { key: 'bool', value: false },
+      ],
+      ['to-remove'],
+    );
+
+    expect(storage.getString('str')).toStrictEqual('hello');
+    expect(storage.getNumber('num')).toStrictEqual(42);
+    expect(storage.getBoolean('bool')).toStrictEqual(false);
+    expect(storage.contains('to-remove')).toBe(false);
+  });
+
+  it('should not write anything if an entry has an empty key', () => {
+    expect(() =>
+      storage.writeBatch([
+        { key: 'valid', value: 'value' },
+        { key: '', value: 'value' },
+      ]),
+    ).toThrow();
+    expect(storage.contains('valid')).toBe(false);
+  });
+
+  it('should notify listeners once per changed key', async () => {
+    storage.set('to-remove', 'value');
+    const changedKeys: string[] = [];
+    const listener = storage.addOnValueChangedListener((key) => {
+      changedKeys.push(key);
+    });
+
+    storage.writeBatch(
+      [
+        { key: 'a', value: 1 },
+        { key: 'b', value: 2 },
+      ],
+      ['to-remove', 'does-not-exist'],
+    );
+    await waitForNextTick();
+
+    expect(changedKeys).toEqual(['a', 'b', 'to-remove']);
+    listener.remove();
+  });
+
+  it('should notify batch listeners once with all changed keys', async () => {
+    const calls: string[][] = [];
+    const listener = storage.addOnValuesChangedListener((keys) => {
+      calls.push(keys);
+    }, 0);
+
+    storage.writeBatch([
+      { key: 'a', value: 1 },
+      { key: 'b', value: 2 },
+      { key: 'c', value: 3 },
+    ]);
+    await waitForNextTick();
+
+    expect(calls).toEqual([['a', 'b', 'c']]);
+    listener.remove();
+  });
+});
+
+describe('MMKV Async Operations', () => {
+  let storage: MMKV;
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'async-test' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should set and get strings asynchronously', async () => {
+    await storage.setAsync('string', 'hello');
+    expect(storage.getString('string')).toStrictEqual('hello');
+    expect(await storage.getStringAsync('string')).toStrictEqual('hello');
+    expect(await storage.getStringAsync('does-not-exist')).toBeUndefined();
+  });
+
+  it('should set and get buffers asynchronously', async () => {
+    const buffer = new Uint8Array([1, 2, 3, 4]);
+    const promise = storage.setAsync('buffer', buffer.buffer);
+    // The buffer is copied before setAsync returns, so this must not be written
+    buffer[0] = 42;
+    await promise;
+
+    const result = await storage.getBufferAsync('buffer');
+    expect(result).toBeDefined();
+    expect(Array.from(new Uint8Array(result!))).toEqual([1, 2, 3, 4]);
+  });
+
+  it('should reject for empty keys', async () => {
+    let error: unknown;
+    try {
+      await storage.setAsync('', 'value');
+    } catch (e) {
+      error = e;
+    }
+    expect(error).toBeDefined();
+  });
+
+  it('should import and trim asynchronously', async () => {
+    const other = createMMKV({ id: 'async-import-test' });
+    other.clearAll();
+    other.set('a', 1);
+    other.set('b', 'two');
+
+    expect(await storage.importAllFromAsync(other)).toBe(2);
+    expect(storage.getNumber('a')).toBe(1);
+    expect(storage.getString('b')).toBe('two');
+
+    await storage.trimAsync();
+    expect(storage.getString('b')).toBe('two');
+    other.clearAll();
+  });
+
+  it('should stall the JS thread less with async writes', async () => {
+    for (const megabytes of [1, 8, 32]) {
+      const buffer = new ArrayBuffer(megabytes * 1024 * 1024);
+
+      storage.clearAll();
+      const syncStart = performance.now();
+      storage.set('large', buffer);
+      const syncStall = performance.now() - syncStart;
+
+      storage.clearAll();
+      const asyncStart = performance.now();
+      const promise = storage.setAsync('large', buffer);
+      const asyncStall = performance.now() - asyncStart;
+      await promise;
+      const asyncTotal = performance.now() - asyncStart;
+
+      console.log(
+        `[async] ${megabytes}MB set: sync stalls JS for ${syncStall.toFixed(2)}ms, ` +
+          `async stalls JS for ${asyncStall.toFixed(2)}ms (${asyncTotal.toFixed(2)}ms until resolved)`,
+      );
+    }
+  });
+});
+
 describe('MMKV Multi-Process Mode', () => {
   afterEach(() => {
     try {
@@ -1128,6 +2192,91 @@ describe('MMKV Listeners & Observers', () => {
       expect(changedKeys).not.toContain('after-removal');
     });
 
+    it('should only trigger key listeners for their key', async () => {
+      const changedKeys: string[] = [];
+
+      const listener = storage.addOnKeyChangedListener('watched', (key) => {
+        changedKeys.push(key);
+      });
+
+      storage.set('watched', 'value');
+      storage.set('not-watched', 'value');
+      storage.remove('watched');
+
+      // Wait for the listeners to trigger
+      await waitForNextTick();
+
+      expect(changedKeys).toEqual(['watched', 'watched']);
+
+      listener.remove();
+      storage.set('watched', 'again');
+      await waitForNextTick();
+      expect(changedKeys.length).toStrictEqual(2);
+    });
+
+    it('should only trigger prefix listeners for keys with their prefix', async () => {
+      const changedKeys: string[] = [];
+
+      const listener = storage.addOnKeyPrefixChangedListener(
+        'user.',
+        (key) => {
+          changedKeys.push(key);
+        },
+      );
+
+      storage.set('user.name', 'Marc');
+      storage.set('user.age', 21);
+      storage.set('settings.theme', 'dark');
+
+      // Wait for the listeners to trigger
+      await waitForNextTick();
+
+      expect(changedKeys).toEqual(['user.name', 'user.age']);
+
+      listener.remove();
+    });
+
+    it('should coalesce a burst of changes into a single batched call', async () => {
+      const calls: string[][] = [];
+
+      const listener = storage.addOnValuesChangedListener((keys) => {
+        calls.push(keys);
+      });
+
+      for (let i = 0; i < 1000; i++) {
+        storage.set(`key-${i % 10}`, i);
+      }
+      storage.remove('key-0');
+
+      // Nothing is delivered synchronously
+      expect(calls.length).toBe(0);
+
+      // Wait for the flush interval to pass
+      await new Promise((resolve) => setTimeout(resolve, 200));
+
+      expect(calls.length).toBe(1);
+      expect(calls[0]).toEqual(
+        Array.from({ length: 10 }, (_, i) => `key-${i}`),
+      );
+
+      listener.remove();
+    });
+
+    it('should drop pending batched changes after removal', async () => {
+      const calls: string[][] = [];
+
+      const listener = storage.addOnValuesChangedListener((keys) => {
+        calls.push(keys);
+      }, 50);
+
+      storage.set('key', 'value');
+      listener.remove();
+
+      await new Promise((resolve) => setTimeout(resolve, 200));
+
+      expect(calls.length).toBe(0);
+    });
+
     it('should handle listener removal multiple times safely', () => {
       const listener = storage.addOnValueChangedListener(() => {});
 
@@ -1163,6 +2312,275 @@ describe('MMKV Listeners & Observers', () => {
   });
 });
 
+describe('Preloading instances', () => {
+  it('should preload instances so they can be used right away', async () => {
+    const ids = ['preload-test-1', 'preload-test-2', 'preload-test-3'];
+    await preloadMMKV(ids.map((id) => ({ id })));
+
+    for (const id of ids) {
+      const storage = createMMKV({ id });
+      storage.set('key', id);
+      expect(storage.getString('key')).toStrictEqual(id);
+      deleteMMKV(id);
+    }
+  });
+
+  it('should reject if an instance cannot be opened', async () => {
+    let error: unknown;
+    try {
+      await preloadMMKV([{ id: '' }]);
+    } catch (e) {
+      error = e;
+    }
+    expect(error).toBeDefined();
+  });
+
+  it('should open many instances faster in parallel than serially', async () => {
+    const count = 20;
+    const run = Date.now();
+
+    const serialIds = Array.from(
+      { length: count },
+      (_, i) => `serial-open-bench-${run}-${i}`,
+    );
+    const serialStart = performance.now();
+    serialIds.forEach((id) => createMMKV({ id }));
+    const serialTime = performance.now() - serialStart;
+
+    const parallelIds = Array.from(
+      { length: count },
+      (_, i) => `parallel-open-bench-${run}-${i}`,
+    );
+    const parallelStart = performance.now();
+    const promise = preloadMMKV(parallelIds.map((id) => ({ id })));
+    const parallelStall = performance.now() - parallelStart;
+    await promise;
+    parallelIds.forEach((id) => createMMKV({ id }));
+    const parallelTime = performance.now() - parallelStart;
+
+    console.log(
+      `[preload] opening ${count} instances: serial ${serialTime.toFixed(2)}ms on the JS thread, ` +
+        `parallel ${parallelTime.toFixed(2)}ms total (${parallelStall.toFixed(2)}ms on the JS thread)`,
+    );
+
+    [...serialIds, ...parallelIds].forEach((id) => deleteMMKV(id));
+  });
+});
+
+describe('Instance cache', () => {
+  it('should return the same instance for the same configuration', () => {
+    if (skipOnWeb('Instances are not cached on Web')) return;
+    const before = getMMKVInstanceCacheStats();
+    const first = createMMKV({ id: 'instance-cache-test' });
+    const second = createMMKV({ id: 'instance-cache-test' });
+    const after = getMMKVInstanceCacheStats();
+
+    expect(first.equals(second)).toStrictEqual(true);
+    expect(after.hits - before.hits).toStrictEqual(1);
+    expect(after.misses - before.misses).toBeLessThanOrEqual(1);
+    expect(after.size).toBeGreaterThanOrEqual(1);
+    first.clearAll();
+  });
+
+  it('should not share instances with different encryption settings', () => {
+    if (skipOnWeb('Instances are not cached on Web')) return;
+    const plain = createMMKV({ id: 'instance-cache-plain-test' });
+    const encrypted = createMMKV({
+      id: 'instance-cache-encrypted-test',
+      encryptionKey: 'cache-key',
+    });
+    const encryptedAgain = createMMKV({
+      id: 'instance-cache-encrypted-test',
+      encryptionKey: 'cache-key',
+    });
+
+    expect(plain.equals(encrypted)).toStrictEqual(false);
+    expect(encrypted.equals(encryptedAgain)).toStrictEqual(true);
+    plain.clearAll();
+    encrypted.clearAll();
+  });
+
+  it('should create a new instance if the options do not match', () => {
+    if (skipOnWeb('Instances are not cached on Web')) return;
+    const before = getMMKVInstanceCacheStats();
+    const first = createMMKV({ id: 'instance-cache-mismatch-test' });
+    const second = createMMKV({
+      id: 'instance-cache-mismatch-test',
+      compareBeforeSet: true,
+    });
+    const after = getMMKVInstanceCacheStats();
+
+    expect(first.equals(second)).toStrictEqual(false);
+    expect(after.misses - before.misses).toStrictEqual(2);
+    // Both still point to the same underlying storage
+    first.set('key', 'value');
+    expect(second.getString('key')).toStrictEqual('value');
+    first.clearAll();
+  });
+
+  it('should share instances with the factories of other JS runtimes', () => {
+    if (skipOnWeb('Instances are not cached on Web')) return;
+    // Every JS runtime (e.g. a worklet runtime) creates its own factory
+    const otherFactory = NitroModules.createHybridObject<
+      HybridObject & { createMMKV(configuration: Configuration): MMKV }
+    >('MMKVFactory');
+    const first = createMMKV({ id: 'instance-cache-runtimes-test' });
+    const second = otherFactory.createMMKV({
+      id: 'instance-cache-runtimes-test',
+    });
+
+    expect(first.equals(second)).toStrictEqual(true);
+    first.clearAll();
+  });
+
+  it('should benchmark cached createMMKV(...) calls', () => {
+    const iterations = 1000;
+    createMMKV({ id: 'instance-cache-bench' });
+
+    const start = performance.now();
+    for (let i = 0; i < iterations; i++) {
+      createMMKV({ id: 'instance-cache-bench' });
+    }
+    const time = performance.now() - start;
+    console.log(
+      `[instance cache] createMMKV(...): ${((time / iterations) * 1000).toFixed(2)}µs/call`,
+    );
+  });
+});
+
+describe('Stats', () => {
+  let storage: MMKV;
+
+  beforeEach(() => {
+    storage = createMMKV({ id: 'stats-test' });
+    storage.clearAll();
+  });
+
+  afterEach(() => {
+    storage.clearAll();
+  });
+
+  it('should count reads, writes and removals', () => {
+    if (skipOnWeb('Stats are not collected on Web')) return;
+    const before = storage.getStats();
+    if (!before.isEnabled) {
+      console.log('[stats] Stats are disabled in this build');
+      return;
+    }
+    storage.set('string', 'value');
+    storage.set('number', 42);
+    storage.getString('string');
+    storage.getNumber('number');
+    storage.getBoolean('missing');
+    storage.remove('string');
+    const after = storage.getStats();
+
+    expect(after.set.count - before.set.count).toStrictEqual(2);
+    expect(after.get.count - before.get.count).toStrictEqual(3);
+    expect(after.remove.count - before.remove.count).toStrictEqual(1);
+    expect(
+      after.get.histogram.reduce((sum, count) => sum + count, 0),
+    ).toStrictEqual(after.get.count);
+    expect(after.get.p99Microseconds).toBeGreaterThanOrEqual(
+      after.get.p50Microseconds,
+    );
+    expect(after.bytesWritten).toBeGreaterThan(before.bytesWritten);
+  });
+
+  it('should count listeners and their notifications', () => {
+    if (skipOnWeb('Stats are not collected on Web')) return;
+    const before = storage.getStats();
+    const listener = storage.addOnValueChangedListener(() => {});
+    const keyListener = storage.addOnKeyChangedListener('key', () => {});
+    expect(storage.getStats().listenerCount).toStrictEqual(
+      before.listenerCount + 2,
+    );
+
+    storage.set('key', 'value');
+    if (before.isEnabled) {
+      expect(storage.getStats().notify.count).toStrictEqual(
+        before.notify.count + 1,
+      );
+    }
+    listener.remove();
+    keyListener.remove();
+    expect(storage.getStats().listenerCount).toStrictEqual(
+      before.listenerCount,
+    );
+  });
+
+  it('should report the live and file size', () => {
+    if (skipOnWeb('Stats are not collected on Web')) return;
+    storage.set('key', 'x'.repeat(1000));
+    const stats = storage.getStats();
+    expect(stats.liveBytes).toBeGreaterThan(1000);
+    expect(stats.fileBytes).toBeGreaterThanOrEqual(stats.liveBytes);
+  });
+
+  it('should sum up the stats of all instances', () => {
+    if (skipOnWeb('Stats are not collected on Web')) return;
+    const other = createMMKV({ id: 'stats-other-test' });
+    storage.set('key', 'value');
+    other.set('key', 'value');
+    const total = getMMKVStats();
+
+    expect(total.set.count).toBeGreaterThanOrEqual(
+      storage.getStats().set.count + other.getStats().set.count,
+    );
+    expect(total.fileBytes).toBeGreaterThanOrEqual(
+      storage.getStats().fileBytes + other.getStats().fileBytes,
+    );
+    other.clearAll();
+  });
+});
+
+describe('Tracing', () => {
+  afterEach(() => {
+    stopMMKVTracing();
+  });
+
+  it('should trace to a file in the root directory by default', () => {
+    if (skipOnWeb('Tracing is not supported on Web')) return;
+    const path = startMMKVTracing();
+    expect(path.endsWith('mmkv-trace.json')).toStrictEqual(true);
+
+    const storage = createMMKV({ id: 'tracing-test' });
+    storage.set('key', 'value');
+    expect(storage.getString('key')).toStrictEqual('value');
+    storage.clearAll();
+  });
+
+  it('should throw for a path that cannot be written', () => {
+    if (skipOnWeb('Tracing is not supported on Web')) return;
+    expect(() =>
+      startMMKVTracing('/this/directory/does/not/exist/trace.json'),
+    ).toThrow();
+  });
+
+  it('should benchmark reads while tracing', () => {
+    if (skipOnWeb('Tracing is not supported on Web')) return;
+    const storage = createMMKV({ id: 'tracing-bench' });
+    storage.set('key', 'value');
+    const iterations = 10000;
+
+    const measure = () => {
+      const start = performance.now();
+      for (let i = 0; i < iterations; i++) {
+        storage.getString('key');
+      }
+      return ((performance.now() - start) / iterations) * 1000;
+    };
+    const untraced = measure();
+    startMMKVTracing();
+    const traced = measure();
+    stopMMKVTracing();
+    console.log(
+      `[tracing] getString(...): ${untraced.toFixed(2)}µs untraced, ${traced.toFixed(2)}µs traced`,
+    );
+    storage.clearAll();
+  });
+});
+
 describe('Deleting instances and checking if they exist', () => {
   beforeEach(() => {
     deleteMMKV('some-instance');
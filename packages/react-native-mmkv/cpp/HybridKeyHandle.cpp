@@ -0,0 +1,84 @@
+//
+//  HybridKeyHandle.cpp
+//  react-native-mmkv
+//
+
+#include "HybridKeyHandle.hpp"
+#include "HybridMMKV.hpp"
+
+namespace margelo::nitro::mmkv {
+
+HybridKeyHandle::HybridKeyHandle(const std::shared_ptr<HybridMMKV>& mmkv, const std::string& key)
+    : HybridObject(TAG), mmkv(mmkv), key(key) {}
+
+std::string HybridKeyHandle::getKey() {
+  return key;
+}
+
+void HybridKeyHandle::set(const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) {
+  mmkv->set(key, value, std::nullopt);
+}
+
+void HybridKeyHandle::setString(const std::string& value) {
+  mmkv->setString(key, value);
+}
+
+void HybridKeyHandle::setNumber(double value) {
+  mmkv->setNumber(key, value);
+}
+
+void HybridKeyHandle::setBoolean(bool value) {
+  mmkv->setBoolean(key, value);
+}
+
+std::optional<bool> HybridKeyHandle::getBoolean() {
+  return mmkv->getBoolean(key);
+}
+
+std::optional<std::string> HybridKeyHandle::getString() {
+  return mmkv->getString(key);
+}
+
+std::optional<double> HybridKeyHandle::getNumber() {
+  return mmkv->getNumber(key);
+}
+
+std::optional<std::shared_ptr<ArrayBuffer>> HybridKeyHandle::getBuffer() {
+  return mmkv->getBuffer(key);
+}
+
+bool HybridKeyHandle::contains() {
+  return mmkv->contains(key);
+}
+
+bool HybridKeyHandle::remove() {
+  return mmkv->remove(key);
+}
+
+void HybridKeyHandle::loadHybridMethods() {
+  // Register all methods from the spec first
+  HybridKeyHandleSpec::loadHybridMethods();
+  // Then shadow the getters with raw JSI implementations
+  registerHybrids(this, [](Prototype& prototype) {
+    prototype.registerRawHybridMethod("getString", 0, &HybridKeyHandle::getStringRaw);
+    prototype.registerRawHybridMethod("getNumber", 0, &HybridKeyHandle::getNumberRaw);
+    prototype.registerRawHybridMethod("getBoolean", 0, &HybridKeyHandle::getBooleanRaw);
+  });
+}
+
+jsi::Value HybridKeyHandle::getStringRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value*, size_t count) {
+  HybridMMKV::checkArgumentCount(runtime, "KeyHandle.getString", 0, count);
+  return mmkv->getStringValue(runtime, key);
+}
+
+jsi::Value HybridKeyHandle::getNumberRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value*, size_t count) {
+  HybridMMKV::checkArgumentCount(runtime, "KeyHandle.getNumber", 0, count);
+  return mmkv->getNumberValue(key);
+}
+
+jsi::Value HybridKeyHandle::getBooleanRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value*, size_t count) {
+  HybridMMKV::checkArgumentCount(runtime, "KeyHandle.getBoolean", 0, count);
+  return mmkv->getBooleanValue(key);
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,57 @@
+//
+//  HybridKeyHandle.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "HybridKeyHandleSpec.hpp"
+#include <memory>
+#include <string>
+
+namespace margelo::nitro::mmkv {
+
+class HybridMMKV;
+
+/**
+ * A handle to a single key of a `HybridMMKV` instance.
+ * The key is converted from a JS string once when the handle is created, so calls
+ * on the handle skip the per-call JSI string conversion and allocation of the key.
+ */
+class HybridKeyHandle final : public HybridKeyHandleSpec {
+public:
+  HybridKeyHandle(const std::shared_ptr<HybridMMKV>& mmkv, const std::string& key);
+
+public:
+  // Properties
+  std::string getKey() override;
+
+public:
+  // Methods
+  void set(const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) override;
+  void setString(const std::string& value) override;
+  void setNumber(double value) override;
+  void setBoolean(bool value) override;
+  std::optional<bool> getBoolean() override;
+  std::optional<std::string> getString() override;
+  std::optional<double> getNumber() override;
+  std::optional<std::shared_ptr<ArrayBuffer>> getBuffer() override;
+  bool contains() override;
+  bool remove() override;
+
+protected:
+  void loadHybridMethods() override;
+
+private:
+  // Raw JSI fast-paths for the getters, skipping the generic JSIConverters (see `HybridMMKV`)
+  jsi::Value getStringRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+  jsi::Value getNumberRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+  jsi::Value getBooleanRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+
+private:
+  // Keeps the instance alive for as long as the handle is used
+  std::shared_ptr<HybridMMKV> mmkv;
+  std::string key;
+};
+
+} // namespace margelo::nitro::mmkv
@@ -6,14 +6,91 @@
 //
 
 #include "HybridMMKV.hpp"
+#include "HybridKeyHandle.hpp"
+#include "MMKVCoalescingListener.hpp"
+#include "MMKVContentChangeObserver.hpp"
+#include "MMKVScopedLock.hpp"
+#include "MMKVStatsRecorder.hpp"
+#include "MMKVTimerQueue.hpp"
+#include "MMKVTracer.hpp"
 #include "MMKVTypes.hpp"
 #include "MMKVValueChangedListenerRegistry.hpp"
 #include "ManagedMMBuffer.hpp"
 #include <NitroModules/NitroLogger.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <unordered_set>
 
 namespace margelo::nitro::mmkv {
 
-HybridMMKV::HybridMMKV(const Configuration& config) : HybridObject(TAG) {
+HybridMMKV::HybridMMKV(const Configuration& config, const std::shared_ptr<MMKVThreadPool>& threadPool)
+    : HybridObject(TAG), instance([config]() { return openInstance(config); }), threadPool(threadPool), id(config.id) {
+  MMKVTraceScope trace("create", id);
+  isMultiProcess = getMMKVMode(config) == ::mmkv::MMKV_MULTI_PROCESS;
+  syncPolicy = config.syncPolicy.value_or(SyncPolicy::OS);
+  syncInterval = std::chrono::milliseconds(static_cast<int64_t>(std::max(config.syncIntervalMs.value_or(1000.0), 0.0)));
+  rootPath = config.path.value_or("");
+  defaultExpireDuration = config.defaultTTLSeconds.has_value() ? toExpireDuration(config.defaultTTLSeconds.value()) : MMKV::ExpireNever;
+  if (config.maxBytes.has_value()) {
+    maxBytes = toLimit(config.maxBytes.value(), "maxBytes");
+  }
+  if (config.maxEntries.has_value()) {
+    maxEntries = toLimit(config.maxEntries.value(), "maxEntries");
+  }
+  if (maxBytes.has_value() || maxEntries.has_value()) {
+    // Twice as many slots as keys keeps collisions rare
+    size_t capacity = std::clamp(maxEntries.value_or(0) * 2, MIN_RECENCY_TRACKER_CAPACITY, MAX_RECENCY_TRACKER_CAPACITY);
+    recencyTracker = std::make_unique<MMKVRecencyTracker>(capacity);
+  }
+  // Only instances that are configured for it decode values, so plain values can never be mistaken for encoded ones
+  isEncodingEnabled = config.compression.has_value() || config.blobThresholdBytes.has_value();
+  bool useLZ4Compression = config.compression.value_or(Compression::NONE) == Compression::LZ4;
+  compressionCodec = useLZ4Compression ? MMKVCompression::Codec::LZ4 : MMKVCompression::Codec::NONE;
+  compressionThreshold = config.compressionThresholdBytes.has_value()
+                             ? toLimit(config.compressionThresholdBytes.value(), "compressionThresholdBytes")
+                             : DEFAULT_COMPRESSION_THRESHOLD;
+  if (config.blobThresholdBytes.has_value()) {
+    if (!config.encryptionKey.value_or("").empty()) [[unlikely]] {
+      throw std::runtime_error("`blobThresholdBytes` cannot be used together with an `encryptionKey`, as blobs are stored unencrypted!");
+    }
+    blobThreshold = toLimit(config.blobThresholdBytes.value(), "blobThresholdBytes");
+  }
+  std::optional<double> minLiveRatio;
+  if (config.autoCompactionThreshold.has_value()) {
+    double threshold = config.autoCompactionThreshold.value();
+    if (!(threshold > 0.0 && threshold < 1.0)) [[unlikely]] {
+      throw std::runtime_error("`autoCompactionThreshold` must be between 0 and 1! (Received: " + std::to_string(threshold) + ")");
+    }
+    minLiveRatio = threshold;
+  }
+  compactionPolicy = std::make_unique<MMKVCompactionPolicy>(minLiveRatio, MAX_AUTOMATIC_COMPACTION_PAUSE);
+  blobStore = std::make_unique<MMKVBlobStore>(MMKVBlobStore::getDirectory(rootPath.empty() ? MMKV::getRootDir() : rootPath, config.id));
+  if constexpr (MMKVStatsRecorder::IS_ENABLED) {
+    stats = std::make_unique<MMKVStatsRecorder>();
+  }
+}
+
+void HybridMMKV::open() {
+  instance.get();
+}
+
+void HybridMMKV::warmUp() {
+  BackgroundWork work(*this);
+  if (!work) {
+    // The file was removed in the meantime - opening it would create it again
+    return;
+  }
+  try {
+    open();
+  } catch (...) {
+    // Ignore errors here - the first real operation will try again and throw them to JS.
+  }
+}
+
+MMKV* HybridMMKV::openInstance(const Configuration& config) {
+  MMKVTraceScope trace("open", config.id);
   MMKVMode mmkvMode = getMMKVMode(config);
   if (config.readOnly.value_or(false)) {
     mmkvMode = mmkvMode | MMKVMode::MMKV_READ_ONLY;
@@ -35,7 +112,7 @@ HybridMMKV::HybridMMKV(const Configuration& config) : HybridObject(TAG) {
   Logger::log(LogLevel::Info, TAG, "Creating MMKV instance \"%s\"... (Path: %s, Encrypted: %s)", config.id.c_str(), rootPath.c_str(),
               hasEncryptionKey ? "true" : "false");
 
-  instance = MMKV::mmkvWithID(config.id, mmkvConfig);
+  MMKV* instance = MMKV::mmkvWithID(config.id, mmkvConfig);
 
   if (instance == nullptr) [[unlikely]] {
     // Check if instanceId is invalid
@@ -64,6 +141,15 @@ HybridMMKV::HybridMMKV(const Configuration& config) : HybridObject(TAG) {
 
     throw std::runtime_error("Failed to create MMKV instance!");
   }
+
+  if (config.defaultTTLSeconds.has_value()) {
+    bool successful = instance->enableAutoKeyExpire(toExpireDuration(config.defaultTTLSeconds.value()));
+    if (!successful) [[unlikely]] {
+      throw std::runtime_error("Failed to enable key expiration for MMKV instance \"" + config.id + "\"!");
+    }
+  }
+
+  return instance;
 }
 
 std::string HybridMMKV::getId() {
@@ -71,7 +157,7 @@ std::string HybridMMKV::getId() {
 }
 
 double HybridMMKV::getLength() {
-  return instance->count();
+  return instance->count(/* filterExpire */ true);
 }
 
 double HybridMMKV::getSize() {
@@ -98,42 +184,209 @@ struct overloaded : Ts... {
 template <class... Ts>
 overloaded(Ts...) -> overloaded<Ts...>;
 
-void HybridMMKV::set(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) {
+size_t HybridMMKV::getTracedKeysSize(const std::vector<std::string>& keys) {
+  if (!MMKVTracer::isEnabled()) [[likely]] {
+    return 0;
+  }
+  size_t size = 0;
+  for (const auto& key : keys) {
+    size += key.size();
+  }
+  return size;
+}
+
+size_t HybridMMKV::getTracedValueSize(const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) {
+  if (!MMKVTracer::isEnabled()) [[likely]] {
+    return 0;
+  }
+  return std::visit(overloaded{[](bool) { return sizeof(bool); }, [](const std::shared_ptr<ArrayBuffer>& buf) { return buf->size(); },
+                               [](const std::string& string) { return string.size(); }, [](double) { return sizeof(double); }},
+                    value);
+}
+
+std::optional<std::string> HybridMMKV::encodeValue(const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) {
+  if (!isEncodingEnabled) [[likely]] {
+    return std::nullopt;
+  }
+  return std::visit(overloaded{[&](const std::shared_ptr<ArrayBuffer>& buf) { return encodeValue(buf->data(), buf->size()); },
+                               [&](const std::string& string) { return encodeValue(string.data(), string.size()); },
+                               [](const auto&) -> std::optional<std::string> {
+                                 // booleans and numbers are never encoded
+                                 return std::nullopt;
+                               }},
+                    value);
+}
+
+bool HybridMMKV::setValue(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value,
+                          std::optional<std::string> encoded, std::optional<uint32_t> expireDuration) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::SET);
+  auto write = [&](auto&& mmkvValue) {
+    if (expireDuration.has_value()) {
+      return instance->set(std::forward<decltype(mmkvValue)>(mmkvValue), key, expireDuration.value());
+    }
+    return instance->set(std::forward<decltype(mmkvValue)>(mmkvValue), key);
+  };
+  if (encoded.has_value()) [[unlikely]] {
+    // A string or buffer that is stored encoded
+    return write(MMBuffer(encoded->data(), encoded->size(), MMBufferCopyFlag::MMBufferNoCopy));
+  }
+  // Pattern-match each potential value in std::variant
+  return std::visit(overloaded{[&](bool b) {
+                                 // boolean
+                                 return write(b);
+                               },
+                               [&](const std::shared_ptr<ArrayBuffer>& buf) {
+                                 // ArrayBuffer
+                                 MMBuffer buffer(buf->data(), buf->size(), MMBufferCopyFlag::MMBufferNoCopy);
+                                 return write(std::move(buffer));
+                               },
+                               [&](const std::string& string) {
+                                 // string
+                                 return write(string);
+                               },
+                               [&](double number) {
+                                 // number
+                                 return write(number);
+                               }},
+                    value);
+}
+
+void HybridMMKV::set(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value,
+                     const std::optional<SetOptions>& options) {
+  MMKVTraceScope trace("set", id, key.size(), getTracedValueSize(value));
   if (key.empty()) [[unlikely]] {
     throw std::runtime_error("Cannot set a value for an empty key!");
   }
 
-  // Pattern-match each potential value in std::variant
-  bool successful = std::visit(overloaded{[&](bool b) {
-                                            // boolean
-                                            return instance->set(b, key);
-                                          },
-                                          [&](const std::shared_ptr<ArrayBuffer>& buf) {
-                                            // ArrayBuffer
-                                            MMBuffer buffer(buf->data(), buf->size(), MMBufferCopyFlag::MMBufferNoCopy);
-                                            return instance->set(std::move(buffer), key);
-                                          },
-                                          [&](const std::string& string) {
-                                            // string
-                                            return instance->set(string, key);
-                                          },
-                                          [&](double number) {
-                                            // number
-                                            return instance->set(number, key);
-                                          }},
-                               value);
+  std::optional<uint32_t> expireDuration;
+  if (options.has_value() && options->ttlSeconds.has_value()) [[unlikely]] {
+    expireDuration = toExpireDuration(options->ttlSeconds.value());
+    enableKeyExpiration();
+  }
+
+  bool successful = setValue(key, value, encodeValue(value), expireDuration);
   if (!successful) [[unlikely]] {
     throw std::runtime_error("Failed to set value for key \"" + key + "\"!");
   }
+  didAccess(key);
+  didWrite(/* isBatch */ false);
 
   // Notify on changed
-  MMKVValueChangedListenerRegistry::notifyOnValueChanged(instance->mmapID(), key);
+  notifyOnValueChanged(key);
+}
+
+template <typename T>
+void HybridMMKV::setPrimitive(const std::string& key, const T& value) {
+  size_t valueSize;
+  if constexpr (std::is_same_v<T, std::string>) {
+    valueSize = value.size();
+  } else {
+    valueSize = sizeof(T);
+  }
+  MMKVTraceScope trace("set", id, key.size(), valueSize);
+  if (key.empty()) [[unlikely]] {
+    throw std::runtime_error("Cannot set a value for an empty key!");
+  }
+
+  bool successful;
+  {
+    MMKVOperationTimer timer(stats.get(), MMKVOperation::SET);
+    if constexpr (std::is_same_v<T, std::string>) {
+      auto encoded = encodeValue(value.data(), value.size());
+      successful = encoded.has_value() ? instance->set(MMBuffer(encoded->data(), encoded->size(), MMBufferCopyFlag::MMBufferNoCopy), key)
+                                       : instance->set(value, key);
+    } else {
+      successful = instance->set(value, key);
+    }
+  }
+  if (!successful) [[unlikely]] {
+    throw std::runtime_error("Failed to set value for key \"" + key + "\"!");
+  }
+  didAccess(key);
+  didWrite(/* isBatch */ false);
+
+  // Notify on changed
+  notifyOnValueChanged(key);
+}
+
+std::optional<std::string> HybridMMKV::encodeValue(const void* data, size_t size) {
+  if (!isEncodingEnabled) [[likely]] {
+    // Stored and read as-is, like plain MMKV does
+    return std::nullopt;
+  }
+  auto encoded = MMKVCompression::encode(data, size, compressionCodec, compressionThreshold);
+  if (!blobThreshold.has_value()) [[likely]] {
+    return encoded;
+  }
+  const void* storedData = encoded.has_value() ? encoded->data() : data;
+  size_t storedSize = encoded.has_value() ? encoded->size() : size;
+  if (storedSize < blobThreshold.value()) {
+    return encoded;
+  }
+  // Store the (possibly compressed) value in its own file, and only a reference to it in MMKV
+  std::string blobId = blobStore->write(storedData, storedSize);
+  return MMKVCompression::encodeExternal(blobId, size);
+}
+
+void HybridMMKV::decodeValue(const void* data, size_t size, void* output) {
+  if (MMKVCompression::getCodec(data, size) != MMKVCompression::Codec::EXTERNAL) [[likely]] {
+    MMKVCompression::decode(data, size, output);
+    return;
+  }
+  auto blob = blobStore->read(MMKVCompression::getExternalId(data, size));
+  size_t decodedSize = MMKVCompression::getDecodedSize(data, size);
+  if (MMKVCompression::isEncoded(blob->data(), blob->size())) {
+    if (MMKVCompression::getDecodedSize(blob->data(), blob->size()) != decodedSize) [[unlikely]] {
+      throw std::runtime_error("Failed to decode value - its blob is corrupted!");
+    }
+    MMKVCompression::decode(blob->data(), blob->size(), output);
+    return;
+  }
+  if (blob->size() != decodedSize) [[unlikely]] {
+    throw std::runtime_error("Failed to decode value - its blob is corrupted!");
+  }
+  std::memcpy(output, blob->data(), decodedSize);
+}
+
+std::string HybridMMKV::decodeValueToString(const void* data, size_t size) {
+  std::string result(MMKVCompression::getDecodedSize(data, size), '\0');
+  decodeValue(data, size, result.data());
+  return result;
+}
+
+std::shared_ptr<ArrayBuffer> HybridMMKV::decodeValueToBuffer(const void* data, size_t size) {
+  if (MMKVCompression::getCodec(data, size) == MMKVCompression::Codec::EXTERNAL) {
+    auto blob = blobStore->read(MMKVCompression::getExternalId(data, size));
+    if (!MMKVCompression::isEncoded(blob->data(), blob->size()) && blob->size() == MMKVCompression::getDecodedSize(data, size)) {
+      // Zero-copy: JS reads straight from the mapped file, and the mapping lives as long as the ArrayBuffer
+      return ArrayBuffer::wrap(blob->data(), blob->size(), [blob]() {});
+    }
+  }
+  auto decoded = ArrayBuffer::allocate(MMKVCompression::getDecodedSize(data, size));
+  decodeValue(data, size, decoded->data());
+  return decoded;
+}
+
+void HybridMMKV::setString(const std::string& key, const std::string& value) {
+  setPrimitive(key, value);
+}
+
+void HybridMMKV::setNumber(const std::string& key, double value) {
+  setPrimitive(key, value);
+}
+
+void HybridMMKV::setBoolean(const std::string& key, bool value) {
+  setPrimitive(key, value);
 }
 
 std::optional<bool> HybridMMKV::getBoolean(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getBoolean", id, key.size());
   bool hasValue;
   bool result = instance->getBool(key, /* defaultValue */ false, &hasValue);
   if (hasValue) {
+    trace.setValueSize(sizeof(bool));
+    didAccess(key);
     return result;
   } else {
     return std::nullopt;
@@ -141,9 +394,16 @@ std::optional<bool> HybridMMKV::getBoolean(const std::string& key) {
 }
 
 std::optional<std::string> HybridMMKV::getString(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getString", id, key.size());
   std::string result;
   bool hasValue = instance->getString(key, result, /* inplaceModification */ true);
   if (hasValue) {
+    didAccess(key);
+    if (isEncodingEnabled && MMKVCompression::isEncoded(result.data(), result.size())) [[unlikely]] {
+      result = decodeValueToString(result.data(), result.size());
+    }
+    trace.setValueSize(result.size());
     return result;
   } else {
     return std::nullopt;
@@ -151,9 +411,13 @@ std::optional<std::string> HybridMMKV::getString(const std::string& key) {
 }
 
 std::optional<double> HybridMMKV::getNumber(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getNumber", id, key.size());
   bool hasValue;
   double result = instance->getDouble(key, /* defaultValue */ 0.0, &hasValue);
   if (hasValue) {
+    trace.setValueSize(sizeof(double));
+    didAccess(key);
     return result;
   } else {
     return std::nullopt;
@@ -161,39 +425,108 @@ std::optional<double> HybridMMKV::getNumber(const std::string& key) {
 }
 
 std::optional<std::shared_ptr<ArrayBuffer>> HybridMMKV::getBuffer(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getBuffer", id, key.size());
   MMBuffer result;
   bool hasValue = instance->getBytes(key, result);
   if (hasValue) {
+    didAccess(key);
+    if (isEncodingEnabled && MMKVCompression::isEncoded(result.getPtr(), result.length())) [[unlikely]] {
+      auto decoded = decodeValueToBuffer(result.getPtr(), result.length());
+      trace.setValueSize(decoded->size());
+      return decoded;
+    }
+    trace.setValueSize(result.length());
     return std::make_shared<ManagedMMBuffer>(std::move(result));
   } else {
     return std::nullopt;
   }
 }
 
+std::optional<double> HybridMMKV::getBufferInto(const std::string& key, const std::shared_ptr<ArrayBuffer>& buffer) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getBufferInto", id, key.size(), buffer->size());
+
+  // Fast path: copy the value straight from the mapped file into the target buffer in a single
+  // operation. That does not need the exclusive lock, which in multi-process mode is the
+  // exclusive file lock - a single read only takes the shared one.
+  int32_t written = instance->writeValueToBuffer(key, buffer->data(), static_cast<int32_t>(buffer->size()));
+  if (written >= 0) [[likely]] {
+    didAccess(key);
+  } else {
+    // The key does not exist, or the buffer is too small. Lock so the value cannot change between reading its size and copying it
+    MMKVScopedLock lock(instance.get());
+    if (!instance->containsKey(key)) {
+      return std::nullopt;
+    }
+    didAccess(key);
+
+    auto valueSize = static_cast<size_t>(instance->getValueSize(key, /* actualSize */ true));
+    if (valueSize > buffer->size()) {
+      // Buffer is too small - let the caller allocate a larger one. If the value is compressed, that is its decoded size.
+      MMBuffer value;
+      if (isEncodingEnabled && instance->getBytes(key, value) && MMKVCompression::isEncoded(value.getPtr(), value.length())) [[unlikely]] {
+        return static_cast<double>(MMKVCompression::getDecodedSize(value.getPtr(), value.length()));
+      }
+      return static_cast<double>(valueSize);
+    }
+    if (valueSize == 0) {
+      return 0.0;
+    }
+
+    // The value was changed between the fast path and taking the lock
+    written = instance->writeValueToBuffer(key, buffer->data(), static_cast<int32_t>(buffer->size()));
+    if (written < 0) [[unlikely]] {
+      throw std::runtime_error("Failed to read buffer for key \"" + key + "\"!");
+    }
+  }
+
+  if (isEncodingEnabled && MMKVCompression::isEncoded(buffer->data(), static_cast<size_t>(written))) [[unlikely]] {
+    // Decode from a copy, as the decoded value goes into the same buffer
+    std::string encoded(reinterpret_cast<const char*>(buffer->data()), static_cast<size_t>(written));
+    size_t decodedSize = MMKVCompression::getDecodedSize(encoded.data(), encoded.size());
+    if (decodedSize > buffer->size()) {
+      return static_cast<double>(decodedSize);
+    }
+    decodeValue(encoded.data(), encoded.size(), buffer->data());
+    return static_cast<double>(decodedSize);
+  }
+  return static_cast<double>(written);
+}
+
 bool HybridMMKV::contains(const std::string& key) {
   return instance->containsKey(key);
 }
 
 bool HybridMMKV::remove(const std::string& key) {
-  bool wasRemoved = instance->removeValueForKey(key);
+  MMKVTraceScope trace("remove", id, key.size());
+  bool wasRemoved;
+  {
+    MMKVOperationTimer timer(stats.get(), MMKVOperation::REMOVE);
+    wasRemoved = instance->removeValueForKey(key);
+  }
   if (wasRemoved) {
+    didWrite(/* isBatch */ false);
     // Notify on changed
-    MMKVValueChangedListenerRegistry::notifyOnValueChanged(instance->mmapID(), key);
+    notifyOnValueChanged(key);
   }
   return wasRemoved;
 }
 
 std::vector<std::string> HybridMMKV::getAllKeys() {
-  return instance->allKeys();
+  return instance->allKeys(/* filterExpire */ true);
 }
 
 void HybridMMKV::clearAll() {
   auto keysBefore = getAllKeys();
   instance->clearAll();
-  for (const auto& key : keysBefore) {
-    // Notify on changed
-    MMKVValueChangedListenerRegistry::notifyOnValueChanged(instance->mmapID(), key);
+  if (recencyTracker != nullptr) {
+    recencyTracker->clear();
   }
+  didWrite(/* isBatch */ true);
+
+  // Notify on changed
+  notifyOnValuesChanged(keysBefore);
 }
 
 void HybridMMKV::recrypt(const std::optional<std::string>& key) {
@@ -205,6 +538,11 @@ void HybridMMKV::recrypt(const std::optional<std::string>& key) {
 }
 
 void HybridMMKV::encrypt(const std::string& key, std::optional<EncryptionType> encryptionType) {
+  if (blobThreshold.has_value()) [[unlikely]] {
+    throw std::runtime_error("Cannot encrypt an MMKV instance that uses `blobThresholdBytes`, as blobs are stored unencrypted!");
+  }
+  // Re-encrypts the whole file
+  MMKVTraceScope trace("encrypt", id, 0, instance->actualSize());
   bool isAes256Encryption = encryptionType == EncryptionType::AES_256;
   bool successful = instance->reKey(key, isAes256Encryption);
   if (!successful) {
@@ -213,6 +551,7 @@ void HybridMMKV::encrypt(const std::string& key, std::optional<EncryptionType> e
 }
 
 void HybridMMKV::decrypt() {
+  MMKVTraceScope trace("decrypt", id, 0, instance->actualSize());
   bool successful = instance->reKey("");
   if (!successful) [[unlikely]] {
     throw std::runtime_error("Failed to decrypt MMKV instance!");
@@ -220,21 +559,679 @@ void HybridMMKV::decrypt() {
 }
 
 void HybridMMKV::trim() {
-  instance->trim();
+  if (!instance.isOpen()) {
+    // Nothing is mapped or cached yet - don't open a lazy instance just to trim it
+    return;
+  }
+  MMKVTraceScope trace("trim", id, 0, instance->totalSize());
+  removeUnreferencedBlobs();
+  compact();
   instance->clearMemoryCache();
 }
 
+size_t HybridMMKV::removeUnreferencedBlobs() {
+  if (!blobStore->exists()) [[likely]] {
+    // No value was ever stored in a blob
+    return 0;
+  }
+  std::unordered_set<std::string> referencedIds;
+  {
+    MMKVScopedLock lock(instance.get());
+    for (const auto& key : instance->allKeys(/* filterExpire */ false)) {
+      // References all have the same size, so most values don't need to be read at all
+      if (static_cast<size_t>(instance->getValueSize(key, /* actualSize */ true)) != EXTERNAL_REFERENCE_SIZE) {
+        continue;
+      }
+      MMBuffer value;
+      if (instance->getBytes(key, value) && MMKVCompression::isEncoded(value.getPtr(), value.length()) &&
+          MMKVCompression::getCodec(value.getPtr(), value.length()) == MMKVCompression::Codec::EXTERNAL) {
+        referencedIds.insert(MMKVCompression::getExternalId(value.getPtr(), value.length()));
+      }
+    }
+  }
+  return blobStore->removeUnreferenced(referencedIds);
+}
+
 Listener HybridMMKV::addOnValueChangedListener(const std::function<void(const std::string& /* key */)>& onValueChanged) {
   // Add listener
   auto mmkvID = instance->mmapID();
   auto listenerID = MMKVValueChangedListenerRegistry::addListener(mmkvID, onValueChanged);
+  observeOtherProcessesIfNeeded();
+
+  return Listener([=]() {
+    // remove()
+    MMKVValueChangedListenerRegistry::removeListener(mmkvID, listenerID);
+  });
+}
+
+Listener HybridMMKV::addOnKeyChangedListener(const std::string& key,
+                                             const std::function<void(const std::string& /* key */)>& onValueChanged) {
+  // Add listener for this key only
+  auto mmkvID = instance->mmapID();
+  auto listenerID = MMKVValueChangedListenerRegistry::addKeyListener(mmkvID, key, onValueChanged);
+  observeOtherProcessesIfNeeded();
+
+  return Listener([=]() {
+    // remove()
+    MMKVValueChangedListenerRegistry::removeListener(mmkvID, listenerID);
+  });
+}
+
+Listener HybridMMKV::addOnKeyPrefixChangedListener(const std::string& prefix,
+                                                   const std::function<void(const std::string& /* key */)>& onValueChanged) {
+  // Add listener for all keys starting with this prefix
+  auto mmkvID = instance->mmapID();
+  auto listenerID = MMKVValueChangedListenerRegistry::addPrefixListener(mmkvID, prefix, onValueChanged);
+  observeOtherProcessesIfNeeded();
+
+  return Listener([=]() {
+    // remove()
+    MMKVValueChangedListenerRegistry::removeListener(mmkvID, listenerID);
+  });
+}
+
+Listener HybridMMKV::addOnValuesChangedListener(const std::function<void(const std::vector<std::string>& /* keys */)>& onValuesChanged,
+                                                std::optional<double> flushIntervalMs) {
+  auto flushInterval = MMKVCoalescingListener::DEFAULT_FLUSH_INTERVAL;
+  if (flushIntervalMs.has_value()) {
+    flushInterval = std::chrono::milliseconds(static_cast<int64_t>(std::max(flushIntervalMs.value(), 0.0)));
+  }
+  auto mmkvID = instance->mmapID();
+
+  if (flushInterval.count() == 0) {
+    // Deliver right away - once per write, or once per batch with all of its keys
+    auto listenerID = MMKVValueChangedListenerRegistry::addBatchListener(mmkvID, [onValuesChanged](std::span<const std::string> keys) {
+      // JS gets its own copy of the keys
+      onValuesChanged(std::vector<std::string>(keys.begin(), keys.end()));
+    });
+    observeOtherProcessesIfNeeded();
+    return Listener([=]() {
+      // remove()
+      MMKVValueChangedListenerRegistry::removeListener(mmkvID, listenerID);
+    });
+  }
+
+  // Add listener that collects all changed keys
+  auto coalescingListener = std::make_shared<MMKVCoalescingListener>(MMKVCoalescingListener::Callback(onValuesChanged), flushInterval);
+  auto listenerID = MMKVValueChangedListenerRegistry::addBatchListener(
+      mmkvID, [coalescingListener](std::span<const std::string> keys) { coalescingListener->onValuesChanged(keys); });
+  observeOtherProcessesIfNeeded();
 
   return Listener([=]() {
     // remove()
     MMKVValueChangedListenerRegistry::removeListener(mmkvID, listenerID);
+    coalescingListener->cancel();
+  });
+}
+
+template <typename T>
+std::shared_ptr<Promise<T>> HybridMMKV::runAsync(std::function<T(HybridMMKV& self)>&& func) {
+  auto promise = Promise<T>::create();
+  auto self = shared_cast<HybridMMKV>();
+  threadPool->run([self, promise, func = std::move(func)]() {
+    BackgroundWork work(*self);
+    if (!work) [[unlikely]] {
+      promise->reject(std::make_exception_ptr(std::runtime_error("MMKV instance \"" + self->id + "\" was deleted!")));
+      return;
+    }
+    try {
+      if constexpr (std::is_void_v<T>) {
+        func(*self);
+        promise->resolve();
+      } else {
+        promise->resolve(func(*self));
+      }
+    } catch (...) {
+      promise->reject(std::current_exception());
+    }
+  });
+  return promise;
+}
+
+std::shared_ptr<Promise<void>> HybridMMKV::setAsync(const std::string& key,
+                                                    const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) {
+  std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double> ownedValue = value;
+  if (auto buffer = std::get_if<std::shared_ptr<ArrayBuffer>>(&value)) {
+    // JS-owned ArrayBuffers can only be accessed on the JS Thread, so we need to copy it before leaving it.
+    // The copy is kept alive by the task until the write has finished.
+    ownedValue = ArrayBuffer::copy((*buffer)->data(), (*buffer)->size());
+  }
+  return runAsync<void>([key, ownedValue = std::move(ownedValue)](HybridMMKV& self) { self.set(key, ownedValue, std::nullopt); });
+}
+
+std::shared_ptr<Promise<std::optional<std::string>>> HybridMMKV::getStringAsync(const std::string& key) {
+  return runAsync<std::optional<std::string>>([key](HybridMMKV& self) { return self.getString(key); });
+}
+
+std::shared_ptr<Promise<std::optional<std::shared_ptr<ArrayBuffer>>>> HybridMMKV::getBufferAsync(const std::string& key) {
+  return runAsync<std::optional<std::shared_ptr<ArrayBuffer>>>([key](HybridMMKV& self) { return self.getBuffer(key); });
+}
+
+std::shared_ptr<Promise<double>> HybridMMKV::importAllFromAsync(const std::shared_ptr<HybridMMKVSpec>& other) {
+  return runAsync<double>([other](HybridMMKV& self) { return self.importAllFrom(other); });
+}
+
+std::shared_ptr<Promise<double>> HybridMMKV::removeExpiredKeys() {
+  return runAsync<double>([](HybridMMKV& self) { return static_cast<double>(self.sweepExpiredKeys()); });
+}
+
+std::shared_ptr<Promise<void>> HybridMMKV::trimAsync() {
+  return runAsync<void>([](HybridMMKV& self) { self.trim(); });
+}
+
+void HybridMMKV::flush(std::optional<Durability> durability) {
+  bool waitForDisk = durability.value_or(Durability::SYNC) == Durability::SYNC;
+  // msync() only writes back pages that are actually dirty, so this is cheap if little changed.
+  instance->sync(waitForDisk ? MMKV_SYNC : MMKV_ASYNC);
+}
+
+std::shared_ptr<HybridKeyHandleSpec> HybridMMKV::key(const std::string& key) {
+  if (key.empty()) [[unlikely]] {
+    throw std::runtime_error("Cannot create a handle for an empty key!");
+  }
+  return std::make_shared<HybridKeyHandle>(shared_cast<HybridMMKV>(), key);
+}
+
+int64_t HybridMMKV::toInteger(double value, const char* name) {
+  // Only integers in the safe range of a JS number can be represented exactly
+  if (std::trunc(value) != value || std::abs(value) > static_cast<double>(MAX_SAFE_INTEGER)) [[unlikely]] {
+    throw std::runtime_error(std::string("`") + name + "` must be an integer! (received: " + std::to_string(value) + ")");
+  }
+  return static_cast<int64_t>(value);
+}
+
+void HybridMMKV::setInt(const std::string& key, double value) {
+  int64_t integer = toInteger(value, "value");
+  if (integer < std::numeric_limits<int32_t>::min() || integer > std::numeric_limits<int32_t>::max()) [[unlikely]] {
+    throw std::runtime_error("`value` must be a 32-bit integer! (received: " + std::to_string(integer) + ")");
+  }
+  setPrimitive(key, static_cast<int32_t>(integer));
+}
+
+std::optional<double> HybridMMKV::getInt(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getInt", id, key.size());
+  bool hasValue;
+  int32_t result = instance->getInt32(key, /* defaultValue */ 0, &hasValue);
+  if (hasValue) {
+    trace.setValueSize(sizeof(int32_t));
+    didAccess(key);
+    return result;
+  } else {
+    return std::nullopt;
+  }
+}
+
+void HybridMMKV::setInt64(const std::string& key, int64_t value) {
+  setPrimitive(key, value);
+}
+
+std::optional<int64_t> HybridMMKV::getInt64(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getInt64", id, key.size());
+  bool hasValue;
+  int64_t result = instance->getInt64(key, /* defaultValue */ 0, &hasValue);
+  if (hasValue) {
+    trace.setValueSize(sizeof(int64_t));
+    didAccess(key);
+    return result;
+  } else {
+    return std::nullopt;
+  }
+}
+
+double HybridMMKV::increment(const std::string& key, std::optional<double> delta) {
+  if (key.empty()) [[unlikely]] {
+    throw std::runtime_error("Cannot set a value for an empty key!");
+  }
+  int64_t integerDelta = toInteger(delta.value_or(1.0), "delta");
+
+  int64_t newValue;
+  {
+    // Also takes the cross-process lock in multi-process mode, so the read and the write are atomic
+    MMKVScopedLock lock(instance.get());
+    MMKVOperationTimer timer(stats.get(), MMKVOperation::SET);
+    int64_t currentValue = instance->getInt64(key, /* defaultValue */ 0);
+    // The stored value can be any 64-bit integer (see `setInt64(...)`), but the result is returned as a JS number
+    if (__builtin_add_overflow(currentValue, integerDelta, &newValue) || newValue > MAX_SAFE_INTEGER || newValue < -MAX_SAFE_INTEGER)
+        [[unlikely]] {
+      throw std::runtime_error("Cannot increment \"" + key + "\" (" + std::to_string(currentValue) + ") by " +
+                               std::to_string(integerDelta) + ", the result would not be a safe integer!");
+    }
+    bool successful = instance->set(newValue, key);
+    if (!successful) [[unlikely]] {
+      throw std::runtime_error("Failed to set value for key \"" + key + "\"!");
+    }
+  }
+  didAccess(key);
+  didWrite(/* isBatch */ false);
+
+  // Notify on changed
+  notifyOnValueChanged(key);
+  return static_cast<double>(newValue);
+}
+
+bool HybridMMKV::compareAndSet(const std::string& key, double expected, double next) {
+  if (key.empty()) [[unlikely]] {
+    throw std::runtime_error("Cannot set a value for an empty key!");
+  }
+  int64_t expectedValue = toInteger(expected, "expected");
+  int64_t nextValue = toInteger(next, "next");
+
+  {
+    // Also takes the cross-process lock in multi-process mode, so the read and the write are atomic
+    MMKVScopedLock lock(instance.get());
+    MMKVOperationTimer timer(stats.get(), MMKVOperation::SET);
+    bool hasValue;
+    int64_t currentValue = instance->getInt64(key, /* defaultValue */ 0, &hasValue);
+    if (!hasValue || currentValue != expectedValue) {
+      return false;
+    }
+    bool successful = instance->set(nextValue, key);
+    if (!successful) [[unlikely]] {
+      throw std::runtime_error("Failed to set value for key \"" + key + "\"!");
+    }
+  }
+  didAccess(key);
+  didWrite(/* isBatch */ false);
+
+  // Notify on changed
+  notifyOnValueChanged(key);
+  return true;
+}
+
+uint32_t HybridMMKV::toExpireDuration(double ttlSeconds) {
+  if (!std::isfinite(ttlSeconds) || ttlSeconds < 0) [[unlikely]] {
+    throw std::runtime_error("`ttlSeconds` must be a positive number! (received: " + std::to_string(ttlSeconds) + ")");
+  }
+  // MMKV expires in whole seconds - round up so a value never expires too early
+  double seconds = std::min(std::ceil(ttlSeconds), static_cast<double>(std::numeric_limits<uint32_t>::max()));
+  return static_cast<uint32_t>(seconds);
+}
+
+size_t HybridMMKV::toLimit(double value, const char* name) {
+  int64_t integer = toInteger(value, name);
+  if (integer <= 0) [[unlikely]] {
+    throw std::runtime_error(std::string("`") + name + "` must be a positive integer! (received: " + std::to_string(integer) + ")");
+  }
+  return static_cast<size_t>(integer);
+}
+
+void HybridMMKV::enableKeyExpiration() {
+  std::call_once(keyExpirationFlag, [this]() {
+    // MMKV uses the default duration for all writes that don't pass their own
+    bool successful = instance->enableAutoKeyExpire(defaultExpireDuration);
+    if (!successful) [[unlikely]] {
+      throw std::runtime_error("Failed to enable key expiration for MMKV instance \"" + instance->mmapID() + "\"!");
+    }
+  });
+  scheduleExpiredKeysSweep();
+}
+
+void HybridMMKV::scheduleExpiredKeysSweep() {
+  if (isExpiredKeysSweepScheduled.exchange(true)) {
+    // The sweeper is already running.
+    return;
+  }
+  std::weak_ptr<HybridMMKV> weakSelf = shared_cast<HybridMMKV>();
+  MMKVTimerQueue::shared().schedule(EXPIRED_KEYS_SWEEP_INTERVAL, [weakSelf]() {
+    auto self = weakSelf.lock();
+    if (self == nullptr) {
+      return;
+    }
+    // Sweeping reads all keys and compacts the file, so don't do that on the timer thread.
+    self->threadPool->run([weakSelf]() {
+      auto self = weakSelf.lock();
+      if (self == nullptr) {
+        return;
+      }
+      BackgroundWork work(*self);
+      if (!work) {
+        return;
+      }
+      try {
+        self->sweepExpiredKeys();
+      } catch (...) {
+        // Try again next time
+      }
+      self->isExpiredKeysSweepScheduled = false;
+      self->scheduleExpiredKeysSweep();
+    });
+  });
+}
+
+size_t HybridMMKV::sweepExpiredKeys() {
+  std::vector<std::string> expiredKeys;
+  {
+    MMKVScopedLock lock(instance.get());
+    std::vector<std::string> allKeys = instance->allKeys(/* filterExpire */ false);
+    std::vector<std::string> liveKeys = instance->allKeys(/* filterExpire */ true);
+    if (allKeys.size() == liveKeys.size()) {
+      // Nothing expired
+      return 0;
+    }
+    std::unordered_set<std::string> liveKeySet(liveKeys.begin(), liveKeys.end());
+    for (auto& key : allKeys) {
+      if (!liveKeySet.contains(key)) {
+        expiredKeys.push_back(std::move(key));
+      }
+    }
+  }
+
+  // Remove in batches, so other threads don't have to wait for the whole sweep.
+  std::vector<std::string> removedKeys;
+  removedKeys.reserve(expiredKeys.size());
+  for (size_t offset = 0; offset < expiredKeys.size(); offset += EXPIRED_KEYS_SWEEP_BATCH_SIZE) {
+    size_t end = std::min(offset + EXPIRED_KEYS_SWEEP_BATCH_SIZE, expiredKeys.size());
+    std::vector<std::string> batch;
+    batch.reserve(end - offset);
+
+    MMKVScopedLock lock(instance.get());
+    for (size_t i = offset; i < end; i++) {
+      // The key might have been written again since we looked
+      if (!instance->containsKey(expiredKeys[i])) {
+        batch.push_back(expiredKeys[i]);
+      }
+    }
+    if (!batch.empty()) {
+      instance->removeValuesForKeys(batch);
+      removedKeys.insert(removedKeys.end(), batch.begin(), batch.end());
+    }
+  }
+
+  if (removedKeys.empty()) {
+    return 0;
+  }
+  // Removing only appends to the file - compact it to actually free the space.
+  compact();
+  didWrite(/* isBatch */ true);
+
+  // Notify on changed
+  notifyOnValuesChanged(removedKeys);
+  return removedKeys.size();
+}
+
+void HybridMMKV::didAccess(const std::string& key) {
+  if (recencyTracker != nullptr) [[unlikely]] {
+    recencyTracker->touch(key);
+  }
+}
+
+bool HybridMMKV::isOverLimits() {
+  if (maxEntries.has_value() && instance->count() > maxEntries.value()) {
+    return true;
+  }
+  // Includes overwritten and removed values that are still in the file until it is compacted
+  return maxBytes.has_value() && instance->actualSize() > maxBytes.value();
+}
+
+void HybridMMKV::evictIfNeeded() {
+  if (!isOverLimits()) [[likely]] {
+    return;
+  }
+  if (isEvictionScheduled.exchange(true)) {
+    // An eviction is already running, it will make room for this write too.
+    return;
+  }
+  // Evicting reads all keys and compacts the file, so don't block the caller with that.
+  std::weak_ptr<HybridMMKV> weakSelf = shared_cast<HybridMMKV>();
+  threadPool->run([weakSelf]() {
+    auto self = weakSelf.lock();
+    if (self == nullptr) {
+      return;
+    }
+    BackgroundWork work(*self);
+    if (!work) {
+      return;
+    }
+    size_t evictedCount = 0;
+    try {
+      evictedCount = self->evictLeastRecentlyUsed();
+    } catch (...) {
+      // Try again on the next write
+    }
+    self->isEvictionScheduled = false;
+    if (evictedCount > 0) {
+      // Writes that happened in the meantime could not schedule another eviction
+      self->evictIfNeeded();
+    }
+  });
+}
+
+size_t HybridMMKV::evictLeastRecentlyUsed() {
+  std::vector<std::string> evictedKeys;
+  {
+    MMKVScopedLock lock(instance.get());
+    if (maxBytes.has_value() && instance->actualSize() > maxBytes.value()) {
+      // Maybe the file only grew because of overwritten values - compacting might already be enough.
+      compact();
+    }
+
+    std::vector<std::string> keys = recencyTracker->sortByRecency(instance->allKeys());
+    size_t entriesToEvict = 0;
+    if (maxEntries.has_value() && keys.size() > maxEntries.value()) {
+      auto targetEntries = static_cast<size_t>(static_cast<double>(maxEntries.value()) * EVICTION_TARGET_RATIO);
+      entriesToEvict = keys.size() - targetEntries;
+    }
+    size_t bytesToFree = 0;
+    if (maxBytes.has_value() && instance->actualSize() > maxBytes.value()) {
+      // trim() does not compact files that still fit into their first page, so their used size may stay above a
+      // small limit no matter how many keys are evicted - only the live values count towards the limit here.
+      size_t liveSize = estimateLiveSize();
+      auto targetBytes = static_cast<size_t>(static_cast<double>(maxBytes.value()) * EVICTION_TARGET_RATIO);
+      if (liveSize > maxBytes.value()) {
+        bytesToFree = liveSize - targetBytes;
+      }
+    }
+
+    for (auto& key : keys) {
+      if (evictedKeys.size() >= entriesToEvict && bytesToFree == 0) {
+        break;
+      }
+      // What the key takes up in the file once it is compacted, like in `estimateLiveSize()`
+      size_t entryBytes = 1 + key.size() + instance->getValueSize(key, /* actualSize */ false);
+      bytesToFree = entryBytes >= bytesToFree ? 0 : bytesToFree - entryBytes;
+      evictedKeys.push_back(std::move(key));
+    }
+    if (evictedKeys.empty()) {
+      return 0;
+    }
+    instance->removeValuesForKeys(evictedKeys);
+    // Removing only appends to the file - compact it to actually free the space.
+    compact();
+  }
+  didWrite(/* isBatch */ true);
+
+  // Notify on changed
+  notifyOnValuesChanged(evictedKeys);
+  return evictedKeys.size();
+}
+
+void HybridMMKV::didWrite(bool isBatch) {
+  if (recencyTracker != nullptr) [[unlikely]] {
+    evictIfNeeded();
+  }
+  if (compactionPolicy->isAutomatic()) [[unlikely]] {
+    scheduleAutomaticCompaction();
+  }
+  switch (syncPolicy) {
+    case SyncPolicy::OS:
+      // The OS writes dirty pages back whenever it wants
+      return;
+    case SyncPolicy::PERIODIC:
+      schedulePeriodicSync();
+      return;
+    case SyncPolicy::EVERY_WRITE:
+      instance->sync(MMKV_SYNC);
+      return;
+    case SyncPolicy::EVERY_BATCH:
+      if (isBatch) {
+        instance->sync(MMKV_SYNC);
+      }
+      return;
+  }
+}
+
+void HybridMMKV::schedulePeriodicSync() {
+  if (isPeriodicSyncScheduled.exchange(true)) {
+    // A sync is already pending, it will include this write too.
+    return;
+  }
+  std::weak_ptr<HybridMMKV> weakSelf = shared_cast<HybridMMKV>();
+  MMKVTimerQueue::shared().schedule(syncInterval, [weakSelf]() {
+    auto self = weakSelf.lock();
+    if (self == nullptr) {
+      return;
+    }
+    // Syncing blocks until the pages are on disk, so don't do that on the timer thread.
+    self->threadPool->run([weakSelf]() {
+      auto self = weakSelf.lock();
+      if (self == nullptr) {
+        return;
+      }
+      BackgroundWork work(*self);
+      if (!work) {
+        return;
+      }
+      // Writes from now on need a new sync
+      self->isPeriodicSyncScheduled = false;
+      self->instance->sync(MMKV_SYNC);
+    });
+  });
+}
+
+void HybridMMKV::compact() {
+  // MMKV's trim() rewrites only the live values and shrinks the file if it can.
+  // Lock around it, so the sizes before and after are not changed by other writes.
+  MMKVScopedLock lock(instance.get());
+  size_t fileSizeBefore = instance->totalSize();
+  size_t actualSizeBefore = instance->actualSize();
+  auto start = std::chrono::steady_clock::now();
+  instance->trim();
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+  size_t fileSizeAfter = instance->totalSize();
+  size_t actualSizeAfter = instance->actualSize();
+  if (fileSizeAfter == fileSizeBefore && actualSizeAfter == actualSizeBefore) {
+    // Nothing to compact
+    return;
+  }
+  compactionPolicy->didCompact(fileSizeBefore, fileSizeAfter, actualSizeAfter, duration);
+}
+
+void HybridMMKV::scheduleAutomaticCompaction() {
+  lastWriteTime.store(MMKVTimerQueue::Clock::now(), std::memory_order_relaxed);
+  if (isCompactionCheckScheduled.exchange(true)) {
+    // A check is already pending, it will wait for this write to settle too.
+    return;
+  }
+  scheduleCompactionCheck(COMPACTION_IDLE_DELAY);
+}
+
+void HybridMMKV::scheduleCompactionCheck(std::chrono::milliseconds delay) {
+  std::weak_ptr<HybridMMKV> weakSelf = shared_cast<HybridMMKV>();
+  MMKVTimerQueue::shared().schedule(delay, [weakSelf]() {
+    auto self = weakSelf.lock();
+    if (self == nullptr) {
+      return;
+    }
+    auto idleDuration =
+        std::chrono::duration_cast<std::chrono::milliseconds>(MMKVTimerQueue::Clock::now() - self->lastWriteTime.load(std::memory_order_relaxed));
+    if (idleDuration < COMPACTION_IDLE_DELAY) {
+      // Still being written to - check again once the last write has settled
+      self->scheduleCompactionCheck(COMPACTION_IDLE_DELAY - idleDuration);
+      return;
+    }
+    // Estimating the live size reads all keys, so don't do that on the timer thread.
+    self->threadPool->run([weakSelf]() {
+      auto self = weakSelf.lock();
+      if (self == nullptr) {
+        return;
+      }
+      BackgroundWork work(*self);
+      if (!work) {
+        return;
+      }
+      // Writes from now on need a new check
+      self->isCompactionCheckScheduled = false;
+      // Overwritten or removed values might have left their blobs behind
+      self->removeUnreferencedBlobs();
+      self->compactIfFragmented();
+    });
   });
 }
 
+void HybridMMKV::compactIfFragmented() {
+  size_t fileSize = instance->totalSize();
+  // The live values are at most what MMKV has written since the last compaction
+  size_t liveSize = instance->actualSize();
+  if (!compactionPolicy->isFragmented(liveSize, fileSize)) {
+    // That includes overwritten and removed values though - count the live ones.
+    liveSize = estimateLiveSize();
+    if (!compactionPolicy->isFragmented(liveSize, fileSize)) {
+      return;
+    }
+  }
+  if (!compactionPolicy->isWithinMaxPause(liveSize)) [[unlikely]] {
+    Logger::log(LogLevel::Info, TAG, "Not compacting MMKV instance \"%s\" automatically, it would block it for ~%lldms. Call trim() instead.",
+                instance->mmapID().c_str(), static_cast<long long>(compactionPolicy->estimateDuration(liveSize).count() / 1000));
+    return;
+  }
+  compact();
+}
+
+size_t HybridMMKV::estimateLiveSize() {
+  size_t usedSize = instance->actualSize();
+  // The file starts with the size of its content
+  size_t liveSize = sizeof(uint32_t);
+  // Every key is only locked for a moment, so readers and writers never wait for the whole estimate
+  for (const auto& key : instance->allKeys(/* filterExpire */ false)) {
+    // The key with its varint length, and the value (which includes its own length already)
+    liveSize += 1 + key.size() + instance->getValueSize(key, /* actualSize */ false);
+  }
+
+  std::unique_lock lock(lastLiveSizeMutex);
+  lastLiveSize = LiveSizeEstimate{usedSize, liveSize, std::chrono::steady_clock::now()};
+  return liveSize;
+}
+
+size_t HybridMMKV::getRecentLiveSize(size_t usedSize) {
+  {
+    std::unique_lock lock(lastLiveSizeMutex);
+    if (lastLiveSize.has_value()) {
+      // Nothing was written since (MMKV appends every write), or it is recent enough for stats
+      bool isUnchanged = lastLiveSize->usedSize == usedSize;
+      bool isRecent = std::chrono::steady_clock::now() - lastLiveSize->time < LIVE_SIZE_MAX_AGE;
+      if (isUnchanged || isRecent) {
+        return lastLiveSize->liveSize;
+      }
+    }
+  }
+  return estimateLiveSize();
+}
+
+CompactionStats HybridMMKV::getCompactionStats() {
+  auto stats = compactionPolicy->getStats();
+  auto toMilliseconds = [](std::chrono::microseconds duration) { return static_cast<double>(duration.count()) / 1000.0; };
+  return CompactionStats(static_cast<double>(stats.compactionCount), static_cast<double>(stats.bytesReclaimed),
+                         toMilliseconds(stats.totalDuration), toMilliseconds(stats.lastDuration), toMilliseconds(stats.maxDuration));
+}
+
+void HybridMMKV::observeOtherProcessesIfNeeded() {
+  if (!isMultiProcess) {
+    // No other process can change our data
+    return;
+  }
+  std::call_once(contentChangeObserverFlag, [this]() {
+    std::string directory = rootPath.empty() ? MMKV::getRootDir() : rootPath;
+    contentChangeObserver = MMKVContentChangeObserver::getOrCreate(instance.get(), directory);
+  });
+  if (contentChangeObserver != nullptr) [[likely]] {
+    // It pauses itself once all listeners are removed
+    contentChangeObserver->resume();
+  }
+}
+
 MMKVMode HybridMMKV::getMMKVMode(const Configuration& config) {
   if (!config.mode.has_value()) {
     return ::mmkv::MMKV_SINGLE_PROCESS;
@@ -248,14 +1245,427 @@ MMKVMode HybridMMKV::getMMKVMode(const Configuration& config) {
   throw std::runtime_error("Invalid MMKV Mode value!");
 }
 
+void HybridMMKV::notifyOnValueChanged(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::NOTIFY);
+  MMKVTraceScope trace("notify", id, key.size());
+  MMKVValueChangedListenerRegistry::notifyOnValueChanged(instance->mmapID(), key);
+}
+
+void HybridMMKV::notifyOnValuesChanged(const std::vector<std::string>& keys) {
+  if (keys.empty()) {
+    return;
+  }
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::NOTIFY);
+  // One event for all keys
+  MMKVTraceScope trace("notify", id, getTracedKeysSize(keys));
+  MMKVValueChangedListenerRegistry::notifyOnValuesChanged(instance->mmapID(), keys);
+}
+
+HybridMMKV::StatsSample HybridMMKV::sampleStats() {
+  StatsSample sample;
+  if (stats != nullptr) {
+    sample.snapshot = stats->getSnapshot();
+  }
+  sample.listenerCount = MMKVValueChangedListenerRegistry::getListenerCount(instance->mmapID());
+  // Sizes are only looked at here instead of after every write, so writes never pay for taking the lock again
+  size_t fileSize = instance->totalSize();
+  size_t usedSize = instance->actualSize();
+  if (stats != nullptr) {
+    stats->didObserveSizes(fileSize, usedSize);
+  }
+  sample.liveBytes = std::min(getRecentLiveSize(usedSize), fileSize);
+  sample.fileBytes = fileSize;
+  return sample;
+}
+
+InstanceStats HybridMMKV::getStats() {
+  return toInstanceStats(sampleStats());
+}
+
+InstanceStats HybridMMKV::toInstanceStats(const StatsSample& sample) {
+  const auto& snapshot = sample.snapshot;
+  auto toOperationStats = [&](MMKVOperation operation) {
+    if (!snapshot.has_value()) {
+      return OperationStats(0.0, 0.0, 0.0, 0.0, {});
+    }
+    const auto& histogram = (*snapshot)[operation];
+    double meanNanoseconds =
+        histogram.count > 0 ? static_cast<double>(histogram.totalNanoseconds) / static_cast<double>(histogram.count) : 0.0;
+    std::vector<double> buckets(histogram.buckets.begin(), histogram.buckets.end());
+    return OperationStats(static_cast<double>(histogram.count), meanNanoseconds / 1000.0,
+                          static_cast<double>(histogram.getPercentile(0.5)) / 1000.0,
+                          static_cast<double>(histogram.getPercentile(0.99)) / 1000.0, std::move(buckets));
+  };
+  auto toNumber = [&](uint64_t MMKVStatsRecorder::Snapshot::*field) {
+    return snapshot.has_value() ? static_cast<double>((*snapshot).*field) : 0.0;
+  };
+  return InstanceStats(snapshot.has_value(), toOperationStats(MMKVOperation::GET), toOperationStats(MMKVOperation::SET),
+                       toOperationStats(MMKVOperation::REMOVE), toOperationStats(MMKVOperation::NOTIFY),
+                       toNumber(&MMKVStatsRecorder::Snapshot::bytesWritten), toNumber(&MMKVStatsRecorder::Snapshot::fileGrowths),
+                       toNumber(&MMKVStatsRecorder::Snapshot::fullWriteBacks), static_cast<double>(sample.listenerCount),
+                       static_cast<double>(sample.liveBytes), static_cast<double>(sample.fileBytes));
+}
+
+bool HybridMMKV::isOpen() const {
+  return instance.isOpen();
+}
+
+void HybridMMKV::close() {
+  {
+    std::unique_lock lock(backgroundWorkMutex);
+    isClosed = true;
+    backgroundWorkFinished.wait(lock, [this]() { return runningBackgroundWork == 0; });
+  }
+  // Waits for the observer to be created if another thread is doing that right now, and makes sure none is created later
+  std::call_once(contentChangeObserverFlag, []() {});
+  if (contentChangeObserver != nullptr) {
+    contentChangeObserver->stop();
+  }
+}
+
+HybridMMKV::BackgroundWork::BackgroundWork(HybridMMKV& mmkv) : _mmkv(mmkv) {
+  std::unique_lock lock(_mmkv.backgroundWorkMutex);
+  _isRunning = !_mmkv.isClosed;
+  if (_isRunning) {
+    _mmkv.runningBackgroundWork++;
+  }
+}
+
+HybridMMKV::BackgroundWork::~BackgroundWork() {
+  if (!_isRunning) {
+    return;
+  }
+  std::unique_lock lock(_mmkv.backgroundWorkMutex);
+  if (--_mmkv.runningBackgroundWork == 0) {
+    _mmkv.backgroundWorkFinished.notify_all();
+  }
+}
+
 double HybridMMKV::importAllFrom(const std::shared_ptr<HybridMMKVSpec>& other) {
   auto hybridMMKV = std::dynamic_pointer_cast<HybridMMKV>(other);
   if (hybridMMKV == nullptr) [[unlikely]] {
     throw std::runtime_error("The given `MMKV` instance is not of type `HybridMMKV`!");
   }
 
-  size_t importedCount = instance->importFrom(hybridMMKV->instance);
+  MMKVTraceScope trace("importAllFrom", id, 0, hybridMMKV->instance->actualSize());
+  // The source must not change until its values are imported, so the re-encoded values are still current
+  MMKVScopedLock sourceLock(hybridMMKV->instance.get());
+  std::vector<std::pair<std::string, std::string>> reencodedValues;
+  if (isEncodingEnabled || hybridMMKV->isEncodingEnabled) [[unlikely]] {
+    // Done before locking this instance, as it might read blobs and decompress values
+    reencodedValues = reencodeValuesFrom(*hybridMMKV);
+  }
+
+  size_t importedCount;
+  {
+    MMKVScopedLock lock(instance.get());
+    // MMKV copies the stored bytes as-is - then the values that have to be encoded differently here are overwritten
+    importedCount = instance->importFrom(hybridMMKV->instance.get());
+    for (auto& [key, value] : reencodedValues) {
+      instance->set(MMBuffer(value.data(), value.size(), MMBufferCopyFlag::MMBufferNoCopy), key);
+    }
+  }
+  if (importedCount > 0) {
+    didWrite(/* isBatch */ true);
+  }
   return static_cast<double>(importedCount);
 }
 
+std::vector<std::pair<std::string, std::string>> HybridMMKV::reencodeValuesFrom(HybridMMKV& source) {
+  std::vector<std::pair<std::string, std::string>> values;
+  for (const auto& key : source.instance->allKeys(/* filterExpire */ true)) {
+    // Only strings and buffers are stored behind their length, and only those can be encoded
+    size_t storedSize = source.instance->getValueSize(key, /* actualSize */ false);
+    size_t valueSize = source.instance->getValueSize(key, /* actualSize */ true);
+    if (valueSize == storedSize || valueSize < MMKVCompression::HEADER_SIZE) [[likely]] {
+      continue;
+    }
+    MMBuffer stored;
+    if (!source.instance->getBytes(key, stored)) [[unlikely]] {
+      continue;
+    }
+
+    // Compressed values and blob references of the source are only valid there
+    const void* data = stored.getPtr();
+    size_t size = stored.length();
+    std::string decoded;
+    bool isEncodedInSource = source.isEncodingEnabled && MMKVCompression::isEncoded(data, size);
+    if (isEncodedInSource) {
+      decoded = source.decodeValueToString(data, size);
+      data = decoded.data();
+      size = decoded.size();
+    }
+    if (auto encoded = encodeValue(data, size)) {
+      values.emplace_back(key, std::move(encoded.value()));
+    } else if (isEncodedInSource) {
+      values.emplace_back(key, std::move(decoded));
+    }
+  }
+  return values;
+}
+
+std::vector<std::optional<std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>>>
+HybridMMKV::getMany(const std::vector<std::string>& keys, const std::optional<std::vector<ValueType>>& types) {
+  if (types.has_value() && types->size() != keys.size()) [[unlikely]] {
+    throw std::runtime_error("`types` must have the same length as `keys`! (keys: " + std::to_string(keys.size()) +
+                             ", types: " + std::to_string(types->size()) + ")");
+  }
+
+  std::vector<std::optional<std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>>> results;
+  results.reserve(keys.size());
+
+  MMKVTraceScope trace("getMany", id, getTracedKeysSize(keys));
+
+  // Indices of values that are still encoded, and are decoded once the lock is released
+  std::vector<size_t> encodedIndices;
+  {
+    // Lock once for the whole batch instead of once per key, but only to copy the stored values
+    MMKVScopedLock lock(instance.get());
+    for (size_t i = 0; i < keys.size(); i++) {
+      const std::string& key = keys[i];
+      MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+      ValueType type = types.has_value() ? (*types)[i] : ValueType::STRING;
+      switch (type) {
+        case ValueType::STRING: {
+          std::string result;
+          if (instance->getString(key, result, /* inplaceModification */ true)) {
+            if (isEncodingEnabled && MMKVCompression::isEncoded(result.data(), result.size())) [[unlikely]] {
+              encodedIndices.push_back(i);
+            }
+            results.emplace_back(std::move(result));
+          } else {
+            results.emplace_back(std::nullopt);
+          }
+          break;
+        }
+        case ValueType::NUMBER: {
+          bool hasValue;
+          double result = instance->getDouble(key, /* defaultValue */ 0.0, &hasValue);
+          if (hasValue) {
+            results.emplace_back(result);
+          } else {
+            results.emplace_back(std::nullopt);
+          }
+          break;
+        }
+        case ValueType::BOOLEAN: {
+          bool hasValue;
+          bool result = instance->getBool(key, /* defaultValue */ false, &hasValue);
+          if (hasValue) {
+            results.emplace_back(result);
+          } else {
+            results.emplace_back(std::nullopt);
+          }
+          break;
+        }
+        case ValueType::BUFFER: {
+          MMBuffer result;
+          if (instance->getBytes(key, result)) {
+            if (isEncodingEnabled && MMKVCompression::isEncoded(result.getPtr(), result.length())) [[unlikely]] {
+              encodedIndices.push_back(i);
+            }
+            results.emplace_back(std::make_shared<ManagedMMBuffer>(std::move(result)));
+          } else {
+            results.emplace_back(std::nullopt);
+          }
+          break;
+        }
+        default:
+          throw std::runtime_error("Invalid ValueType value!");
+      }
+      if (results.back().has_value()) {
+        // Like the single getters, only keys that exist count as used
+        didAccess(key);
+      }
+    }
+  }
+
+  // Decompressing or reading blob files can be slow, so it must not block other threads from using this instance
+  for (size_t i : encodedIndices) {
+    auto& value = results[i].value();
+    if (auto* string = std::get_if<std::string>(&value)) {
+      *string = decodeValueToString(string->data(), string->size());
+    } else if (auto* buffer = std::get_if<std::shared_ptr<ArrayBuffer>>(&value)) {
+      value = decodeValueToBuffer((*buffer)->data(), (*buffer)->size());
+    }
+  }
+  return results;
+}
+
+void HybridMMKV::writeBatch(const std::vector<WriteBatchEntry>& entries, const std::optional<std::vector<std::string>>& removals) {
+  // 1. Validate the whole batch before writing anything
+  for (const auto& entry : entries) {
+    if (entry.key.empty()) [[unlikely]] {
+      throw std::runtime_error("Cannot set a value for an empty key!");
+    }
+  }
+  if (instance->isReadOnly()) [[unlikely]] {
+    throw std::runtime_error("Cannot write a batch to a read-only MMKV instance!");
+  }
+
+  // 2. Encode all values (which might write blobs) before locking, so nothing can fail halfway because of that
+  std::vector<std::optional<std::string>> encodedValues;
+  encodedValues.reserve(entries.size());
+  for (const auto& entry : entries) {
+    encodedValues.push_back(encodeValue(entry.value));
+  }
+
+  std::vector<std::string> changedKeys;
+  changedKeys.reserve(entries.size() + (removals.has_value() ? removals->size() : 0));
+  std::optional<std::string> failedKey;
+  std::exception_ptr error;
+
+  {
+    // 3. Apply all writes and removals while holding the lock once
+    MMKVScopedLock lock(instance.get());
+    try {
+      for (size_t i = 0; i < entries.size(); i++) {
+        const auto& entry = entries[i];
+        if (!setValue(entry.key, entry.value, std::move(encodedValues[i]))) [[unlikely]] {
+          failedKey = entry.key;
+          break;
+        }
+        didAccess(entry.key);
+        changedKeys.push_back(entry.key);
+      }
+      if (!failedKey.has_value() && removals.has_value()) {
+        // Only removals of keys that actually exist are changes
+        std::vector<std::string> existingKeys;
+        existingKeys.reserve(removals->size());
+        for (const auto& key : removals.value()) {
+          if (instance->containsKey(key)) {
+            existingKeys.push_back(key);
+          }
+        }
+        if (!existingKeys.empty()) {
+          MMKVOperationTimer timer(stats.get(), MMKVOperation::REMOVE);
+          instance->removeValuesForKeys(existingKeys);
+          changedKeys.insert(changedKeys.end(), existingKeys.begin(), existingKeys.end());
+        }
+      }
+    } catch (...) {
+      // The keys that were written until then stay written - so listeners still have to know about them
+      error = std::current_exception();
+    }
+  }
+
+  if (!changedKeys.empty()) {
+    didWrite(/* isBatch */ true);
+  }
+
+  // 4. Notify once for everything that has been written, even if the batch failed halfway
+  notifyOnValuesChanged(changedKeys);
+
+  if (error != nullptr) [[unlikely]] {
+    std::rethrow_exception(error);
+  }
+  if (failedKey.has_value()) [[unlikely]] {
+    throw std::runtime_error("Failed to set value for key \"" + failedKey.value() + "\"!");
+  }
+}
+
+void HybridMMKV::loadHybridMethods() {
+  // Register all methods from the spec first
+  HybridMMKVSpec::loadHybridMethods();
+  // Then shadow the hottest ones with raw JSI implementations
+  registerHybrids(this, [](Prototype& prototype) {
+    prototype.registerRawHybridMethod("setString", 2, &HybridMMKV::setStringRaw);
+    prototype.registerRawHybridMethod("setNumber", 2, &HybridMMKV::setNumberRaw);
+    prototype.registerRawHybridMethod("setBoolean", 2, &HybridMMKV::setBooleanRaw);
+    prototype.registerRawHybridMethod("getString", 1, &HybridMMKV::getStringRaw);
+    prototype.registerRawHybridMethod("getNumber", 1, &HybridMMKV::getNumberRaw);
+    prototype.registerRawHybridMethod("getBoolean", 1, &HybridMMKV::getBooleanRaw);
+  });
+}
+
+void HybridMMKV::checkArgumentCount(jsi::Runtime& runtime, const char* method, size_t expected, size_t count) {
+  if (count != expected) [[unlikely]] {
+    throw jsi::JSError(runtime, "`" + std::string(method) + "(...)` expected " + std::to_string(expected) + " arguments, but received " +
+                                    std::to_string(count) + "!");
+  }
+}
+
+jsi::Value HybridMMKV::setStringRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+  checkArgumentCount(runtime, "MMKV.setString", 2, count);
+  std::string key = args[0].asString(runtime).utf8(runtime);
+  std::string value = args[1].asString(runtime).utf8(runtime);
+  setPrimitive(key, value);
+  return jsi::Value::undefined();
+}
+
+jsi::Value HybridMMKV::setNumberRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+  checkArgumentCount(runtime, "MMKV.setNumber", 2, count);
+  std::string key = args[0].asString(runtime).utf8(runtime);
+  double value = args[1].asNumber();
+  setPrimitive(key, value);
+  return jsi::Value::undefined();
+}
+
+jsi::Value HybridMMKV::setBooleanRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+  checkArgumentCount(runtime, "MMKV.setBoolean", 2, count);
+  std::string key = args[0].asString(runtime).utf8(runtime);
+  if (!args[1].isBool()) [[unlikely]] {
+    throw jsi::JSError(runtime, "Value for key \"" + key + "\" is not a boolean!");
+  }
+  setPrimitive(key, args[1].getBool());
+  return jsi::Value::undefined();
+}
+
+jsi::Value HybridMMKV::getStringRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+  checkArgumentCount(runtime, "MMKV.getString", 1, count);
+  return getStringValue(runtime, args[0].asString(runtime).utf8(runtime));
+}
+
+jsi::Value HybridMMKV::getStringValue(jsi::Runtime& runtime, const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getString", id, key.size());
+  std::string result;
+  bool hasValue = instance->getString(key, result, /* inplaceModification */ true);
+  if (!hasValue) {
+    return jsi::Value::undefined();
+  }
+  didAccess(key);
+  if (isEncodingEnabled && MMKVCompression::isEncoded(result.data(), result.size())) [[unlikely]] {
+    result = decodeValueToString(result.data(), result.size());
+  }
+  trace.setValueSize(result.size());
+  return jsi::String::createFromUtf8(runtime, reinterpret_cast<const uint8_t*>(result.data()), result.size());
+}
+
+jsi::Value HybridMMKV::getNumberRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+  checkArgumentCount(runtime, "MMKV.getNumber", 1, count);
+  return getNumberValue(args[0].asString(runtime).utf8(runtime));
+}
+
+jsi::Value HybridMMKV::getNumberValue(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getNumber", id, key.size());
+  bool hasValue;
+  double result = instance->getDouble(key, /* defaultValue */ 0.0, &hasValue);
+  if (!hasValue) {
+    return jsi::Value::undefined();
+  }
+  trace.setValueSize(sizeof(double));
+  didAccess(key);
+  return jsi::Value(result);
+}
+
+jsi::Value HybridMMKV::getBooleanRaw(jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* args, size_t count) {
+  checkArgumentCount(runtime, "MMKV.getBoolean", 1, count);
+  return getBooleanValue(args[0].asString(runtime).utf8(runtime));
+}
+
+jsi::Value HybridMMKV::getBooleanValue(const std::string& key) {
+  MMKVOperationTimer timer(stats.get(), MMKVOperation::GET);
+  MMKVTraceScope trace("getBoolean", id, key.size());
+  bool hasValue;
+  bool result = instance->getBool(key, /* defaultValue */ false, &hasValue);
+  if (!hasValue) {
+    return jsi::Value::undefined();
+  }
+  trace.setValueSize(sizeof(bool));
+  didAccess(key);
+  return jsi::Value(result);
+}
+
 } // namespace margelo::nitro::mmkv
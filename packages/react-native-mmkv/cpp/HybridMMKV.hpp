@@ -9,13 +9,88 @@
 
 #include "Configuration.hpp"
 #include "HybridMMKVSpec.hpp"
+#include "MMKVBlobStore.hpp"
+#include "MMKVCompactionPolicy.hpp"
+#include "MMKVCompression.hpp"
+#include "MMKVContentChangeObserver.hpp"
+#include "MMKVInstanceHandle.hpp"
+#include "MMKVRecencyTracker.hpp"
+#include "MMKVStatsRecorder.hpp"
+#include "MMKVThreadPool.hpp"
+#include "MMKVTimerQueue.hpp"
 #include "MMKVTypes.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 
 namespace margelo::nitro::mmkv {
 
+/**
+ * An MMKV instance that can be shared between JS runtimes - the factory returns the same
+ * `HybridMMKV` for the same file in every runtime, so all methods can be called from any thread.
+ *
+ * MMKV guards every instance with a single internal lock that each read and write takes, so reads
+ * from multiple runtimes are thread-safe but still run one after another. Only the lookup and copy
+ * of a value happens under that lock - decoding, decompressing and reading blobs does not.
+ * Listeners are plain Nitro callbacks, so they are always called on the JS thread of the runtime
+ * that added them.
+ */
 class HybridMMKV final : public HybridMMKVSpec {
 public:
-  explicit HybridMMKV(const Configuration& configuration);
+  HybridMMKV(const Configuration& configuration, const std::shared_ptr<MMKVThreadPool>& threadPool);
+
+public:
+  /**
+   * Opens the underlying MMKV instance if it is not open yet.
+   * If opening fails, this throws - and the next operation will try again.
+   */
+  void open();
+
+  /**
+   * Like `open()`, but ignores errors.
+   * Used to open `lazy` instances in the background, ahead of their first use.
+   */
+  void warmUp();
+
+  /**
+   * Opens (or gets the already opened) MMKV instance for the given `Configuration`.
+   * MMKV keeps all opened instances alive until they are closed or removed.
+   */
+  static MMKV* openInstance(const Configuration& config);
+
+  /**
+   * Starts removing expired keys in the background about once a minute, for as long as
+   * this instance is alive. Called automatically once key expiration is used.
+   */
+  void scheduleExpiredKeysSweep();
+
+  /**
+   * Whether the underlying MMKV instance has been opened already (see `lazy`).
+   */
+  bool isOpen() const;
+
+  /**
+   * Must be called before the file of this instance is removed, as MMKV frees the underlying instance with it.
+   * Stops observing other processes and waits for all background work on this instance to finish.
+   * Background work scheduled afterwards does not run anymore, and async methods reject.
+   */
+  void close();
+
+  /**
+   * The raw numbers behind `getStats()`. Samples of many instances can be summed up,
+   * which is how the factory reports stats of all instances.
+   */
+  struct StatsSample {
+    // `std::nullopt` if stats are disabled at build time
+    std::optional<MMKVStatsRecorder::Snapshot> snapshot;
+    size_t listenerCount = 0;
+    size_t liveBytes = 0;
+    size_t fileBytes = 0;
+  };
+  StatsSample sampleStats();
+  static InstanceStats toInstanceStats(const StatsSample& sample);
 
 public:
   // Properties
@@ -28,11 +103,16 @@ public:
 
 public:
   // Methods
-  void set(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) override;
+  void set(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value,
+           const std::optional<SetOptions>& options) override;
+  void setString(const std::string& key, const std::string& value) override;
+  void setNumber(const std::string& key, double value) override;
+  void setBoolean(const std::string& key, bool value) override;
   std::optional<bool> getBoolean(const std::string& key) override;
   std::optional<std::string> getString(const std::string& key) override;
   std::optional<double> getNumber(const std::string& key) override;
   std::optional<std::shared_ptr<ArrayBuffer>> getBuffer(const std::string& key) override;
+  std::optional<double> getBufferInto(const std::string& key, const std::shared_ptr<ArrayBuffer>& buffer) override;
   bool contains(const std::string& key) override;
   bool remove(const std::string& key) override;
   std::vector<std::string> getAllKeys() override;
@@ -42,13 +122,262 @@ public:
   void decrypt() override;
   void trim() override;
   Listener addOnValueChangedListener(const std::function<void(const std::string& /* key */)>& onValueChanged) override;
+  Listener addOnKeyChangedListener(const std::string& key, const std::function<void(const std::string& /* key */)>& onValueChanged) override;
+  Listener addOnKeyPrefixChangedListener(const std::string& prefix,
+                                         const std::function<void(const std::string& /* key */)>& onValueChanged) override;
+  Listener addOnValuesChangedListener(const std::function<void(const std::vector<std::string>& /* keys */)>& onValuesChanged,
+                                      std::optional<double> flushIntervalMs) override;
   double importAllFrom(const std::shared_ptr<HybridMMKVSpec>& other) override;
+  std::vector<std::optional<std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>>>
+  getMany(const std::vector<std::string>& keys, const std::optional<std::vector<ValueType>>& types) override;
+  void writeBatch(const std::vector<WriteBatchEntry>& entries, const std::optional<std::vector<std::string>>& removals) override;
+  std::shared_ptr<Promise<void>> setAsync(const std::string& key,
+                                          const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) override;
+  std::shared_ptr<Promise<std::optional<std::string>>> getStringAsync(const std::string& key) override;
+  std::shared_ptr<Promise<std::optional<std::shared_ptr<ArrayBuffer>>>> getBufferAsync(const std::string& key) override;
+  std::shared_ptr<Promise<double>> importAllFromAsync(const std::shared_ptr<HybridMMKVSpec>& other) override;
+  std::shared_ptr<Promise<void>> trimAsync() override;
+  void flush(std::optional<Durability> durability) override;
+  std::shared_ptr<HybridKeyHandleSpec> key(const std::string& key) override;
+  void setInt(const std::string& key, double value) override;
+  std::optional<double> getInt(const std::string& key) override;
+  void setInt64(const std::string& key, int64_t value) override;
+  std::optional<int64_t> getInt64(const std::string& key) override;
+  double increment(const std::string& key, std::optional<double> delta) override;
+  bool compareAndSet(const std::string& key, double expected, double next) override;
+  std::shared_ptr<Promise<double>> removeExpiredKeys() override;
+  CompactionStats getCompactionStats() override;
+  InstanceStats getStats() override;
+
+public:
+  /**
+   * Throws a `jsi::JSError` if a raw JSI method was called with the wrong number of arguments,
+   * like the generated methods do. `method` is the name used in the error message (e.g. `"MMKV.setString"`).
+   */
+  static void checkArgumentCount(jsi::Runtime& runtime, const char* method, size_t expected, size_t count);
+  /**
+   * The raw JSI getters, shared with `HybridKeyHandle`. Return `undefined` if the key has no value.
+   */
+  jsi::Value getStringValue(jsi::Runtime& runtime, const std::string& key);
+  jsi::Value getNumberValue(const std::string& key);
+  jsi::Value getBooleanValue(const std::string& key);
+
+protected:
+  void loadHybridMethods() override;
+
+private:
+  // Raw JSI fast-paths for the hottest methods, skipping the generic JSIConverters
+  jsi::Value setStringRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+  jsi::Value setNumberRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+  jsi::Value setBooleanRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+  jsi::Value getStringRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+  jsi::Value getNumberRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
+  jsi::Value getBooleanRaw(jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* args, size_t count);
 
 private:
   static MMKVMode getMMKVMode(const Configuration& config);
+  /**
+   * Converts a JS number to an integer, or throws if it is not one.
+   * `name` is the name of the parameter, used in the error message.
+   */
+  static int64_t toInteger(double value, const char* name);
+  /**
+   * Converts a TTL in seconds to an MMKV expire duration, or throws if it is invalid.
+   */
+  static uint32_t toExpireDuration(double ttlSeconds);
+  /**
+   * Converts a size or count option (e.g. `maxBytes`) to a `size_t`, or throws if it is not a positive integer.
+   */
+  static size_t toLimit(double value, const char* name);
+  /**
+   * Enables MMKV's key expiration for this instance if it is not enabled yet.
+   */
+  void enableKeyExpiration();
+  /**
+   * Removes all expired keys in batches and compacts the file afterwards.
+   * Returns the number of keys that were removed.
+   */
+  size_t sweepExpiredKeys();
+  /**
+   * Marks the given `key` as recently used, if this instance has a `maxBytes` or `maxEntries` limit.
+   */
+  void didAccess(const std::string& key);
+  /**
+   * Starts evicting the least recently used keys in the background if this instance is over its limits.
+   */
+  void evictIfNeeded();
+  bool isOverLimits();
+  /**
+   * Removes the least recently used keys until this instance is below its limits again (with some headroom),
+   * and compacts the file afterwards. Returns the number of keys that were removed.
+   */
+  size_t evictLeastRecentlyUsed();
+  /**
+   * Compacts the file (see `MMKV::trim()`), and records it in the compaction stats.
+   * Must be used instead of calling `instance->trim()` directly.
+   */
+  void compact();
+  /**
+   * Schedules checking whether the file is fragmented enough to be compacted, once this instance is idle.
+   */
+  void scheduleAutomaticCompaction();
+  void scheduleCompactionCheck(std::chrono::milliseconds delay);
+  /**
+   * Compacts the file if it is fragmented enough, and compacting it does not block readers and writers for too long.
+   */
+  void compactIfFragmented();
+  /**
+   * Estimates how many bytes of the file hold live (not overwritten or removed) values.
+   * This visits every key, so it also remembers the result for `getRecentLiveSize(...)`.
+   */
+  size_t estimateLiveSize();
+  /**
+   * Gets the last `estimateLiveSize()` result if nothing was written since, or if it is younger
+   * than `LIVE_SIZE_MAX_AGE` - otherwise estimates it again.
+   */
+  size_t getRecentLiveSize(size_t usedSize);
+  /**
+   * In multi-process mode, starts observing the MMKV file for changes made by
+   * other processes, so they are delivered to this process' listeners too.
+   * Must be called after adding a listener.
+   */
+  void observeOtherProcessesIfNeeded();
+  /**
+   * Called after every successful write to sync it to disk, depending on the `SyncPolicy`.
+   * `isBatch` is `true` for writes that change many keys at once (batches, imports, clears).
+   */
+  void didWrite(bool isBatch);
+  /**
+   * Notifies all listeners of this instance about the changed key(s), and records how long that took.
+   */
+  void notifyOnValueChanged(const std::string& key);
+  void notifyOnValuesChanged(const std::vector<std::string>& keys);
+  void schedulePeriodicSync();
+  template <typename T>
+  void setPrimitive(const std::string& key, const T& value);
+  /**
+   * Compresses the given string or buffer value if needed, see `MMKVCompression::encode(...)`.
+   * Returns `std::nullopt` if it can be stored as-is.
+   */
+  std::optional<std::string> encodeValue(const void* data, size_t size);
+  std::optional<std::string> encodeValue(const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value);
+  /**
+   * Decodes a stored value that was encoded by `encodeValue(...)`, reading it from its blob if it is stored externally.
+   * `output` must be `MMKVCompression::getDecodedSize(...)` bytes large.
+   */
+  void decodeValue(const void* data, size_t size, void* output);
+  std::string decodeValueToString(const void* data, size_t size);
+  std::shared_ptr<ArrayBuffer> decodeValueToBuffer(const void* data, size_t size);
+  /**
+   * Decodes all strings and buffers of `source` that it encoded, and encodes them with the settings of this instance.
+   * Returns the values that have to be stored differently here than in `source`, in the format they have to be stored in.
+   */
+  std::vector<std::pair<std::string, std::string>> reencodeValuesFrom(HybridMMKV& source);
+  /**
+   * Removes all blobs that are no longer referenced by any key. Returns the number of removed blobs.
+   */
+  size_t removeUnreferencedBlobs();
+  /**
+   * Gets the size of the given value for trace events, or `0` if tracing is disabled.
+   */
+  static size_t getTracedValueSize(const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value);
+  /**
+   * Gets the size of all keys together for trace events, or `0` if tracing is disabled.
+   */
+  static size_t getTracedKeysSize(const std::vector<std::string>& keys);
+  /**
+   * Writes the given value, or `encoded` instead if it is set (see `encodeValue(...)`).
+   */
+  bool setValue(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value,
+                std::optional<std::string> encoded, std::optional<uint32_t> expireDuration = std::nullopt);
+  /**
+   * Runs `func` on the thread pool, keeping this instance alive until it finished,
+   * and resolves (or rejects) the returned Promise with its result.
+   */
+  template <typename T>
+  std::shared_ptr<Promise<T>> runAsync(std::function<T(HybridMMKV& self)>&& func);
+
+  /**
+   * Marks background work on `instance` as running for as long as it is alive, so `close()` can wait for it.
+   * It is `false` if this instance is closed already - then the work must not run.
+   */
+  class BackgroundWork final {
+  public:
+    explicit BackgroundWork(HybridMMKV& mmkv);
+    ~BackgroundWork();
+    BackgroundWork(const BackgroundWork&) = delete;
+    BackgroundWork& operator=(const BackgroundWork&) = delete;
+    explicit operator bool() const {
+      return _isRunning;
+    }
+
+  private:
+    HybridMMKV& _mmkv;
+    bool _isRunning;
+  };
+
+private:
+  // `Number.MAX_SAFE_INTEGER`
+  static constexpr int64_t MAX_SAFE_INTEGER = 9007199254740991;
+  static constexpr auto EXPIRED_KEYS_SWEEP_INTERVAL = std::chrono::minutes(1);
+  static constexpr size_t EXPIRED_KEYS_SWEEP_BATCH_SIZE = 256;
+  // Evicting only down to the limit would make the next write evict (and compact) again
+  static constexpr double EVICTION_TARGET_RATIO = 0.9;
+  // Enough slots for a few thousand keys to rarely share one, while staying at a few hundred KB
+  static constexpr size_t MIN_RECENCY_TRACKER_CAPACITY = 16384;
+  static constexpr size_t MAX_RECENCY_TRACKER_CAPACITY = 1 << 20;
+  static constexpr size_t DEFAULT_COMPRESSION_THRESHOLD = 4096;
+  // Only compact once writes have settled, so a burst of writes does not trigger a compaction after every few writes
+  static constexpr auto COMPACTION_IDLE_DELAY = std::chrono::seconds(2);
+  static constexpr auto MAX_AUTOMATIC_COMPACTION_PAUSE = std::chrono::milliseconds(20);
+  static constexpr size_t EXTERNAL_REFERENCE_SIZE = MMKVCompression::HEADER_SIZE + MMKVBlobStore::ID_LENGTH;
 
 private:
-  MMKV* instance;
+  MMKVInstanceHandle instance;
+  std::shared_ptr<MMKVThreadPool> threadPool;
+  // Only used for trace events - `instance` has to stay closed until it is used if it is `lazy`
+  std::string id;
+  SyncPolicy syncPolicy;
+  std::chrono::milliseconds syncInterval;
+  std::atomic<bool> isPeriodicSyncScheduled = false;
+  uint32_t defaultExpireDuration;
+  std::once_flag keyExpirationFlag;
+  std::atomic<bool> isExpiredKeysSweepScheduled = false;
+  std::optional<size_t> maxBytes;
+  std::optional<size_t> maxEntries;
+  // Only allocated if this instance has limits
+  std::unique_ptr<MMKVRecencyTracker> recencyTracker;
+  std::atomic<bool> isEvictionScheduled = false;
+  // Whether `compression` or `blobThresholdBytes` are configured - otherwise values are never encoded or decoded
+  bool isEncodingEnabled;
+  MMKVCompression::Codec compressionCodec;
+  size_t compressionThreshold;
+  std::optional<size_t> blobThreshold;
+  // Always created, so values that were stored in blobs earlier can still be read
+  std::unique_ptr<MMKVBlobStore> blobStore;
+  std::unique_ptr<MMKVCompactionPolicy> compactionPolicy;
+  std::atomic<MMKVTimerQueue::Clock::time_point> lastWriteTime;
+  std::atomic<bool> isCompactionCheckScheduled = false;
+  // Only allocated if stats are enabled at build time
+  std::unique_ptr<MMKVStatsRecorder> stats;
+  struct LiveSizeEstimate {
+    // `actualSize()` at the time of the estimate
+    size_t usedSize;
+    size_t liveSize;
+    std::chrono::steady_clock::time_point time;
+  };
+  std::mutex lastLiveSizeMutex;
+  std::optional<LiveSizeEstimate> lastLiveSize;
+  static constexpr auto LIVE_SIZE_MAX_AGE = std::chrono::seconds(5);
+  bool isMultiProcess;
+  std::string rootPath;
+  std::once_flag contentChangeObserverFlag;
+  std::shared_ptr<MMKVContentChangeObserver> contentChangeObserver;
+  // Counts the `BackgroundWork` that is running right now, and whether `close()` was called
+  std::mutex backgroundWorkMutex;
+  std::condition_variable backgroundWorkFinished;
+  size_t runningBackgroundWork = 0;
+  bool isClosed = false;
 };
 
 } // namespace margelo::nitro::mmkv
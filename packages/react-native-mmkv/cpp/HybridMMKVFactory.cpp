@@ -7,10 +7,22 @@
 
 #include "HybridMMKVFactory.hpp"
 #include "HybridMMKV.hpp"
+#include "MMKVBlobStore.hpp"
+#include "MMKVChromeTraceSink.hpp"
+#include "MMKVTracer.hpp"
 #include "MMKVTypes.hpp"
+#include <algorithm>
+#include <exception>
+#include <mutex>
 
 namespace margelo::nitro::mmkv {
 
+// static members
+std::mutex HybridMMKVFactory::instanceCacheMutex;
+std::unordered_multimap<std::string, HybridMMKVFactory::CachedInstance> HybridMMKVFactory::instanceCache;
+size_t HybridMMKVFactory::instanceCacheHits = 0;
+size_t HybridMMKVFactory::instanceCacheMisses = 0;
+
 std::string HybridMMKVFactory::getDefaultMMKVInstanceId() {
   return DEFAULT_MMAP_ID;
 }
@@ -23,15 +35,248 @@ void HybridMMKVFactory::initializeMMKV(const std::string& rootPath) {
 }
 
 std::shared_ptr<HybridMMKVSpec> HybridMMKVFactory::createMMKV(const Configuration& configuration) {
-  return std::make_shared<HybridMMKV>(configuration);
+  std::string cacheKey = getCacheKey(configuration);
+  std::unique_lock lock(instanceCacheMutex);
+
+  const char* mismatchedOption = nullptr;
+  auto [begin, end] = instanceCache.equal_range(cacheKey);
+  for (auto cached = begin; cached != end; ++cached) {
+    if (auto mmkv = cached->second.instance.lock()) {
+      mismatchedOption = getMismatchedOption(cached->second.configuration, configuration);
+      if (mismatchedOption == nullptr) [[likely]] {
+        instanceCacheHits++;
+        return mmkv;
+      }
+    }
+  }
+  if (mismatchedOption != nullptr) [[unlikely]] {
+    // Keep the old behaviour of a separate instance, but this is most likely a mistake.
+    Logger::log(LogLevel::Warning, TAG, "MMKV instance \"%s\" already exists with a different `%s`, creating a new one...",
+                configuration.id.c_str(), mismatchedOption);
+  }
+
+  instanceCacheMisses++;
+  // Drop entries of instances that have been released in the meantime
+  std::erase_if(instanceCache, [](const auto& entry) { return entry.second.instance.expired(); });
+
+  // Creating the instance is cheap, opening it is not - other runtimes shouldn't wait for that.
+  auto mmkv = std::make_shared<HybridMMKV>(configuration, threadPool);
+  instanceCache.emplace(cacheKey, CachedInstance{.instance = mmkv, .configuration = configuration});
+  lock.unlock();
+
+  if (!configuration.lazy.value_or(false)) {
+    // Open right away, so errors are thrown by `createMMKV(...)`.
+    // Other runtimes that get this instance from the cache in the meantime wait for the same open.
+    mmkv->open();
+  }
+  if (configuration.defaultTTLSeconds.has_value()) {
+    mmkv->scheduleExpiredKeysSweep();
+  }
+  if (configuration.lazy.value_or(false)) {
+    // Open it in the background - if it is used before that finished, the caller waits for it.
+    std::weak_ptr<HybridMMKV> weakMMKV = mmkv;
+    threadPool->run([weakMMKV]() {
+      if (auto mmkv = weakMMKV.lock()) {
+        mmkv->warmUp();
+      }
+    });
+  }
+  return mmkv;
 }
 
-bool HybridMMKVFactory::deleteMMKV(const std::string& id) {
-  return MMKV::removeStorage(id);
+bool HybridMMKVFactory::deleteMMKV(const std::string& id, const std::optional<std::string>& path) {
+  // Same as in `HybridMMKV::openInstance(...)` - an empty path is the default root directory.
+  std::string rootPath = path.value_or("");
+  std::string* rootPathPtr = rootPath.size() > 0 ? &rootPath : nullptr;
+  std::vector<std::shared_ptr<HybridMMKV>> aliveInstances;
+  {
+    // The underlying MMKV instance will be closed, so it must not be handed out again.
+    // Only the file in the given `path` is removed - instances with the same `id` in another `path` stay.
+    std::string fileKey = getFileKey(id, rootPath);
+    std::unique_lock lock(instanceCacheMutex);
+    std::erase_if(instanceCache, [&](const auto& entry) {
+      const Configuration& configuration = entry.second.configuration;
+      if (getFileKey(configuration.id, configuration.path.value_or("")) != fileKey) {
+        return false;
+      }
+      if (auto mmkv = entry.second.instance.lock()) {
+        aliveInstances.push_back(std::move(mmkv));
+      }
+      return true;
+    });
+  }
+  // MMKV frees the instance when removing its file - nothing may still use it in the background by then
+  for (const auto& mmkv : aliveInstances) {
+    mmkv->close();
+  }
+  // Blobs of values that were too large to be stored in the MMKV file itself live next to it
+  MMKVBlobStore(MMKVBlobStore::getDirectory(rootPath.empty() ? MMKV::getRootDir() : rootPath, id)).removeAll();
+  return MMKV::removeStorage(id, rootPathPtr);
 }
 
 bool HybridMMKVFactory::existsMMKV(const std::string& id) {
   return MMKV::checkExist(id);
 }
 
+std::shared_ptr<Promise<void>> HybridMMKVFactory::preloadMMKV(const std::vector<Configuration>& configurations) {
+  auto promise = Promise<void>::create();
+  if (configurations.empty()) {
+    promise->resolve();
+    return promise;
+  }
+
+  // Shared between all open tasks - the last one to finish settles the Promise.
+  struct PreloadState {
+    std::mutex mutex;
+    size_t remaining;
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<PreloadState>();
+  state->remaining = configurations.size();
+
+  for (const auto& configuration : configurations) {
+    preloadThreadPool->run([configuration, state, promise]() {
+      std::exception_ptr error;
+      try {
+        // MMKV keeps opened instances alive, so `createMMKV(...)` will later just look it up.
+        HybridMMKV::openInstance(configuration);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      std::unique_lock lock(state->mutex);
+      if (error != nullptr && state->error == nullptr) {
+        state->error = error;
+      }
+      if (--state->remaining > 0) {
+        return;
+      }
+      lock.unlock();
+      if (state->error != nullptr) {
+        promise->reject(state->error);
+      } else {
+        promise->resolve();
+      }
+    });
+  }
+  return promise;
+}
+
+InstanceCacheStats HybridMMKVFactory::getInstanceCacheStats() {
+  std::unique_lock lock(instanceCacheMutex);
+  size_t size = std::count_if(instanceCache.begin(), instanceCache.end(), [](const auto& entry) { return !entry.second.instance.expired(); });
+  return InstanceCacheStats(static_cast<double>(instanceCacheHits), static_cast<double>(instanceCacheMisses), static_cast<double>(size));
+}
+
+InstanceStats HybridMMKVFactory::getStats() {
+  std::vector<std::shared_ptr<HybridMMKV>> instances;
+  {
+    std::unique_lock lock(instanceCacheMutex);
+    for (const auto& [cacheKey, cached] : instanceCache) {
+      if (auto mmkv = cached.instance.lock()) {
+        instances.push_back(std::move(mmkv));
+      }
+    }
+  }
+
+  HybridMMKV::StatsSample total;
+  if constexpr (MMKVStatsRecorder::IS_ENABLED) {
+    total.snapshot = MMKVStatsRecorder::Snapshot();
+  }
+  for (const auto& mmkv : instances) {
+    if (!mmkv->isOpen()) {
+      // Lazy instances that were never used have nothing to report - don't open them for that
+      continue;
+    }
+    auto sample = mmkv->sampleStats();
+    if (total.snapshot.has_value() && sample.snapshot.has_value()) {
+      total.snapshot.value() += sample.snapshot.value();
+    }
+    total.listenerCount += sample.listenerCount;
+    total.liveBytes += sample.liveBytes;
+    total.fileBytes += sample.fileBytes;
+  }
+  return HybridMMKV::toInstanceStats(total);
+}
+
+std::string HybridMMKVFactory::startTracing(const std::optional<std::string>& filePath) {
+  std::string path = filePath.value_or(MMKV::getRootDir() + "/" + DEFAULT_TRACE_FILE_NAME);
+  auto sink = std::make_shared<MMKVChromeTraceSink>(path);
+  Logger::log(LogLevel::Info, TAG, "Tracing all MMKV operations to %s...", path.c_str());
+  stopTracing();
+  MMKVTracer::setSink(sink);
+  return path;
+}
+
+void HybridMMKVFactory::stopTracing() {
+  auto sink = MMKVTracer::getSink();
+  MMKVTracer::setSink(nullptr);
+  if (auto chromeTraceSink = std::dynamic_pointer_cast<MMKVChromeTraceSink>(sink)) {
+    // Complete the file right away, operations that are still running are not traced anymore
+    chromeTraceSink->close();
+  }
+}
+
+std::string HybridMMKVFactory::getFileKey(const std::string& id, const std::string& path) {
+  std::string key = id;
+  key += '\0';
+  key += path;
+  return key;
+}
+
+std::string HybridMMKVFactory::getCacheKey(const Configuration& configuration) {
+  std::string key = getFileKey(configuration.id, configuration.path.value_or(""));
+  std::string encryptionKey = configuration.encryptionKey.value_or("");
+  if (!encryptionKey.empty()) {
+    // The encryption type only matters if there is an encryption key
+    bool isAes256Encryption = configuration.encryptionType.value_or(EncryptionType::AES_128) == EncryptionType::AES_256;
+    key += '\0';
+    key += isAes256Encryption ? "aes-256" : "aes-128";
+    key += '\0';
+    key += encryptionKey;
+  }
+  return key;
+}
+
+const char* HybridMMKVFactory::getMismatchedOption(const Configuration& cached, const Configuration& requested) {
+  if (cached.mode.value_or(Mode::SINGLE_PROCESS) != requested.mode.value_or(Mode::SINGLE_PROCESS)) {
+    return "mode";
+  }
+  if (cached.readOnly.value_or(false) != requested.readOnly.value_or(false)) {
+    return "readOnly";
+  }
+  if (cached.compareBeforeSet.value_or(false) != requested.compareBeforeSet.value_or(false)) {
+    return "compareBeforeSet";
+  }
+  if (cached.syncPolicy.value_or(SyncPolicy::OS) != requested.syncPolicy.value_or(SyncPolicy::OS)) {
+    return "syncPolicy";
+  }
+  if (cached.syncIntervalMs != requested.syncIntervalMs) {
+    return "syncIntervalMs";
+  }
+  if (cached.defaultTTLSeconds != requested.defaultTTLSeconds) {
+    return "defaultTTLSeconds";
+  }
+  if (cached.maxBytes != requested.maxBytes) {
+    return "maxBytes";
+  }
+  if (cached.maxEntries != requested.maxEntries) {
+    return "maxEntries";
+  }
+  if (cached.compression.value_or(Compression::NONE) != requested.compression.value_or(Compression::NONE)) {
+    return "compression";
+  }
+  if (cached.compressionThresholdBytes != requested.compressionThresholdBytes) {
+    return "compressionThresholdBytes";
+  }
+  if (cached.blobThresholdBytes != requested.blobThresholdBytes) {
+    return "blobThresholdBytes";
+  }
+  if (cached.autoCompactionThreshold != requested.autoCompactionThreshold) {
+    return "autoCompactionThreshold";
+  }
+  // `lazy` only decides when the instance is opened, so it does not matter once it exists.
+  return nullptr;
+}
+
 } // namespace margelo::nitro::mmkv
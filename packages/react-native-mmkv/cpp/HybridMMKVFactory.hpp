@@ -8,9 +8,17 @@
 #pragma once
 
 #include "HybridMMKVFactorySpec.hpp"
+#include "MMKVThreadPool.hpp"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 
 namespace margelo::nitro::mmkv {
 
+class HybridMMKV;
+
 class HybridMMKVFactory final : public HybridMMKVFactorySpec {
 public:
   HybridMMKVFactory() : HybridObject(TAG) {}
@@ -20,8 +28,50 @@ public:
   void initializeMMKV(const std::string& rootPath) override;
 
   std::shared_ptr<HybridMMKVSpec> createMMKV(const Configuration& configuration) override;
-  bool deleteMMKV(const std::string& id) override;
+  bool deleteMMKV(const std::string& id, const std::optional<std::string>& path) override;
   bool existsMMKV(const std::string& id) override;
+  std::shared_ptr<Promise<void>> preloadMMKV(const std::vector<Configuration>& configurations) override;
+  InstanceCacheStats getInstanceCacheStats() override;
+  InstanceStats getStats() override;
+  std::string startTracing(const std::optional<std::string>& filePath) override;
+  void stopTracing() override;
+
+private:
+  /**
+   * Identifies an MMKV file - the same `id` in the same `path` (empty for the default root directory).
+   */
+  static std::string getFileKey(const std::string& id, const std::string& path);
+  /**
+   * Identifies an instance in the cache - its file, plus the encryption settings that have to match to be able to read it.
+   */
+  static std::string getCacheKey(const Configuration& configuration);
+  /**
+   * Returns the name of the first option in `requested` that differs from the one
+   * the cached instance was created with, or `nullptr` if they all match.
+   */
+  static const char* getMismatchedOption(const Configuration& cached, const Configuration& requested);
+
+private:
+  static constexpr auto DEFAULT_TRACE_FILE_NAME = "mmkv-trace.json";
+
+private:
+  struct CachedInstance {
+    std::weak_ptr<HybridMMKV> instance;
+    Configuration configuration;
+  };
+
+  // Runs the `*Async(...)` methods of all MMKV instances created by this factory
+  std::shared_ptr<MMKVThreadPool> threadPool = std::make_shared<MMKVThreadPool>(/* maxThreads */ 2);
+  // Opens instances in parallel in `preloadMMKV(...)`
+  std::shared_ptr<MMKVThreadPool> preloadThreadPool = std::make_shared<MMKVThreadPool>(std::thread::hardware_concurrency());
+  // All instances that are still alive, so repeated `createMMKV(...)` calls share one instance.
+  // Every JS runtime (e.g. worklet or background runtimes) creates its own factory, so this is
+  // process-wide - otherwise each runtime would get its own `HybridMMKV` for the same file.
+  static std::mutex instanceCacheMutex;
+  // Instances created with mismatching options (see `getMismatchedOption(...)`) share a cache key
+  static std::unordered_multimap<std::string, CachedInstance> instanceCache;
+  static size_t instanceCacheHits;
+  static size_t instanceCacheMisses;
 };
 
 } // namespace margelo::nitro::mmkv
@@ -0,0 +1,288 @@
+//
+//  MMKVBlobStore.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVBlobStore.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace margelo::nitro::mmkv {
+
+namespace {
+
+  constexpr const char* BLOB_EXTENSION = ".blob";
+  constexpr const char* TEMPORARY_EXTENSION = ".tmp";
+
+  constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+  constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+  constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+
+  inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  inline uint64_t mix(uint64_t hash, uint64_t word) {
+    hash ^= rotateLeft(word * PRIME_2, 31) * PRIME_1;
+    return rotateLeft(hash, 27) * PRIME_1 + PRIME_3;
+  }
+
+  inline uint64_t avalanche(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+  void appendHex(std::string& string, uint64_t value) {
+    constexpr const char* digits = "0123456789abcdef";
+    for (int shift = 60; shift >= 0; shift -= 4) {
+      string += digits[(value >> shift) & 0xF];
+    }
+  }
+
+  bool endsWith(const std::string& string, const char* suffix) {
+    size_t suffixLength = std::strlen(suffix);
+    return string.size() >= suffixLength && string.compare(string.size() - suffixLength, suffixLength, suffix) == 0;
+  }
+
+  std::runtime_error createError(const std::string& message, const std::string& path) {
+    return std::runtime_error(message + " (path: " + path + ", error: " + std::strerror(errno) + ")");
+  }
+
+} // namespace
+
+MMKVMappedBlob::MMKVMappedBlob(uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+MMKVMappedBlob::~MMKVMappedBlob() {
+  if (_data != nullptr) {
+    munmap(_data, _size);
+  }
+}
+
+MMKVBlobStore::MMKVBlobStore(std::string directory) : _directory(std::move(directory)) {}
+
+std::string MMKVBlobStore::getDirectory(const std::string& rootDirectory, const std::string& mmapID) {
+  std::string name;
+  bool wasSanitized = false;
+  for (char character : mmapID) {
+    bool isSafe = std::isalnum(static_cast<unsigned char>(character)) || character == '.' || character == '-' || character == '_';
+    name += isSafe ? character : '_';
+    wasSanitized |= !isSafe;
+  }
+  if (wasSanitized) {
+    // Keep IDs that only differ in unsafe characters apart
+    name += '-';
+    name += getId(mmapID.data(), mmapID.size()).substr(0, 16);
+  }
+  std::string directory = rootDirectory;
+  if (!directory.empty() && directory.back() != '/') {
+    directory += '/';
+  }
+  return directory + name + ".blobs";
+}
+
+std::string MMKVBlobStore::getId(const void* data, size_t size) {
+  // Two independently seeded 64-bit hashes, so accidental collisions are practically impossible.
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  uint64_t first = PRIME_3 ^ (size * PRIME_1);
+  uint64_t second = PRIME_1 ^ (size * PRIME_3);
+  size_t offset = 0;
+  for (; offset + 8 <= size; offset += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes + offset, sizeof(word));
+    first = mix(first, word);
+    second = mix(second, word ^ PRIME_2);
+  }
+  uint64_t tail = 0;
+  if (offset < size) {
+    std::memcpy(&tail, bytes + offset, size - offset);
+  }
+  first = mix(first, tail);
+  second = mix(second, tail ^ PRIME_2);
+
+  std::string id;
+  id.reserve(ID_LENGTH);
+  appendHex(id, avalanche(first));
+  appendHex(id, avalanche(second));
+  return id;
+}
+
+std::string MMKVBlobStore::getPath(const std::string& id) const {
+  return _directory + "/" + id + BLOB_EXTENSION;
+}
+
+void MMKVBlobStore::createDirectoryIfNeeded() const {
+  if (mkdir(_directory.c_str(), 0700) != 0 && errno != EEXIST) [[unlikely]] {
+    throw createError("Failed to create blob directory!", _directory);
+  }
+}
+
+bool MMKVBlobStore::exists() const {
+  struct stat info;
+  return stat(_directory.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+}
+
+std::string MMKVBlobStore::write(const void* data, size_t size) {
+  std::string id = getId(data, size);
+  std::string path = getPath(id);
+
+  if (hasContent(id, data, size)) {
+    // Already stored - mark it as used, so it is not removed before the new reference is written.
+    utimes(path.c_str(), nullptr);
+    return id;
+  }
+
+  createDirectoryIfNeeded();
+  // Write to a temporary file first, so a blob file is either complete or does not exist.
+  static std::atomic<uint64_t> temporaryCounter = 0;
+  std::string temporaryPath = path + "." + std::to_string(getpid()) + "-" + std::to_string(temporaryCounter++) + TEMPORARY_EXTENSION;
+  int fd = open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+  if (fd < 0) [[unlikely]] {
+    throw createError("Failed to create blob!", temporaryPath);
+  }
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  size_t written = 0;
+  while (written < size) {
+    ssize_t result = ::write(fd, bytes + written, size - written);
+    if (result < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      auto error = createError("Failed to write blob!", temporaryPath);
+      close(fd);
+      unlink(temporaryPath.c_str());
+      throw error;
+    }
+    written += static_cast<size_t>(result);
+  }
+  // The reference in MMKV must never point to a blob that is not on disk yet.
+  if (fsync(fd) != 0) [[unlikely]] {
+    auto error = createError("Failed to sync blob!", temporaryPath);
+    close(fd);
+    unlink(temporaryPath.c_str());
+    throw error;
+  }
+  close(fd);
+
+  if (rename(temporaryPath.c_str(), path.c_str()) != 0) [[unlikely]] {
+    auto error = createError("Failed to store blob!", path);
+    unlink(temporaryPath.c_str());
+    throw error;
+  }
+  return id;
+}
+
+bool MMKVBlobStore::hasContent(const std::string& id, const void* data, size_t size) const {
+  struct stat info;
+  if (stat(getPath(id).c_str(), &info) != 0 || static_cast<size_t>(info.st_size) != size) {
+    return false;
+  }
+  // A blob with the same hash and size is almost certainly the same - unless its file was damaged.
+  // Comparing is still a lot cheaper than writing and syncing it again.
+  try {
+    auto blob = read(id);
+    return size == 0 || std::memcmp(blob->data(), data, size) == 0;
+  } catch (...) {
+    return false;
+  }
+}
+
+std::shared_ptr<MMKVMappedBlob> MMKVBlobStore::read(const std::string& id) const {
+  bool isValidId = id.size() == ID_LENGTH && std::all_of(id.begin(), id.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)); });
+  if (!isValidId) [[unlikely]] {
+    // A corrupted reference must never point outside of the blob directory
+    throw std::runtime_error("Invalid blob ID \"" + id + "\"!");
+  }
+  std::string path = getPath(id);
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) [[unlikely]] {
+    throw createError("Failed to open blob!", path);
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) [[unlikely]] {
+    auto error = createError("Failed to read blob!", path);
+    close(fd);
+    throw error;
+  }
+
+  auto size = static_cast<size_t>(info.st_size);
+  if (size == 0) {
+    close(fd);
+    return std::make_shared<MMKVMappedBlob>(nullptr, 0);
+  }
+  // Private, so writes to the memory never reach the file.
+  void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) [[unlikely]] {
+    throw createError("Failed to map blob!", path);
+  }
+  return std::make_shared<MMKVMappedBlob>(static_cast<uint8_t*>(data), size);
+}
+
+size_t MMKVBlobStore::removeUnreferenced(const std::unordered_set<std::string>& referencedIds, std::chrono::seconds gracePeriod) const {
+  DIR* directory = opendir(_directory.c_str());
+  if (directory == nullptr) {
+    // No blob was ever written
+    return 0;
+  }
+
+  auto now = std::chrono::system_clock::now();
+  size_t removedCount = 0;
+  while (dirent* entry = readdir(directory)) {
+    std::string name = entry->d_name;
+    bool isBlob = endsWith(name, BLOB_EXTENSION);
+    if (!isBlob && !endsWith(name, TEMPORARY_EXTENSION)) {
+      continue;
+    }
+    if (isBlob && referencedIds.contains(name.substr(0, name.size() - std::strlen(BLOB_EXTENSION)))) {
+      continue;
+    }
+
+    std::string path = _directory + "/" + name;
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+      continue;
+    }
+    auto modifiedAt = std::chrono::system_clock::from_time_t(info.st_mtime);
+    if (now - modifiedAt < gracePeriod) {
+      // Might still be about to be referenced (or written)
+      continue;
+    }
+    if (unlink(path.c_str()) == 0 && isBlob) {
+      removedCount++;
+    }
+  }
+  closedir(directory);
+  return removedCount;
+}
+
+void MMKVBlobStore::removeAll() const {
+  DIR* directory = opendir(_directory.c_str());
+  if (directory == nullptr) {
+    return;
+  }
+  while (dirent* entry = readdir(directory)) {
+    std::string name = entry->d_name;
+    if (name != "." && name != "..") {
+      unlink((_directory + "/" + name).c_str());
+    }
+  }
+  closedir(directory);
+  rmdir(_directory.c_str());
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,113 @@
+//
+//  MMKVBlobStore.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * A read-only view of a blob, memory-mapped from its file.
+ *
+ * The mapping is private, so the memory can be written to (e.g. by JS through an `ArrayBuffer`)
+ * without ever changing the file.
+ */
+class MMKVMappedBlob final {
+public:
+  MMKVMappedBlob(uint8_t* data, size_t size);
+  ~MMKVMappedBlob();
+
+  MMKVMappedBlob(const MMKVMappedBlob&) = delete;
+  MMKVMappedBlob& operator=(const MMKVMappedBlob&) = delete;
+
+public:
+  uint8_t* data() const {
+    return _data;
+  }
+  size_t size() const {
+    return _size;
+  }
+
+private:
+  uint8_t* _data;
+  size_t _size;
+};
+
+/**
+ * Stores large values in separate files next to an MMKV instance, so updating them does not rewrite
+ * (and grow) the whole MMKV file. Only a small reference to the blob is stored in MMKV itself.
+ *
+ * Blobs are content-addressed: their ID is a hash of their content, so writing the same value
+ * twice stores it only once, and a blob file never changes once it has been written.
+ * Blobs are not removed when their references are - call `removeUnreferenced(...)` from time to time.
+ */
+class MMKVBlobStore final {
+public:
+  /**
+   * The number of characters of a blob ID.
+   */
+  static constexpr size_t ID_LENGTH = 32;
+  /**
+   * Blobs that were written (or re-used) more recently than this are never removed by
+   * `removeUnreferenced(...)`, as the reference to them might just not be written yet.
+   */
+  static constexpr auto DEFAULT_GRACE_PERIOD = std::chrono::seconds(60);
+
+public:
+  explicit MMKVBlobStore(std::string directory);
+
+  /**
+   * Gets the directory of the blobs of the MMKV instance with the given ID in the given root directory.
+   */
+  static std::string getDirectory(const std::string& rootDirectory, const std::string& mmapID);
+  /**
+   * Computes the ID of a blob with the given content.
+   */
+  static std::string getId(const void* data, size_t size);
+
+public:
+  /**
+   * Durably writes the given data to a blob, and returns its ID.
+   * If a blob with the same content already exists, it is re-used - a damaged one is replaced.
+   */
+  std::string write(const void* data, size_t size);
+  /**
+   * Memory-maps the blob with the given ID, or throws if it does not exist.
+   */
+  std::shared_ptr<MMKVMappedBlob> read(const std::string& id) const;
+  /**
+   * Removes all blobs that are not in `referencedIds` and are older than `gracePeriod`,
+   * as well as leftovers of interrupted writes. Returns the number of removed blobs.
+   */
+  size_t removeUnreferenced(const std::unordered_set<std::string>& referencedIds,
+                            std::chrono::seconds gracePeriod = DEFAULT_GRACE_PERIOD) const;
+  /**
+   * Removes all blobs and the directory itself.
+   */
+  void removeAll() const;
+  /**
+   * Returns whether any blob has ever been written to this store.
+   */
+  bool exists() const;
+
+private:
+  std::string getPath(const std::string& id) const;
+  /**
+   * Returns whether the blob with the given ID exists and has exactly the given content.
+   */
+  bool hasContent(const std::string& id, const void* data, size_t size) const;
+  void createDirectoryIfNeeded() const;
+
+private:
+  std::string _directory;
+};
+
+} // namespace margelo::nitro::mmkv
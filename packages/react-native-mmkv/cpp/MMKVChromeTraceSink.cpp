@@ -0,0 +1,119 @@
+//
+//  MMKVChromeTraceSink.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVChromeTraceSink.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace margelo::nitro::mmkv {
+
+namespace {
+
+  // Small, stable IDs per thread read much better in trace viewers than hashed native thread IDs
+  uint64_t getCurrentThreadId() {
+    static std::atomic<uint64_t> nextThreadId = 1;
+    thread_local uint64_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+  }
+
+  void appendEscaped(std::string& output, std::string_view string) {
+    for (char c : string) {
+      switch (c) {
+        case '"':
+          output += "\\\"";
+          break;
+        case '\\':
+          output += "\\\\";
+          break;
+        default:
+          if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+            output += escaped;
+          } else {
+            output += c;
+          }
+          break;
+      }
+    }
+  }
+
+  double toMicroseconds(std::chrono::nanoseconds duration) {
+    return static_cast<double>(duration.count()) / 1000.0;
+  }
+
+} // namespace
+
+MMKVChromeTraceSink::MMKVChromeTraceSink(const std::string& filePath)
+    : _file(std::fopen(filePath.c_str(), "w")), _startTime(std::chrono::steady_clock::now()), _processId(static_cast<int>(getpid())) {
+  if (_file == nullptr) [[unlikely]] {
+    throw std::runtime_error("Failed to create trace file \"" + filePath + "\"! " + std::strerror(errno));
+  }
+  _buffer.reserve(FLUSH_THRESHOLD * 2);
+  _buffer += "[\n";
+}
+
+MMKVChromeTraceSink::~MMKVChromeTraceSink() {
+  close();
+}
+
+void MMKVChromeTraceSink::beginEvent(const MMKVTraceEvent&) {
+  // Events are written as one complete event once they ended
+}
+
+void MMKVChromeTraceSink::endEvent(const MMKVTraceEvent& event) {
+  char numbers[160];
+  std::snprintf(numbers, sizeof(numbers), R"(","ph":"X","ts":%.3f,"dur":%.3f,"pid":%d,"tid":%llu,"args":{"keySize":%zu,"valueSize":%zu,"instanceId":")",
+                toMicroseconds(event.start - _startTime), toMicroseconds(event.duration), _processId,
+                static_cast<unsigned long long>(getCurrentThreadId()), event.keySize, event.valueSize);
+
+  std::unique_lock lock(_mutex);
+  if (_file == nullptr) {
+    return;
+  }
+  if (!_isFirstEvent) {
+    _buffer += ",\n";
+  }
+  _isFirstEvent = false;
+  _buffer += R"({"cat":"mmkv","name":")";
+  _buffer += event.name;
+  _buffer += numbers;
+  appendEscaped(_buffer, event.instanceId);
+  _buffer += "\"}}";
+  if (_buffer.size() >= FLUSH_THRESHOLD) {
+    writeBuffer();
+  }
+}
+
+void MMKVChromeTraceSink::flush() {
+  std::unique_lock lock(_mutex);
+  if (_file == nullptr) {
+    return;
+  }
+  writeBuffer();
+  std::fflush(_file);
+}
+
+void MMKVChromeTraceSink::close() {
+  std::unique_lock lock(_mutex);
+  if (_file == nullptr) {
+    return;
+  }
+  _buffer += "\n]\n";
+  writeBuffer();
+  std::fclose(_file);
+  _file = nullptr;
+}
+
+void MMKVChromeTraceSink::writeBuffer() {
+  // A failed write only loses trace events, which must never make the traced operation fail
+  std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+  _buffer.clear();
+}
+
+} // namespace margelo::nitro::mmkv
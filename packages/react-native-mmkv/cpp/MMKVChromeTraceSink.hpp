@@ -0,0 +1,64 @@
+//
+//  MMKVChromeTraceSink.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKVTracer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * Writes all trace events to a file in the Chrome trace event format (a JSON array of complete events),
+ * which can be opened in Perfetto (https://ui.perfetto.dev) or `chrome://tracing`.
+ *
+ * Works on every platform. Events are buffered in memory and written in chunks, so writing them
+ * rarely blocks the traced operation. The file is only complete once the sink is closed or destroyed,
+ * but both viewers also open files of processes that were killed while tracing.
+ */
+class MMKVChromeTraceSink final : public MMKVTraceSink {
+public:
+  /**
+   * Creates (or overwrites) the trace file at the given path, or throws if that fails.
+   */
+  explicit MMKVChromeTraceSink(const std::string& filePath);
+  ~MMKVChromeTraceSink() override;
+
+  MMKVChromeTraceSink(const MMKVChromeTraceSink&) = delete;
+  MMKVChromeTraceSink& operator=(const MMKVChromeTraceSink&) = delete;
+
+public:
+  void beginEvent(const MMKVTraceEvent& event) override;
+  void endEvent(const MMKVTraceEvent& event) override;
+
+  /**
+   * Writes all buffered events to the file.
+   */
+  void flush();
+  /**
+   * Writes all buffered events and closes the file. Events that end afterwards are dropped.
+   */
+  void close();
+
+private:
+  void writeBuffer();
+
+private:
+  static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+
+private:
+  std::mutex _mutex;
+  std::FILE* _file;
+  std::string _buffer;
+  bool _isFirstEvent = true;
+  // Timestamps in the file are relative to this, so they stay small
+  std::chrono::steady_clock::time_point _startTime;
+  int _processId;
+};
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,68 @@
+//
+//  MMKVCoalescingListener.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVCoalescingListener.hpp"
+#include "MMKVTimerQueue.hpp"
+
+namespace margelo::nitro::mmkv {
+
+MMKVCoalescingListener::MMKVCoalescingListener(Callback&& callback, std::chrono::milliseconds flushInterval)
+    : _callback(std::move(callback)), _flushInterval(flushInterval) {}
+
+void MMKVCoalescingListener::onValueChanged(const std::string& key) {
+  onValuesChanged(std::span<const std::string>(&key, 1));
+}
+
+void MMKVCoalescingListener::onValuesChanged(std::span<const std::string> keys) {
+  bool needsFlush;
+  {
+    std::unique_lock lock(_mutex);
+    if (_isCancelled) {
+      return;
+    }
+    bool hadPendingKeys = !_pendingKeys.empty();
+    // 1. De-duplicate the keys, but keep the order in which keys first changed
+    for (const auto& key : keys) {
+      auto [_, inserted] = _pendingKeysSet.insert(key);
+      if (inserted) {
+        _pendingKeys.push_back(key);
+      }
+    }
+    // 2. Only the first pending keys schedule a flush - otherwise one is already scheduled
+    needsFlush = !hadPendingKeys && !_pendingKeys.empty();
+  }
+
+  if (needsFlush) {
+    std::weak_ptr<MMKVCoalescingListener> weakSelf = weak_from_this();
+    MMKVTimerQueue::shared().schedule(_flushInterval, [weakSelf]() {
+      if (auto self = weakSelf.lock()) {
+        self->flush();
+      }
+    });
+  }
+}
+
+void MMKVCoalescingListener::flush() {
+  std::vector<std::string> keys;
+  {
+    std::unique_lock lock(_mutex);
+    if (_isCancelled || _pendingKeys.empty()) {
+      return;
+    }
+    keys = std::move(_pendingKeys);
+    _pendingKeys.clear();
+    _pendingKeysSet.clear();
+  }
+  _callback(keys);
+}
+
+void MMKVCoalescingListener::cancel() {
+  std::unique_lock lock(_mutex);
+  _isCancelled = true;
+  _pendingKeys.clear();
+  _pendingKeysSet.clear();
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,64 @@
+//
+//  MMKVCoalescingListener.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * A value changed listener that collects changed keys instead of delivering
+ * them right away.
+ *
+ * Keys are de-duplicated, and delivered all at once as a single batch after the
+ * flush interval has passed since the first un-delivered change. The callback
+ * is called on the shared timer thread - if it is a JS function, Nitro schedules
+ * the call on the JS thread.
+ */
+class MMKVCoalescingListener final : public std::enable_shared_from_this<MMKVCoalescingListener> {
+public:
+  using Callback = std::function<void(const std::vector<std::string>& /* keys */)>;
+  // Roughly one frame at 60 FPS
+  static constexpr auto DEFAULT_FLUSH_INTERVAL = std::chrono::milliseconds(16);
+
+public:
+  MMKVCoalescingListener(Callback&& callback, std::chrono::milliseconds flushInterval);
+
+public:
+  /**
+   * Marks the given `key` as changed, and schedules a flush if none is pending yet.
+   */
+  void onValueChanged(const std::string& key);
+  /**
+   * Marks all given `keys` as changed at once, and schedules a flush if none is pending yet.
+   */
+  void onValuesChanged(std::span<const std::string> keys);
+  /**
+   * Delivers all pending keys to the callback right away.
+   */
+  void flush();
+  /**
+   * Drops all pending keys and stops delivering keys to the callback.
+   */
+  void cancel();
+
+private:
+  Callback _callback;
+  std::chrono::milliseconds _flushInterval;
+  std::mutex _mutex;
+  std::vector<std::string> _pendingKeys;
+  std::unordered_set<std::string> _pendingKeysSet;
+  bool _isCancelled = false;
+};
+
+} // namespace margelo::nitro::mmkv
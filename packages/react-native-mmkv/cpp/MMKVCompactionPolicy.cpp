@@ -0,0 +1,57 @@
+//
+//  MMKVCompactionPolicy.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVCompactionPolicy.hpp"
+#include <algorithm>
+
+namespace margelo::nitro::mmkv {
+
+namespace {
+
+  // Shorter compactions are mostly overhead, they would make the speed estimate way too optimistic.
+  constexpr auto MIN_MEASURABLE_DURATION = std::chrono::milliseconds(1);
+
+} // namespace
+
+MMKVCompactionPolicy::MMKVCompactionPolicy(std::optional<double> minLiveRatio, std::chrono::microseconds maxPause)
+    : _minLiveRatio(minLiveRatio), _maxPause(maxPause) {}
+
+bool MMKVCompactionPolicy::isFragmented(size_t liveSize, size_t fileSize) const {
+  if (!_minLiveRatio.has_value() || fileSize < MIN_FILE_SIZE) {
+    return false;
+  }
+  return static_cast<double>(liveSize) < static_cast<double>(fileSize) * _minLiveRatio.value();
+}
+
+bool MMKVCompactionPolicy::isWithinMaxPause(size_t liveSize) const {
+  return estimateDuration(liveSize) <= _maxPause;
+}
+
+std::chrono::microseconds MMKVCompactionPolicy::estimateDuration(size_t liveSize) const {
+  std::unique_lock lock(_mutex);
+  return std::chrono::microseconds(static_cast<int64_t>(static_cast<double>(liveSize) / _bytesPerMicrosecond));
+}
+
+void MMKVCompactionPolicy::didCompact(size_t fileSizeBefore, size_t fileSizeAfter, size_t liveSize, std::chrono::microseconds duration) {
+  std::unique_lock lock(_mutex);
+  _stats.compactionCount++;
+  _stats.bytesReclaimed += fileSizeBefore > fileSizeAfter ? fileSizeBefore - fileSizeAfter : 0;
+  _stats.totalDuration += duration;
+  _stats.lastDuration = duration;
+  _stats.maxDuration = std::max(_stats.maxDuration, duration);
+
+  if (duration >= MIN_MEASURABLE_DURATION && liveSize > 0) {
+    // Moving average, so a single slow compaction (e.g. while the device was busy) does not dominate
+    double bytesPerMicrosecond = static_cast<double>(liveSize) / static_cast<double>(duration.count());
+    _bytesPerMicrosecond = (_bytesPerMicrosecond + bytesPerMicrosecond) / 2;
+  }
+}
+
+MMKVCompactionPolicy::Stats MMKVCompactionPolicy::getStats() const {
+  std::unique_lock lock(_mutex);
+  return _stats;
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,92 @@
+//
+//  MMKVCompactionPolicy.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * Decides when an MMKV file is worth compacting, and keeps statistics about past compactions.
+ *
+ * MMKV appends every write to its file, so overwritten and removed values keep taking up space
+ * until the file is compacted (rewritten with only the live values). Compacting holds the
+ * instance's lock for as long as it takes to rewrite the live values, so this also estimates
+ * that duration from previous compactions, to never automatically compact an instance that
+ * would block readers and writers for too long.
+ */
+class MMKVCompactionPolicy final {
+public:
+  struct Stats {
+    size_t compactionCount = 0;
+    size_t bytesReclaimed = 0;
+    std::chrono::microseconds totalDuration{0};
+    std::chrono::microseconds lastDuration{0};
+    std::chrono::microseconds maxDuration{0};
+  };
+
+  /**
+   * Smaller files are never compacted automatically, as there is not much to gain.
+   */
+  static constexpr size_t MIN_FILE_SIZE = 256 * 1024;
+  /**
+   * The assumed compaction speed until the first compaction was measured.
+   * This is on the slow side for current devices, so the first estimates rather skip a compaction.
+   */
+  static constexpr double DEFAULT_BYTES_PER_MICROSECOND = 256.0;
+
+public:
+  /**
+   * Creates a policy that compacts automatically once less than `minLiveRatio` of the file holds live data,
+   * but only if that is expected to take at most `maxPause`.
+   * Without a `minLiveRatio`, the policy never compacts automatically and only keeps statistics.
+   */
+  MMKVCompactionPolicy(std::optional<double> minLiveRatio, std::chrono::microseconds maxPause);
+
+  MMKVCompactionPolicy(const MMKVCompactionPolicy&) = delete;
+  MMKVCompactionPolicy& operator=(const MMKVCompactionPolicy&) = delete;
+
+public:
+  /**
+   * Whether the instance should be compacted automatically at all.
+   */
+  bool isAutomatic() const {
+    return _minLiveRatio.has_value();
+  }
+  /**
+   * Whether a file of `fileSize` bytes of which only `liveSize` bytes are live is fragmented enough to be compacted.
+   */
+  bool isFragmented(size_t liveSize, size_t fileSize) const;
+  /**
+   * Whether compacting `liveSize` bytes of live data is expected to finish within the maximum pause.
+   */
+  bool isWithinMaxPause(size_t liveSize) const;
+  /**
+   * Estimates how long compacting `liveSize` bytes of live data takes, based on previous compactions.
+   */
+  std::chrono::microseconds estimateDuration(size_t liveSize) const;
+
+public:
+  /**
+   * Records a compaction that shrunk the file from `fileSizeBefore` to `fileSizeAfter` bytes
+   * and rewrote `liveSize` bytes in `duration`.
+   */
+  void didCompact(size_t fileSizeBefore, size_t fileSizeAfter, size_t liveSize, std::chrono::microseconds duration);
+  Stats getStats() const;
+
+private:
+  std::optional<double> _minLiveRatio;
+  std::chrono::microseconds _maxPause;
+
+  mutable std::mutex _mutex;
+  double _bytesPerMicrosecond = DEFAULT_BYTES_PER_MICROSECOND;
+  Stats _stats;
+};
+
+} // namespace margelo::nitro::mmkv
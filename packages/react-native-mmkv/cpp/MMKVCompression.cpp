@@ -0,0 +1,335 @@
+//
+//  MMKVCompression.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVCompression.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace margelo::nitro::mmkv {
+
+namespace {
+
+  // Starts with a NUL byte, so no text value can ever start with it by accident.
+  constexpr std::array<uint8_t, 4> MAGIC = {0x00, 0xC5, 'M', 'Z'};
+
+  // Constants of the LZ4 block format
+  constexpr size_t MIN_MATCH = 4;
+  // The last 5 bytes are always literals
+  constexpr size_t LAST_LITERALS = 5;
+  // The last match must start at least 12 bytes before the end
+  constexpr size_t MF_LIMIT = 12;
+  constexpr size_t MAX_OFFSET = 65535;
+  constexpr int HASH_LOG = 12;
+  // After this many misses in a row, skip ahead faster - incompressible data is then not searched byte by byte
+  constexpr int SKIP_TRIGGER = 6;
+
+  inline uint32_t read32(const uint8_t* pointer) {
+    uint32_t value;
+    std::memcpy(&value, pointer, sizeof(value));
+    return value;
+  }
+
+  inline uint64_t read64(const uint8_t* pointer) {
+    uint64_t value;
+    std::memcpy(&value, pointer, sizeof(value));
+    return value;
+  }
+
+  inline uint32_t hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - HASH_LOG);
+  }
+
+  inline void writeLength(uint8_t*& output, size_t length) {
+    length -= 15;
+    while (length >= 255) {
+      *output++ = 255;
+      length -= 255;
+    }
+    *output++ = static_cast<uint8_t>(length);
+  }
+
+  inline bool readLength(const uint8_t*& input, const uint8_t* inputEnd, size_t& length) {
+    uint8_t byte;
+    do {
+      if (input >= inputEnd) [[unlikely]] {
+        return false;
+      }
+      byte = *input++;
+      length += byte;
+    } while (byte == 255);
+    return true;
+  }
+
+  // Worst case size of a sequence with the given lengths
+  inline size_t getMaxSequenceSize(size_t literalLength, size_t matchLength) {
+    return 1 + (literalLength / 255 + 1) + literalLength + 2 + (matchLength / 255 + 1);
+  }
+
+  void writeHeader(uint8_t* output, MMKVCompression::Codec codec, uint32_t decodedSize) {
+    std::memcpy(output, MAGIC.data(), MAGIC.size());
+    output[4] = static_cast<uint8_t>(codec);
+    for (size_t i = 0; i < 4; i++) {
+      output[5 + i] = static_cast<uint8_t>(decodedSize >> (i * 8));
+    }
+  }
+
+} // namespace
+
+std::optional<std::string> MMKVCompression::encode(const void* data, size_t size, Codec codec, size_t threshold) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  bool needsHeader = isEncoded(data, size);
+  bool shouldCompress = codec != Codec::NONE && size >= threshold && size <= std::numeric_limits<uint32_t>::max();
+  if (!needsHeader && !shouldCompress) [[likely]] {
+    return std::nullopt;
+  }
+
+  if (shouldCompress) {
+    std::string encoded;
+    encoded.resize(HEADER_SIZE + getMaxCompressedSize(size));
+    auto* output = reinterpret_cast<uint8_t*>(encoded.data());
+    // Only keep it if it saves something - otherwise every read would pay for decompressing it.
+    size_t compressedSize = compressLZ4(bytes, size, output + HEADER_SIZE, size - std::min(size, HEADER_SIZE + 1));
+    if (compressedSize > 0) {
+      writeHeader(output, Codec::LZ4, static_cast<uint32_t>(size));
+      encoded.resize(HEADER_SIZE + compressedSize);
+      return encoded;
+    }
+  }
+
+  if (!needsHeader) {
+    return std::nullopt;
+  }
+  // The plain value happens to start with our magic - keep it behind a header so it is not mistaken for an encoded one.
+  std::string encoded;
+  encoded.resize(HEADER_SIZE + size);
+  auto* output = reinterpret_cast<uint8_t*>(encoded.data());
+  writeHeader(output, Codec::NONE, static_cast<uint32_t>(size));
+  std::memcpy(output + HEADER_SIZE, bytes, size);
+  return encoded;
+}
+
+bool MMKVCompression::isEncoded(const void* data, size_t size) {
+  return size >= HEADER_SIZE && std::memcmp(data, MAGIC.data(), MAGIC.size()) == 0;
+}
+
+MMKVCompression::Codec MMKVCompression::getCodec(const void* data, size_t size) {
+  if (!isEncoded(data, size)) [[unlikely]] {
+    throw std::runtime_error("Value is not encoded!");
+  }
+  return static_cast<Codec>(static_cast<const uint8_t*>(data)[4]);
+}
+
+size_t MMKVCompression::getDecodedSize(const void* data, size_t size) {
+  if (!isEncoded(data, size)) [[unlikely]] {
+    throw std::runtime_error("Value is not encoded!");
+  }
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  uint32_t decodedSize = 0;
+  for (size_t i = 0; i < 4; i++) {
+    decodedSize |= static_cast<uint32_t>(bytes[5 + i]) << (i * 8);
+  }
+  return decodedSize;
+}
+
+void MMKVCompression::decode(const void* data, size_t size, void* output) {
+  size_t decodedSize = getDecodedSize(data, size);
+  const auto* payload = static_cast<const uint8_t*>(data) + HEADER_SIZE;
+  size_t payloadSize = size - HEADER_SIZE;
+
+  switch (static_cast<Codec>(static_cast<const uint8_t*>(data)[4])) {
+    case Codec::NONE:
+      if (payloadSize != decodedSize) [[unlikely]] {
+        throw std::runtime_error("Stored value is corrupted!");
+      }
+      std::memcpy(output, payload, payloadSize);
+      return;
+    case Codec::LZ4:
+      if (!decompressLZ4(payload, payloadSize, static_cast<uint8_t*>(output), decodedSize)) [[unlikely]] {
+        throw std::runtime_error("Compressed value is corrupted!");
+      }
+      return;
+    case Codec::EXTERNAL:
+      throw std::runtime_error("Value is stored in an external blob, it needs to be read from there!");
+  }
+  throw std::runtime_error("Value is compressed with an unknown codec!");
+}
+
+std::string MMKVCompression::decodeToString(const void* data, size_t size) {
+  std::string result;
+  result.resize(getDecodedSize(data, size));
+  decode(data, size, result.data());
+  return result;
+}
+
+std::string MMKVCompression::encodeExternal(const std::string& blobId, size_t decodedSize) {
+  if (decodedSize > std::numeric_limits<uint32_t>::max()) [[unlikely]] {
+    throw std::runtime_error("Value is too large to be stored! (" + std::to_string(decodedSize) + " bytes)");
+  }
+  std::string encoded;
+  encoded.resize(HEADER_SIZE + blobId.size());
+  writeHeader(reinterpret_cast<uint8_t*>(encoded.data()), Codec::EXTERNAL, static_cast<uint32_t>(decodedSize));
+  std::memcpy(encoded.data() + HEADER_SIZE, blobId.data(), blobId.size());
+  return encoded;
+}
+
+std::string MMKVCompression::getExternalId(const void* data, size_t size) {
+  if (getCodec(data, size) != Codec::EXTERNAL) [[unlikely]] {
+    throw std::runtime_error("Value is not stored in an external blob!");
+  }
+  return std::string(static_cast<const char*>(data) + HEADER_SIZE, size - HEADER_SIZE);
+}
+
+size_t MMKVCompression::getMaxCompressedSize(size_t size) {
+  return size + size / 255 + 16;
+}
+
+size_t MMKVCompression::compressLZ4(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationCapacity) {
+  const uint8_t* const sourceEnd = source + sourceSize;
+  const uint8_t* anchor = source;
+  uint8_t* output = destination;
+  uint8_t* const outputEnd = destination + destinationCapacity;
+
+  if (sourceSize > MF_LIMIT && sourceSize <= std::numeric_limits<uint32_t>::max()) {
+    // Positions of the last occurrence of each hashed 4-byte sequence
+    std::array<uint32_t, 1 << HASH_LOG> table{};
+    const uint8_t* const matchLimit = sourceEnd - LAST_LITERALS;
+    const uint8_t* const lastMatchStart = sourceEnd - MF_LIMIT;
+    const uint8_t* input = source + 1;
+    uint32_t misses = 1 << SKIP_TRIGGER;
+
+    while (input <= lastMatchStart) {
+      uint32_t sequence = read32(input);
+      uint32_t slot = hash(sequence);
+      const uint8_t* match = source + table[slot];
+      table[slot] = static_cast<uint32_t>(input - source);
+      if (match >= input || static_cast<size_t>(input - match) > MAX_OFFSET || read32(match) != sequence) {
+        input += misses++ >> SKIP_TRIGGER;
+        continue;
+      }
+      misses = 1 << SKIP_TRIGGER;
+
+      // Extend the match backwards into the pending literals...
+      while (input > anchor && match > source && input[-1] == match[-1]) {
+        input--;
+        match--;
+      }
+      // ...and forwards, 8 bytes at a time
+      const uint8_t* matchEnd = input + MIN_MATCH;
+      const uint8_t* reference = match + MIN_MATCH;
+      while (matchEnd + 8 <= matchLimit && read64(matchEnd) == read64(reference)) {
+        matchEnd += 8;
+        reference += 8;
+      }
+      while (matchEnd < matchLimit && *matchEnd == *reference) {
+        matchEnd++;
+        reference++;
+      }
+
+      size_t literalLength = static_cast<size_t>(input - anchor);
+      size_t matchLength = static_cast<size_t>(matchEnd - input) - MIN_MATCH;
+      if (getMaxSequenceSize(literalLength, matchLength) > static_cast<size_t>(outputEnd - output)) {
+        return 0;
+      }
+
+      uint8_t* token = output++;
+      *token = static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchLength, 15));
+      if (literalLength >= 15) {
+        writeLength(output, literalLength);
+      }
+      std::memcpy(output, anchor, literalLength);
+      output += literalLength;
+      size_t offset = static_cast<size_t>(input - match);
+      *output++ = static_cast<uint8_t>(offset);
+      *output++ = static_cast<uint8_t>(offset >> 8);
+      if (matchLength >= 15) {
+        writeLength(output, matchLength);
+      }
+
+      input = matchEnd;
+      anchor = input;
+      if (input <= lastMatchStart) {
+        // Remember a position inside the match too, so repetitive data finds the next match quicker
+        table[hash(read32(input - 2))] = static_cast<uint32_t>(input - 2 - source);
+      }
+    }
+  }
+
+  // The rest are literals
+  size_t literalLength = static_cast<size_t>(sourceEnd - anchor);
+  if (1 + (literalLength / 255 + 1) + literalLength > static_cast<size_t>(outputEnd - output)) {
+    return 0;
+  }
+  uint8_t* token = output++;
+  *token = static_cast<uint8_t>(std::min<size_t>(literalLength, 15) << 4);
+  if (literalLength >= 15) {
+    writeLength(output, literalLength);
+  }
+  std::memcpy(output, anchor, literalLength);
+  output += literalLength;
+  return static_cast<size_t>(output - destination);
+}
+
+bool MMKVCompression::decompressLZ4(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize) {
+  const uint8_t* input = source;
+  const uint8_t* const inputEnd = source + sourceSize;
+  uint8_t* output = destination;
+  uint8_t* const outputEnd = destination + destinationSize;
+
+  while (input < inputEnd) {
+    uint8_t token = *input++;
+
+    size_t literalLength = token >> 4;
+    if (literalLength == 15 && !readLength(input, inputEnd, literalLength)) [[unlikely]] {
+      return false;
+    }
+    if (literalLength > static_cast<size_t>(inputEnd - input) || literalLength > static_cast<size_t>(outputEnd - output)) [[unlikely]] {
+      return false;
+    }
+    std::memcpy(output, input, literalLength);
+    input += literalLength;
+    output += literalLength;
+    if (input == inputEnd) {
+      // The last sequence has no match
+      break;
+    }
+
+    if (inputEnd - input < 2) [[unlikely]] {
+      return false;
+    }
+    size_t offset = static_cast<size_t>(input[0]) | (static_cast<size_t>(input[1]) << 8);
+    input += 2;
+    if (offset == 0 || offset > static_cast<size_t>(output - destination)) [[unlikely]] {
+      return false;
+    }
+    size_t matchLength = token & 15;
+    if (matchLength == 15 && !readLength(input, inputEnd, matchLength)) [[unlikely]] {
+      return false;
+    }
+    matchLength += MIN_MATCH;
+    if (matchLength > static_cast<size_t>(outputEnd - output)) [[unlikely]] {
+      return false;
+    }
+
+    const uint8_t* match = output - offset;
+    if (offset >= matchLength) {
+      std::memcpy(output, match, matchLength);
+    } else {
+      // The match overlaps with its own output (a repeating pattern) - copy whole periods, doubling each time.
+      size_t copied = 0;
+      while (copied < matchLength) {
+        size_t chunk = std::min(matchLength - copied, copied + offset);
+        std::memcpy(output + copied, match, chunk);
+        copied += chunk;
+      }
+    }
+    output += matchLength;
+  }
+  return output == outputEnd;
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,92 @@
+//
+//  MMKVCompression.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * Encodes values for storage, optionally compressing them.
+ *
+ * Encoded values start with a small header (a magic, the codec and the decoded size), so encoded
+ * and plain values can live side by side in one instance, and reading never needs to know whether
+ * compression was enabled when a value was written.
+ * Only instances that use compression or blobs check for the header at all - values written by anything
+ * else (e.g. MMKV's native SDKs) are always read as-is, even if they happen to start with the magic.
+ *
+ * Values are compressed in the LZ4 block format, which favours speed over ratio.
+ * Values that are stored outside of MMKV (see `MMKVBlobStore`) are encoded as a reference to their blob.
+ */
+class MMKVCompression final {
+public:
+  enum class Codec : uint8_t {
+    // The value is stored as-is, only behind the header.
+    NONE = 0,
+    LZ4 = 1,
+    // The value is stored in an external blob, the payload is the blob's ID.
+    EXTERNAL = 2,
+  };
+
+  static constexpr size_t HEADER_SIZE = 9;
+
+public:
+  /**
+   * Encodes the given value for storage.
+   * It is compressed with `codec` if it is at least `threshold` bytes and actually gets smaller.
+   * Returns `std::nullopt` if the value can be stored as-is, which is the case for almost all values.
+   */
+  static std::optional<std::string> encode(const void* data, size_t size, Codec codec, size_t threshold);
+  /**
+   * Returns whether the given stored value was encoded by `encode(...)` and needs to be decoded.
+   */
+  static bool isEncoded(const void* data, size_t size);
+  /**
+   * Returns the codec of the given encoded value.
+   */
+  static Codec getCodec(const void* data, size_t size);
+  /**
+   * Returns the size of the given encoded value once it is decoded.
+   */
+  static size_t getDecodedSize(const void* data, size_t size);
+  /**
+   * Decodes the given encoded value into `output`, which must be `getDecodedSize(...)` bytes large.
+   * Throws if the value is corrupted.
+   */
+  static void decode(const void* data, size_t size, void* output);
+  static std::string decodeToString(const void* data, size_t size);
+
+public:
+  /**
+   * Encodes a reference to the external blob with the given ID, which holds a value that decodes to `decodedSize` bytes.
+   */
+  static std::string encodeExternal(const std::string& blobId, size_t decodedSize);
+  /**
+   * Returns the blob ID of the given encoded value, which must be `EXTERNAL`.
+   */
+  static std::string getExternalId(const void* data, size_t size);
+
+public:
+  /**
+   * The largest possible size of `size` bytes compressed with LZ4.
+   */
+  static size_t getMaxCompressedSize(size_t size);
+  /**
+   * Compresses `source` into `destination` in the LZ4 block format.
+   * Returns the compressed size, or `0` if it does not fit into `destinationCapacity`.
+   */
+  static size_t compressLZ4(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationCapacity);
+  /**
+   * Decompresses an LZ4 block from `source` into `destination`, which must be exactly the decompressed size.
+   * Returns `false` if the block is malformed. Never reads or writes out of bounds.
+   */
+  static bool decompressLZ4(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize);
+};
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,301 @@
+//
+//  MMKVContentChangeObserver.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVContentChangeObserver.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace margelo::nitro::mmkv {
+
+std::mutex MMKVContentChangeObserver::_observersMutex;
+std::unordered_map<std::string, MMKVContentChangeObserver*> MMKVContentChangeObserver::_observers;
+
+// Whether the current thread is notifying listeners about changes from other processes
+static thread_local bool isNotifyingRemoteChanges = false;
+
+MMKVContentChangeObserver::MMKVContentChangeObserver(MMKV* instance) : _instance(instance), _mmkvID(instance->mmapID()) {}
+
+MMKVContentChangeObserver::~MMKVContentChangeObserver() {
+  {
+    std::unique_lock lock(_observersMutex);
+    auto entry = _observers.find(_mmkvID);
+    if (entry != _observers.end() && entry->second == this) {
+      _observers.erase(entry);
+    }
+  }
+  // Stop the watcher thread before anything else is torn down.
+  _fileWatcher = nullptr;
+  MMKVValueChangedListenerRegistry::removeListener(_mmkvID, _localListenerID);
+}
+
+std::shared_ptr<MMKVContentChangeObserver> MMKVContentChangeObserver::getOrCreate(MMKV* instance, const std::string& directory) {
+  static std::once_flag registerHandlerFlag;
+  std::call_once(registerHandlerFlag, []() {
+    // MMKV only supports a single, global content change handler.
+    MMKV::registerContentChangeHandler(&MMKVContentChangeObserver::onContentChanged);
+  });
+
+  {
+    std::unique_lock lock(_observersMutex);
+    auto entry = _observers.find(instance->mmapID());
+    if (entry != _observers.end()) {
+      if (auto existing = entry->second->weak_from_this().lock()) {
+        return existing;
+      }
+    }
+  }
+
+  // Creating the observer takes the MMKV lock, and MMKV calls onContentChanged(..) while holding it -
+  // so this must happen outside of `_observersMutex` to not deadlock.
+  auto observer = std::make_shared<MMKVContentChangeObserver>(instance);
+  observer->start(directory);
+
+  std::unique_lock lock(_observersMutex);
+  auto& entry = _observers[instance->mmapID()];
+  if (entry != nullptr) {
+    if (auto existing = entry->weak_from_this().lock()) {
+      // Someone else was faster
+      return existing;
+    }
+  }
+  entry = observer.get();
+  return observer;
+}
+
+void MMKVContentChangeObserver::start(const std::string& directory) {
+  // Changes made by this process are already notified by HybridMMKV - we only need to keep our fingerprints up-to-date.
+  std::weak_ptr<MMKVContentChangeObserver> weakSelf = weak_from_this();
+  _localListenerID = MMKVValueChangedListenerRegistry::addListener(_mmkvID, [weakSelf](const std::string& key) {
+    if (isNotifyingRemoteChanges) {
+      // Fingerprints for these keys were just updated by checkForChanges()
+      return;
+    }
+    if (auto self = weakSelf.lock()) {
+      self->onLocalValueChanged(key);
+    }
+  });
+
+  // The watcher thread calls checkForChanges() right away - holding the lock makes it wait until `_fileWatcher` is set.
+  std::unique_lock lock(_mutex);
+  _fileWatcher = std::make_unique<MMKVFileWatcher>(directory, MMKVFileWatcher::DEFAULT_POLL_INTERVAL, [this]() { checkForChanges(); });
+  // Fingerprinting all values can take a while, so it happens on the watcher thread too
+  _fileWatcher->wake();
+}
+
+void MMKVContentChangeObserver::resume() {
+  std::unique_lock lock(_mutex);
+  if (_fileWatcher != nullptr) {
+    _fileWatcher->resume();
+  }
+}
+
+void MMKVContentChangeObserver::stop() {
+  {
+    // MMKV must not wake us anymore, and the next getOrCreate(..) must not return us
+    std::unique_lock lock(_observersMutex);
+    auto entry = _observers.find(_mmkvID);
+    if (entry != _observers.end() && entry->second == this) {
+      _observers.erase(entry);
+    }
+  }
+  std::unique_ptr<MMKVFileWatcher> fileWatcher;
+  {
+    std::unique_lock lock(_mutex);
+    fileWatcher = std::move(_fileWatcher);
+  }
+  // Joins the watcher thread - it must not hold `_mutex` while it finishes the check it might be in
+  fileWatcher = nullptr;
+}
+
+void MMKVContentChangeObserver::onContentChanged(const std::string& mmkvID) {
+  // This is called by MMKV while it holds the instance's lock, on whichever thread noticed the change.
+  // Don't do any work here - just mark the observer as dirty and let its watcher thread diff the values.
+  std::unique_lock lock(_observersMutex);
+  auto entry = _observers.find(mmkvID);
+  if (entry == _observers.end()) {
+    return;
+  }
+  MMKVContentChangeObserver* observer = entry->second;
+  observer->_hasContentChanged = true;
+  // `_mutex` is never held while calling into MMKV, so this cannot deadlock with MMKV's lock
+  std::unique_lock observerLock(observer->_mutex);
+  if (observer->_fileWatcher != nullptr) {
+    observer->_fileWatcher->wake();
+  }
+}
+
+bool MMKVContentChangeObserver::pauseIfUnobserved() {
+  // Our own listener only keeps the fingerprints up-to-date, it does not count.
+  if (MMKVValueChangedListenerRegistry::getListenerCount(_mmkvID) > 1) {
+    return false;
+  }
+  std::unique_lock lock(_mutex);
+  if (_fileWatcher == nullptr) [[unlikely]] {
+    // Stopped
+    return true;
+  }
+  _fileWatcher->pause();
+  if (MMKVValueChangedListenerRegistry::getListenerCount(_mmkvID) > 1) [[unlikely]] {
+    // A listener was added in the meantime
+    _fileWatcher->resume();
+    return false;
+  }
+  // Nobody would be notified about changes until we resume - so there is nothing to diff against either.
+  _fingerprints.clear();
+  _dirtyKeys.clear();
+  _hasFingerprints = false;
+  _valueBuffer.clear();
+  _valueBuffer.shrink_to_fit();
+  return true;
+}
+
+void MMKVContentChangeObserver::checkForChanges() {
+  if (pauseIfUnobserved()) {
+    return;
+  }
+
+  // 1. Let MMKV compare its meta file (sequence + CRC) - if another process changed it, this calls onContentChanged(..)
+  _instance->checkContentChanged();
+  bool hasContentChanged = _hasContentChanged.exchange(false);
+  bool hasFingerprints;
+  {
+    std::unique_lock lock(_mutex);
+    hasFingerprints = _hasFingerprints;
+  }
+  if (!hasFingerprints) {
+    // First check (or the first one after being paused) - there is nothing to diff against yet.
+    auto fingerprints = fingerprintAllValues();
+    std::unique_lock lock(_mutex);
+    _fingerprints = std::move(fingerprints);
+    _dirtyKeys.clear();
+    _hasFingerprints = true;
+    return;
+  }
+  if (!hasContentChanged) {
+    updateDirtyFingerprints();
+    return;
+  }
+
+  // 2. Find out which keys actually changed. Keys written by this process since the last check
+  //    cannot be told apart from changes of the other process anymore, so they count as changed too.
+  //    Each value is only locked while it is read - if the other process writes again meanwhile, MMKV
+  //    calls onContentChanged(..) again and the next check diffs once more.
+  std::unordered_set<std::string> dirtyKeys;
+  {
+    std::unique_lock lock(_mutex);
+    dirtyKeys.swap(_dirtyKeys);
+  }
+  auto fingerprints = fingerprintAllValues();
+  std::vector<std::string> changedKeys;
+  {
+    std::unique_lock lock(_mutex);
+    changedKeys = diffKeyFingerprints(_fingerprints, fingerprints);
+    _fingerprints = std::move(fingerprints);
+  }
+  if (!dirtyKeys.empty()) {
+    changedKeys.insert(changedKeys.end(), dirtyKeys.begin(), dirtyKeys.end());
+    std::sort(changedKeys.begin(), changedKeys.end());
+    changedKeys.erase(std::unique(changedKeys.begin(), changedKeys.end()), changedKeys.end());
+  }
+
+  // 3. Notify all listeners in this process
+  if (!changedKeys.empty()) {
+    isNotifyingRemoteChanges = true;
+    try {
+      MMKVValueChangedListenerRegistry::notifyOnValuesChanged(_mmkvID, changedKeys);
+    } catch (...) {
+      isNotifyingRemoteChanges = false;
+      throw;
+    }
+    isNotifyingRemoteChanges = false;
+  }
+}
+
+void MMKVContentChangeObserver::updateDirtyFingerprints() {
+  std::unordered_set<std::string> dirtyKeys;
+  {
+    std::unique_lock lock(_mutex);
+    dirtyKeys.swap(_dirtyKeys);
+  }
+  if (dirtyKeys.empty()) {
+    return;
+  }
+
+  MMKVKeyFingerprints fingerprints;
+  for (const auto& key : dirtyKeys) {
+    if (_instance->containsKey(key)) {
+      fingerprints.emplace(key, fingerprintValue(key));
+    }
+  }
+
+  std::unique_lock lock(_mutex);
+  if (_hasContentChanged) {
+    // Another process changed the file while we read these values - let the next check diff them with everything else.
+    _dirtyKeys.merge(dirtyKeys);
+    return;
+  }
+  for (const auto& key : dirtyKeys) {
+    auto fingerprint = fingerprints.find(key);
+    if (fingerprint != fingerprints.end()) {
+      _fingerprints[key] = fingerprint->second;
+    } else {
+      // Key was removed
+      _fingerprints.erase(key);
+    }
+  }
+}
+
+void MMKVContentChangeObserver::onLocalValueChanged(const std::string& key) {
+  // This is called on every write, so it only remembers the key - the watcher thread fingerprints it later.
+  std::unique_lock lock(_mutex);
+  if (_hasFingerprints) {
+    _dirtyKeys.insert(key);
+  }
+}
+
+MMKVKeyFingerprints MMKVContentChangeObserver::fingerprintAllValues() {
+  MMKVKeyFingerprints fingerprints;
+  for (const auto& key : _instance->allKeys()) {
+    fingerprints.emplace(key, fingerprintValue(key));
+  }
+  return fingerprints;
+}
+
+size_t MMKVContentChangeObserver::fingerprintValue(const std::string& key) {
+  // MMKV does not expose raw values, so we reconstruct them from the typed getters.
+  // Values are either length-delimited (strings, buffers), a fixed 8 byte double, or a varint (booleans, integers).
+  size_t rawSize = _instance->getValueSize(key, /* actualSize */ false);
+  size_t actualSize = _instance->getValueSize(key, /* actualSize */ true);
+  size_t fingerprint = std::hash<size_t>()(rawSize);
+
+  if (actualSize != rawSize) {
+    // Length-delimited value - the length prefix is implied by the sizes, so hashing the payload is enough.
+    if (actualSize > static_cast<size_t>(std::numeric_limits<int32_t>::max())) [[unlikely]] {
+      // Too large for writeValueToBuffer(..)
+      MMBuffer value = _instance->getBytes(key);
+      std::string_view payload(static_cast<const char*>(value.getPtr()), value.length());
+      combineFingerprint(fingerprint, std::hash<std::string_view>()(payload));
+      return fingerprint;
+    }
+    // MMKV only copies values out, so re-use one buffer instead of allocating one per value.
+    _valueBuffer.resize(actualSize);
+    if (actualSize > 0) {
+      _instance->writeValueToBuffer(key, _valueBuffer.data(), static_cast<int32_t>(actualSize));
+    }
+    combineFingerprint(fingerprint, std::hash<std::string_view>()(_valueBuffer));
+  } else if (rawSize == sizeof(double)) {
+    double value = _instance->getDouble(key);
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    combineFingerprint(fingerprint, std::hash<uint64_t>()(bits));
+  } else {
+    combineFingerprint(fingerprint, std::hash<int64_t>()(_instance->getInt64(key)));
+  }
+  return fingerprint;
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,98 @@
+//
+//  MMKVContentChangeObserver.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKVFileWatcher.hpp"
+#include "MMKVKeyFingerprints.hpp"
+#include "MMKVTypes.hpp"
+#include "MMKVValueChangedListenerRegistry.hpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * Observes a multi-process MMKV instance for changes made by other processes
+ * (e.g. app extensions or background services), and emits a value-changed event
+ * through the `MMKVValueChangedListenerRegistry` for every key that changed.
+ *
+ * 1. An `MMKVFileWatcher` periodically (and on file system events) asks MMKV to check its file.
+ * 2. MMKV compares the sequence and CRC digest in its meta file, and calls its content change handler if they differ.
+ * 3. MMKV does not tell us which keys changed, so the observer diffs a fingerprint of every value against the last known one.
+ *
+ * All fingerprinting happens on the watcher's thread: writes of this process only mark their key as dirty,
+ * and it is fingerprinted again on the next check. The watcher is paused while there are no listeners.
+ *
+ * There is one observer per MMKV instance, shared between all `HybridMMKV`s using it.
+ */
+class MMKVContentChangeObserver final : public std::enable_shared_from_this<MMKVContentChangeObserver> {
+public:
+  explicit MMKVContentChangeObserver(MMKV* instance);
+  ~MMKVContentChangeObserver();
+
+  MMKVContentChangeObserver(const MMKVContentChangeObserver&) = delete;
+  MMKVContentChangeObserver& operator=(const MMKVContentChangeObserver&) = delete;
+
+public:
+  /**
+   * Get the observer for the given MMKV instance, or create and start one if there is none yet.
+   */
+  static std::shared_ptr<MMKVContentChangeObserver> getOrCreate(MMKV* instance, const std::string& directory);
+
+  /**
+   * Starts observing again if the observer paused itself because all listeners were removed.
+   * Must be called after adding a listener.
+   */
+  void resume();
+  /**
+   * Stops observing for good and waits for the watcher thread to exit, so the MMKV instance can be closed.
+   * Other `HybridMMKV`s opened for the same file afterwards get a new observer.
+   */
+  void stop();
+
+private:
+  void start(const std::string& directory);
+  void checkForChanges();
+  /**
+   * Pauses the watcher if no listener (other than our own) is left, and forgets all fingerprints.
+   * Returns `true` if it was paused.
+   */
+  bool pauseIfUnobserved();
+  /**
+   * Fingerprints the keys this process wrote since the last check.
+   */
+  void updateDirtyFingerprints();
+  void onLocalValueChanged(const std::string& key);
+  MMKVKeyFingerprints fingerprintAllValues();
+  size_t fingerprintValue(const std::string& key);
+  static void onContentChanged(const std::string& mmkvID);
+
+private:
+  MMKV* _instance;
+  std::string _mmkvID;
+  std::mutex _mutex;
+  // Empty until the watcher thread fingerprinted all values (see `_hasFingerprints`)
+  MMKVKeyFingerprints _fingerprints;
+  bool _hasFingerprints = false;
+  // Keys written by this process whose fingerprint is outdated
+  std::unordered_set<std::string> _dirtyKeys;
+  // Only used on the watcher thread, so values are copied into the same memory every time
+  std::string _valueBuffer;
+  std::atomic<bool> _hasContentChanged = false;
+  ListenerID _localListenerID;
+  // Only accessed with `_mutex` held after `start()`, `nullptr` once stopped
+  std::unique_ptr<MMKVFileWatcher> _fileWatcher;
+
+private:
+  static std::mutex _observersMutex;
+  static std::unordered_map<std::string, MMKVContentChangeObserver*> _observers;
+};
+
+} // namespace margelo::nitro::mmkv
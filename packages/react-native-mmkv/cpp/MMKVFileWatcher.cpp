@@ -0,0 +1,113 @@
+//
+//  MMKVFileWatcher.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVFileWatcher.hpp"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace margelo::nitro::mmkv {
+
+MMKVFileWatcher::MMKVFileWatcher(const std::string& directory, std::chrono::milliseconds pollInterval, Callback&& onPossibleChange)
+    : _pollInterval(pollInterval), _onPossibleChange(std::move(onPossibleChange)) {
+#ifdef __linux__
+  _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (_inotifyFd >= 0) {
+    uint32_t mask = IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE | IN_MOVED_TO;
+    if (inotify_add_watch(_inotifyFd, directory.c_str(), mask) < 0) {
+      // Directory cannot be watched (e.g. permissions) - fall back to polling only.
+      close(_inotifyFd);
+      _inotifyFd = -1;
+    }
+  }
+#else
+  (void)directory;
+#endif
+  _thread = std::thread([this]() { runLoop(); });
+}
+
+MMKVFileWatcher::~MMKVFileWatcher() {
+  _isRunning = false;
+  wake();
+  _thread.join();
+#ifdef __linux__
+  if (_inotifyFd >= 0) {
+    close(_inotifyFd);
+  }
+  if (_wakeFd >= 0) {
+    close(_wakeFd);
+  }
+#endif
+}
+
+void MMKVFileWatcher::wake() {
+#ifdef __linux__
+  uint64_t value = 1;
+  [[maybe_unused]] auto written = write(_wakeFd, &value, sizeof(value));
+#else
+  {
+    std::unique_lock lock(_mutex);
+    _isWoken = true;
+  }
+  _condition.notify_one();
+#endif
+}
+
+void MMKVFileWatcher::pause() {
+  _isPaused = true;
+}
+
+void MMKVFileWatcher::resume() {
+  _isPaused = false;
+  wake();
+}
+
+bool MMKVFileWatcher::waitForChange() {
+  bool isPaused = _isPaused;
+#ifdef __linux__
+  pollfd fds[2] = {
+      {.fd = _wakeFd, .events = POLLIN, .revents = 0},
+      {.fd = _inotifyFd, .events = POLLIN, .revents = 0},
+  };
+  // While paused, only wait for wake() - file system events stay queued until we resume
+  nfds_t count = _inotifyFd >= 0 && !isPaused ? 2 : 1;
+  poll(fds, count, isPaused ? -1 : static_cast<int>(_pollInterval.count()));
+
+  // Drain both file descriptors - many events are collapsed into a single callback.
+  uint64_t wakeCount;
+  [[maybe_unused]] auto wakeRead = read(_wakeFd, &wakeCount, sizeof(wakeCount));
+  if (count == 2 && (fds[1].revents & POLLIN)) {
+    alignas(inotify_event) char events[4096];
+    while (read(_inotifyFd, events, sizeof(events)) > 0) {
+    }
+  }
+#else
+  std::unique_lock lock(_mutex);
+  if (isPaused) {
+    _condition.wait(lock, [this]() { return _isWoken; });
+  } else {
+    _condition.wait_for(lock, _pollInterval, [this]() { return _isWoken; });
+  }
+  _isWoken = false;
+#endif
+  return _isRunning;
+}
+
+void MMKVFileWatcher::runLoop() {
+  while (waitForChange()) {
+    try {
+      _onPossibleChange();
+    } catch (...) {
+      // A failing check must not stop the watcher - the next change will be checked again.
+    }
+  }
+}
+
+} // namespace margelo::nitro::mmkv
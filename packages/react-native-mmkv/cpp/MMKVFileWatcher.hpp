@@ -0,0 +1,81 @@
+//
+//  MMKVFileWatcher.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * Watches a directory for changes made by other processes, and calls `onPossibleChange`
+ * on its own background thread whenever files inside it might have changed.
+ *
+ * MMKV writes through `mmap`, which does not produce file system events (e.g. inotify) for
+ * every write, so this is only a hint: `onPossibleChange` is also called at least every
+ * `pollInterval`, and is expected to cheaply verify whether something actually changed.
+ *
+ * On Linux (and Android), inotify is used to wake up early for events the kernel does report
+ * (file growth, truncation, re-creation). On other platforms, the directory is polled.
+ */
+class MMKVFileWatcher final {
+public:
+  using Callback = std::function<void()>;
+  static constexpr auto DEFAULT_POLL_INTERVAL = std::chrono::milliseconds(250);
+
+public:
+  MMKVFileWatcher(const std::string& directory, std::chrono::milliseconds pollInterval, Callback&& onPossibleChange);
+  ~MMKVFileWatcher();
+
+  MMKVFileWatcher(const MMKVFileWatcher&) = delete;
+  MMKVFileWatcher& operator=(const MMKVFileWatcher&) = delete;
+
+public:
+  /**
+   * Calls `onPossibleChange` on the watcher thread as soon as possible,
+   * without waiting for a file system event or the poll interval.
+   */
+  void wake();
+  /**
+   * Stops polling and ignores file system events until `resume()` is called, so an idle watcher costs nothing.
+   * `wake()` still calls `onPossibleChange` while paused.
+   */
+  void pause();
+  /**
+   * Starts polling again, and calls `onPossibleChange` right away to catch up on what was missed while paused.
+   */
+  void resume();
+
+private:
+  void runLoop();
+  /**
+   * Blocks until a file system event arrives, `wake()` is called or the poll interval passed.
+   * Returns `false` if the watcher is being stopped.
+   */
+  bool waitForChange();
+
+private:
+  std::chrono::milliseconds _pollInterval;
+  Callback _onPossibleChange;
+  std::atomic<bool> _isRunning = true;
+  std::atomic<bool> _isPaused = false;
+#ifdef __linux__
+  int _inotifyFd = -1;
+  int _wakeFd = -1;
+#else
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _isWoken = false;
+#endif
+  std::thread _thread;
+};
+
+} // namespace margelo::nitro::mmkv
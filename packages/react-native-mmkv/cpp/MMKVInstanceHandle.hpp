@@ -0,0 +1,63 @@
+//
+//  MMKVInstanceHandle.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKVTypes.hpp"
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * A handle to an `MMKV*` instance which is opened on first access.
+ *
+ * Opening an MMKV instance maps the file, verifies its CRC, decrypts it and parses all keys,
+ * which can be deferred until the instance is actually used (or warmed up in the background).
+ * If multiple threads access the handle while it is being opened, they wait for the same open.
+ */
+class MMKVInstanceHandle final {
+public:
+  using Opener = std::function<MMKV*()>;
+
+public:
+  explicit MMKVInstanceHandle(Opener&& opener) : _opener(std::move(opener)) {}
+
+  MMKVInstanceHandle(const MMKVInstanceHandle&) = delete;
+  MMKVInstanceHandle& operator=(const MMKVInstanceHandle&) = delete;
+
+public:
+  /**
+   * Get the `MMKV*` instance, opening it if it is not open yet.
+   * If opening fails, this throws - and the next call will try again.
+   */
+  MMKV* get() {
+    std::call_once(_openFlag, [this]() {
+      _instance = _opener();
+      _isOpen = true;
+    });
+    return _instance;
+  }
+
+  MMKV* operator->() {
+    return get();
+  }
+
+  /**
+   * Whether the instance has already been opened.
+   */
+  bool isOpen() const {
+    return _isOpen;
+  }
+
+private:
+  Opener _opener;
+  std::once_flag _openFlag;
+  std::atomic<bool> _isOpen = false;
+  MMKV* _instance = nullptr;
+};
+
+} // namespace margelo::nitro::mmkv
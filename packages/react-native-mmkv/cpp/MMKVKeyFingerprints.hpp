@@ -0,0 +1,50 @@
+//
+//  MMKVKeyFingerprints.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * A hash of every key's value, used to find out which keys changed between two points in time.
+ */
+using MMKVKeyFingerprints = std::unordered_map<std::string, size_t>;
+
+/**
+ * Mixes `value` into the given `hash`.
+ */
+inline void combineFingerprint(size_t& hash, size_t value) {
+  hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+}
+
+/**
+ * Returns all keys that were added, changed or removed between `before` and `after`, sorted.
+ */
+inline std::vector<std::string> diffKeyFingerprints(const MMKVKeyFingerprints& before, const MMKVKeyFingerprints& after) {
+  std::vector<std::string> changedKeys;
+  for (const auto& [key, fingerprint] : after) {
+    auto previous = before.find(key);
+    if (previous == before.end() || previous->second != fingerprint) {
+      // Key was added or changed
+      changedKeys.push_back(key);
+    }
+  }
+  for (const auto& [key, _] : before) {
+    if (!after.contains(key)) {
+      // Key was removed
+      changedKeys.push_back(key);
+    }
+  }
+  std::sort(changedKeys.begin(), changedKeys.end());
+  return changedKeys;
+}
+
+} // namespace margelo::nitro::mmkv
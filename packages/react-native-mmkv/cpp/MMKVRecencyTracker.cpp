@@ -0,0 +1,56 @@
+//
+//  MMKVRecencyTracker.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVRecencyTracker.hpp"
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <utility>
+
+namespace margelo::nitro::mmkv {
+
+MMKVRecencyTracker::MMKVRecencyTracker(size_t capacity) {
+  size_t slots = std::bit_ceil(std::max<size_t>(capacity, 1));
+  _mask = slots - 1;
+  _lastAccess = std::make_unique<std::atomic<uint64_t>[]>(slots);
+  clear();
+}
+
+size_t MMKVRecencyTracker::getSlot(const std::string& key) const {
+  return std::hash<std::string>()(key) & _mask;
+}
+
+void MMKVRecencyTracker::touch(const std::string& key) {
+  uint64_t tick = _clock.fetch_add(1, std::memory_order_relaxed);
+  _lastAccess[getSlot(key)].store(tick, std::memory_order_relaxed);
+}
+
+void MMKVRecencyTracker::clear() {
+  for (size_t i = 0; i <= _mask; i++) {
+    _lastAccess[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+std::vector<std::string> MMKVRecencyTracker::sortByRecency(std::vector<std::string> keys) const {
+  std::vector<std::pair<uint64_t, size_t>> ticks;
+  ticks.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    ticks.emplace_back(_lastAccess[getSlot(keys[i])].load(std::memory_order_relaxed), i);
+  }
+  std::sort(ticks.begin(), ticks.end());
+
+  std::vector<std::string> sortedKeys;
+  sortedKeys.reserve(keys.size());
+  for (const auto& [tick, index] : ticks) {
+    sortedKeys.push_back(std::move(keys[index]));
+  }
+  return sortedKeys;
+}
+
+size_t MMKVRecencyTracker::capacity() const {
+  return _mask + 1;
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,62 @@
+//
+//  MMKVRecencyTracker.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * Approximately tracks when each key was last accessed, to find the least recently used keys.
+ *
+ * Instead of a map, this is a fixed-size table of access ticks indexed by the hash of the key,
+ * so accessing a key never locks or allocates - it is a hash and two relaxed atomic operations.
+ * Keys that share a slot share their tick, which makes them look as recent as the most recently
+ * used of them. With enough slots this rarely happens, and it only ever keeps a key longer.
+ */
+class MMKVRecencyTracker final {
+public:
+  /**
+   * Creates a tracker with at least `capacity` slots.
+   */
+  explicit MMKVRecencyTracker(size_t capacity);
+
+  MMKVRecencyTracker(const MMKVRecencyTracker&) = delete;
+  MMKVRecencyTracker& operator=(const MMKVRecencyTracker&) = delete;
+
+public:
+  /**
+   * Marks the given `key` as the most recently used one.
+   */
+  void touch(const std::string& key);
+  /**
+   * Forgets all accesses, e.g. after all keys have been removed.
+   */
+  void clear();
+
+public:
+  /**
+   * Sorts the given `keys` by their last access, least recently used first.
+   * Keys that were never accessed come first.
+   */
+  std::vector<std::string> sortByRecency(std::vector<std::string> keys) const;
+  size_t capacity() const;
+
+private:
+  size_t getSlot(const std::string& key) const;
+
+private:
+  size_t _mask;
+  std::unique_ptr<std::atomic<uint64_t>[]> _lastAccess;
+  // Starts at 1, so keys that were never accessed (tick 0) are always the oldest
+  std::atomic<uint64_t> _clock = 1;
+};
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,35 @@
+//
+//  MMKVScopedLock.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include "MMKVTypes.hpp"
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * Holds the exclusive lock of the given MMKV instance for as long as this object is alive.
+ *
+ * In multi-process mode this is an inter-process file lock, so nested operations
+ * on the same instance (which acquire the lock recursively) don't have to
+ * re-check the file for outside modifications each time.
+ */
+class MMKVScopedLock final {
+public:
+  explicit MMKVScopedLock(MMKV* instance) : _instance(instance) {
+    _instance->lock();
+  }
+  ~MMKVScopedLock() {
+    _instance->unlock();
+  }
+
+  MMKVScopedLock(const MMKVScopedLock&) = delete;
+  MMKVScopedLock& operator=(const MMKVScopedLock&) = delete;
+
+private:
+  MMKV* _instance;
+};
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,111 @@
+//
+//  MMKVStatsRecorder.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVStatsRecorder.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace margelo::nitro::mmkv {
+
+namespace {
+
+  size_t getCurrentThreadShardIndex() {
+    // Threads are spread over the shards in the order they first record something
+    static std::atomic<size_t> nextShardIndex = 0;
+    thread_local size_t shardIndex = nextShardIndex.fetch_add(1, std::memory_order_relaxed) % MMKVStatsRecorder::SHARD_COUNT;
+    return shardIndex;
+  }
+
+  void add(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+
+} // namespace
+
+uint64_t MMKVStatsRecorder::Histogram::getPercentile(double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+  auto target = static_cast<uint64_t>(std::max(1.0, percentile * static_cast<double>(count)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    seen += buckets[i];
+    if (seen >= target) {
+      return uint64_t(1) << i;
+    }
+  }
+  return uint64_t(1) << (BUCKET_COUNT - 1);
+}
+
+MMKVStatsRecorder::Snapshot& MMKVStatsRecorder::Snapshot::operator+=(const Snapshot& other) {
+  for (size_t operation = 0; operation < OPERATION_COUNT; operation++) {
+    operations[operation].count += other.operations[operation].count;
+    operations[operation].totalNanoseconds += other.operations[operation].totalNanoseconds;
+    for (size_t i = 0; i < BUCKET_COUNT; i++) {
+      operations[operation].buckets[i] += other.operations[operation].buckets[i];
+    }
+  }
+  bytesWritten += other.bytesWritten;
+  fileGrowths += other.fileGrowths;
+  fullWriteBacks += other.fullWriteBacks;
+  return *this;
+}
+
+MMKVStatsRecorder::MMKVStatsRecorder() : _shards(std::make_unique<Shard[]>(SHARD_COUNT)) {}
+
+MMKVStatsRecorder::Shard& MMKVStatsRecorder::getShard() {
+  return _shards[getCurrentThreadShardIndex()];
+}
+
+void MMKVStatsRecorder::record(MMKVOperation operation, std::chrono::nanoseconds duration) {
+  auto index = static_cast<size_t>(operation);
+  auto nanoseconds = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+  size_t bucket = std::min(static_cast<size_t>(std::bit_width(nanoseconds)), BUCKET_COUNT - 1);
+
+  Shard& shard = getShard();
+  add(shard.totalNanoseconds[index], nanoseconds);
+  add(shard.buckets[index][bucket], 1);
+}
+
+void MMKVStatsRecorder::didObserveSizes(size_t fileSize, size_t usedSize) {
+  size_t lastFileSize = _lastFileSize.exchange(fileSize, std::memory_order_relaxed);
+  size_t lastUsedSize = _lastUsedSize.exchange(usedSize, std::memory_order_relaxed);
+  if (lastFileSize == 0) {
+    // First observation, there is nothing to compare with yet
+    return;
+  }
+
+  Shard& shard = getShard();
+  if (fileSize > lastFileSize) {
+    add(shard.fileGrowths, 1);
+  }
+  if (usedSize >= lastUsedSize) {
+    add(shard.bytesWritten, usedSize - lastUsedSize);
+  } else {
+    add(shard.fullWriteBacks, 1);
+  }
+}
+
+MMKVStatsRecorder::Snapshot MMKVStatsRecorder::getSnapshot() const {
+  Snapshot snapshot;
+  for (size_t s = 0; s < SHARD_COUNT; s++) {
+    const Shard& shard = _shards[s];
+    for (size_t operation = 0; operation < OPERATION_COUNT; operation++) {
+      Histogram& histogram = snapshot.operations[operation];
+      histogram.totalNanoseconds += shard.totalNanoseconds[operation].load(std::memory_order_relaxed);
+      for (size_t i = 0; i < BUCKET_COUNT; i++) {
+        uint64_t count = shard.buckets[operation][i].load(std::memory_order_relaxed);
+        histogram.buckets[i] += count;
+        histogram.count += count;
+      }
+    }
+    snapshot.bytesWritten += shard.bytesWritten.load(std::memory_order_relaxed);
+    snapshot.fileGrowths += shard.fileGrowths.load(std::memory_order_relaxed);
+    snapshot.fullWriteBacks += shard.fullWriteBacks.load(std::memory_order_relaxed);
+  }
+  return snapshot;
+}
+
+} // namespace margelo::nitro::mmkv
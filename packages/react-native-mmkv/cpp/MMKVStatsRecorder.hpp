@@ -0,0 +1,137 @@
+//
+//  MMKVStatsRecorder.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Stats are collected unless they are disabled at build time (see README), which compiles all recording out.
+#ifndef MMKV_ENABLE_STATS
+#define MMKV_ENABLE_STATS 1
+#endif
+
+namespace margelo::nitro::mmkv {
+
+enum class MMKVOperation : size_t {
+  GET = 0,
+  SET = 1,
+  REMOVE = 2,
+  NOTIFY = 3,
+};
+
+/**
+ * Collects operation counts, latency histograms and file events of a single MMKV instance.
+ *
+ * Recording never locks: counters are striped into a few cache-line-sized shards, and each thread
+ * always records into the same shard, so threads rarely touch the same cache line.
+ * Reading the stats sums up all shards, which is only eventually consistent with concurrent writers.
+ */
+class MMKVStatsRecorder final {
+public:
+  static constexpr bool IS_ENABLED = MMKV_ENABLE_STATS;
+  static constexpr size_t OPERATION_COUNT = 4;
+  /**
+   * Bucket `i` counts operations that took less than `2^i` nanoseconds (and at least `2^(i-1)`).
+   * The last bucket also counts all slower operations.
+   */
+  static constexpr size_t BUCKET_COUNT = 33;
+  static constexpr size_t SHARD_COUNT = 4;
+
+  struct Histogram {
+    uint64_t count = 0;
+    uint64_t totalNanoseconds = 0;
+    std::array<uint64_t, BUCKET_COUNT> buckets{};
+
+    /**
+     * Gets the upper bound of the bucket that contains the given percentile (`0.0` - `1.0`), in nanoseconds.
+     */
+    uint64_t getPercentile(double percentile) const;
+  };
+
+  struct Snapshot {
+    std::array<Histogram, OPERATION_COUNT> operations{};
+    uint64_t bytesWritten = 0;
+    uint64_t fileGrowths = 0;
+    uint64_t fullWriteBacks = 0;
+
+    const Histogram& operator[](MMKVOperation operation) const {
+      return operations[static_cast<size_t>(operation)];
+    }
+    Snapshot& operator+=(const Snapshot& other);
+  };
+
+public:
+  MMKVStatsRecorder();
+
+  MMKVStatsRecorder(const MMKVStatsRecorder&) = delete;
+  MMKVStatsRecorder& operator=(const MMKVStatsRecorder&) = delete;
+
+public:
+  void record(MMKVOperation operation, std::chrono::nanoseconds duration);
+  /**
+   * Compares the instance's file size and used size with the ones observed the previous time,
+   * to find out whether MMKV grew the file or rewrote it from scratch (which is the only way its used size shrinks).
+   * Sizes are sampled whenever stats are read, so several growths or write-backs in between count as one.
+   */
+  void didObserveSizes(size_t fileSize, size_t usedSize);
+  Snapshot getSnapshot() const;
+
+private:
+  struct alignas(64) Shard {
+    // The count of each operation is the sum of its buckets, so recording only needs two atomic additions
+    std::array<std::atomic<uint64_t>, OPERATION_COUNT> totalNanoseconds{};
+    std::array<std::array<std::atomic<uint64_t>, BUCKET_COUNT>, OPERATION_COUNT> buckets{};
+    std::atomic<uint64_t> bytesWritten = 0;
+    std::atomic<uint64_t> fileGrowths = 0;
+    std::atomic<uint64_t> fullWriteBacks = 0;
+  };
+
+  Shard& getShard();
+
+private:
+  std::unique_ptr<Shard[]> _shards;
+  std::atomic<size_t> _lastFileSize = 0;
+  std::atomic<size_t> _lastUsedSize = 0;
+};
+
+/**
+ * Records the duration of an operation from its construction until it goes out of scope.
+ * Compiles to nothing if stats are disabled.
+ */
+class MMKVOperationTimer final {
+public:
+  MMKVOperationTimer(MMKVStatsRecorder* recorder, MMKVOperation operation)
+#if MMKV_ENABLE_STATS
+      : _recorder(recorder), _operation(operation), _start(std::chrono::steady_clock::now()) {
+  }
+#else
+  {
+    (void)recorder;
+    (void)operation;
+  }
+#endif
+  ~MMKVOperationTimer() {
+#if MMKV_ENABLE_STATS
+    _recorder->record(_operation, std::chrono::steady_clock::now() - _start);
+#endif
+  }
+
+  MMKVOperationTimer(const MMKVOperationTimer&) = delete;
+  MMKVOperationTimer& operator=(const MMKVOperationTimer&) = delete;
+
+#if MMKV_ENABLE_STATS
+private:
+  MMKVStatsRecorder* _recorder;
+  MMKVOperation _operation;
+  std::chrono::steady_clock::time_point _start;
+#endif
+};
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,69 @@
+//
+//  MMKVThreadPool.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVThreadPool.hpp"
+#include <algorithm>
+
+namespace margelo::nitro::mmkv {
+
+MMKVThreadPool::MMKVThreadPool(size_t maxThreads) : _maxThreads(std::max<size_t>(maxThreads, 1)) {}
+
+MMKVThreadPool::~MMKVThreadPool() {
+  std::vector<std::thread> threads;
+  {
+    std::unique_lock lock(_state->mutex);
+    _state->isRunning = false;
+    threads = std::move(_threads);
+  }
+  _state->condition.notify_all();
+  for (auto& thread : threads) {
+    if (thread.get_id() == std::this_thread::get_id()) {
+      // The pool was released by one of its own tasks - this worker can't join itself,
+      // it still owns the state and exits once the remaining tasks are done.
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+}
+
+void MMKVThreadPool::run(std::function<void()>&& task) {
+  {
+    std::unique_lock lock(_state->mutex);
+    _state->tasks.push(std::move(task));
+    if (_state->idleThreads == 0 && _threads.size() < _maxThreads) {
+      // All workers are busy (or none exist yet) - spawn a new one
+      _threads.emplace_back([state = _state]() { runLoop(state); });
+    }
+  }
+  _state->condition.notify_one();
+}
+
+void MMKVThreadPool::runLoop(const std::shared_ptr<State>& state) {
+  std::unique_lock lock(state->mutex);
+  while (true) {
+    state->idleThreads++;
+    state->condition.wait(lock, [&]() { return !state->tasks.empty() || !state->isRunning; });
+    state->idleThreads--;
+    if (state->tasks.empty()) {
+      // Pool is shutting down and there is nothing left to do
+      return;
+    }
+    auto task = std::move(state->tasks.front());
+    state->tasks.pop();
+
+    lock.unlock();
+    try {
+      task();
+    } catch (...) {
+      // Tasks report their own errors (e.g. by rejecting a Promise) - never take down the worker.
+    }
+    // Destroy whatever the task captured before taking the lock again, that might release the pool itself
+    task = nullptr;
+    lock.lock();
+  }
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,58 @@
+//
+//  MMKVThreadPool.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * A small pool of worker threads that run tasks in the order they were submitted.
+ *
+ * Workers are only spawned once tasks are actually submitted (up to `maxThreads`),
+ * so apps that never use the async APIs don't pay for idle threads.
+ */
+class MMKVThreadPool final {
+public:
+  explicit MMKVThreadPool(size_t maxThreads);
+  ~MMKVThreadPool();
+
+  MMKVThreadPool(const MMKVThreadPool&) = delete;
+  MMKVThreadPool& operator=(const MMKVThreadPool&) = delete;
+
+public:
+  /**
+   * Runs the given `task` on one of the worker threads.
+   */
+  void run(std::function<void()>&& task);
+
+private:
+  // Shared with the workers, so a task can destroy the pool (e.g. by releasing its last owner)
+  // and its worker still finishes the loop safely.
+  struct State {
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::queue<std::function<void()>> tasks;
+    size_t idleThreads = 0;
+    bool isRunning = true;
+  };
+  static void runLoop(const std::shared_ptr<State>& state);
+
+private:
+  size_t _maxThreads;
+  std::shared_ptr<State> _state = std::make_shared<State>();
+  // Only accessed with `_state->mutex` held
+  std::vector<std::thread> _threads;
+};
+
+} // namespace margelo::nitro::mmkv
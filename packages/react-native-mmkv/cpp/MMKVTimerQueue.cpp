@@ -0,0 +1,65 @@
+//
+//  MMKVTimerQueue.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVTimerQueue.hpp"
+
+namespace margelo::nitro::mmkv {
+
+MMKVTimerQueue::MMKVTimerQueue() : _thread([this]() { runLoop(); }) {}
+
+MMKVTimerQueue::~MMKVTimerQueue() {
+  {
+    std::unique_lock lock(_mutex);
+    _isRunning = false;
+  }
+  _condition.notify_all();
+  _thread.join();
+}
+
+MMKVTimerQueue& MMKVTimerQueue::shared() {
+  static MMKVTimerQueue queue;
+  return queue;
+}
+
+void MMKVTimerQueue::schedule(std::chrono::milliseconds delay, std::function<void()>&& task) {
+  {
+    std::unique_lock lock(_mutex);
+    _tasks.push(ScheduledTask{
+        .deadline = Clock::now() + delay,
+        .sequence = _sequence++,
+        .task = std::move(task),
+    });
+  }
+  _condition.notify_one();
+}
+
+void MMKVTimerQueue::runLoop() {
+  std::unique_lock lock(_mutex);
+  while (_isRunning) {
+    if (_tasks.empty()) {
+      // 1. Nothing to do, wait until a task is scheduled
+      _condition.wait(lock);
+      continue;
+    }
+    // 2. Wait until the earliest task is due (or an earlier one gets scheduled)
+    auto deadline = _tasks.top().deadline;
+    if (Clock::now() < deadline) {
+      _condition.wait_until(lock, deadline);
+      continue;
+    }
+    // 3. Run the task without holding the lock, so it can schedule new tasks
+    auto task = std::move(const_cast<ScheduledTask&>(_tasks.top()).task);
+    _tasks.pop();
+    lock.unlock();
+    try {
+      task();
+    } catch (...) {
+      // A failing task must not take down the timer thread (and all other tasks) with it.
+    }
+    lock.lock();
+  }
+}
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,69 @@
+//
+//  MMKVTimerQueue.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * A single background thread that runs tasks after a given delay.
+ *
+ * Tasks run one after another on the timer thread, so they should be short -
+ * long-running work should be dispatched to a different thread from inside the task.
+ */
+class MMKVTimerQueue final {
+public:
+  using Clock = std::chrono::steady_clock;
+
+public:
+  MMKVTimerQueue();
+  ~MMKVTimerQueue();
+
+  MMKVTimerQueue(const MMKVTimerQueue&) = delete;
+  MMKVTimerQueue& operator=(const MMKVTimerQueue&) = delete;
+
+public:
+  /**
+   * Runs the given `task` on the timer thread once `delay` has passed.
+   */
+  void schedule(std::chrono::milliseconds delay, std::function<void()>&& task);
+
+public:
+  /**
+   * Get the shared timer queue, which is lazily started on first use.
+   */
+  static MMKVTimerQueue& shared();
+
+private:
+  void runLoop();
+
+private:
+  struct ScheduledTask {
+    Clock::time_point deadline;
+    size_t sequence;
+    std::function<void()> task;
+
+    bool operator>(const ScheduledTask& other) const {
+      return deadline != other.deadline ? deadline > other.deadline : sequence > other.sequence;
+    }
+  };
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::priority_queue<ScheduledTask, std::vector<ScheduledTask>, std::greater<>> _tasks;
+  size_t _sequence = 0;
+  bool _isRunning = true;
+  std::thread _thread;
+};
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,45 @@
+//
+//  MMKVTracer.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVTracer.hpp"
+
+namespace margelo::nitro::mmkv {
+
+// static members
+std::atomic<bool> MMKVTracer::_isEnabled = false;
+std::mutex MMKVTracer::_mutex;
+std::shared_ptr<MMKVTraceSink> MMKVTracer::_sink;
+
+void MMKVTracer::setSink(std::shared_ptr<MMKVTraceSink> sink) {
+  std::unique_lock lock(_mutex);
+  _isEnabled.store(sink != nullptr, std::memory_order_relaxed);
+  _sink = std::move(sink);
+}
+
+std::shared_ptr<MMKVTraceSink> MMKVTracer::getSink() {
+  std::unique_lock lock(_mutex);
+  return _sink;
+}
+
+void MMKVTraceScope::begin(const char* name, std::string_view instanceId, size_t keySize, size_t valueSize) {
+  _sink = MMKVTracer::getSink();
+  if (_sink == nullptr) {
+    // Tracing was disabled in the meantime
+    return;
+  }
+  _event.name = name;
+  _event.instanceId = instanceId;
+  _event.keySize = keySize;
+  _event.valueSize = valueSize;
+  _event.start = std::chrono::steady_clock::now();
+  _sink->beginEvent(_event);
+}
+
+void MMKVTraceScope::end() {
+  _event.duration = std::chrono::steady_clock::now() - _event.start;
+  _sink->endEvent(_event);
+}
+
+} // namespace margelo::nitro::mmkv
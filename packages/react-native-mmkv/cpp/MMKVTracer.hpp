@@ -0,0 +1,121 @@
+//
+//  MMKVTracer.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+namespace margelo::nitro::mmkv {
+
+/**
+ * A single traced operation, e.g. one `set(...)` call.
+ */
+struct MMKVTraceEvent {
+  // A string literal, e.g. `"set"`
+  const char* name;
+  // Only valid while the event is being traced - sinks that keep it around have to copy it
+  std::string_view instanceId;
+  size_t keySize = 0;
+  // Getters only know this once they finished, so it is only reliable in `endEvent(...)`
+  size_t valueSize = 0;
+  std::chrono::steady_clock::time_point start;
+  // Only set in `endEvent(...)`
+  std::chrono::nanoseconds duration = std::chrono::nanoseconds(0);
+};
+
+/**
+ * Receives trace events, e.g. to forward them to ATrace, os_signpost or a file.
+ *
+ * Both methods are called on the thread that runs the operation, so they sit right in the hot path
+ * and have to be fast. They may be called from many threads at the same time.
+ */
+class MMKVTraceSink {
+public:
+  virtual ~MMKVTraceSink() = default;
+
+public:
+  /**
+   * Called right before an operation starts.
+   */
+  virtual void beginEvent(const MMKVTraceEvent& event) = 0;
+  /**
+   * Called on the same thread right after the operation finished, even if it threw.
+   * Every `beginEvent(...)` is followed by exactly one `endEvent(...)` on the same sink,
+   * even if the sink was replaced in the meantime.
+   */
+  virtual void endEvent(const MMKVTraceEvent& event) = 0;
+};
+
+/**
+ * Holds the process-wide trace sink. Tracing is disabled until a sink is set,
+ * which costs a single relaxed atomic load per operation.
+ */
+class MMKVTracer final {
+public:
+  MMKVTracer() = delete;
+  ~MMKVTracer() = delete;
+
+public:
+  /**
+   * Sets the sink all trace events are sent to, or disables tracing if it is `nullptr`.
+   */
+  static void setSink(std::shared_ptr<MMKVTraceSink> sink);
+  static std::shared_ptr<MMKVTraceSink> getSink();
+
+  static bool isEnabled() {
+    return _isEnabled.load(std::memory_order_relaxed);
+  }
+
+private:
+  static std::atomic<bool> _isEnabled;
+  static std::mutex _mutex;
+  static std::shared_ptr<MMKVTraceSink> _sink;
+};
+
+/**
+ * Traces an operation from its construction until it goes out of scope.
+ * Does nothing (not even read the clock) if tracing is disabled.
+ */
+class MMKVTraceScope final {
+public:
+  MMKVTraceScope(const char* name, std::string_view instanceId, size_t keySize = 0, size_t valueSize = 0) {
+    if (!MMKVTracer::isEnabled()) [[likely]] {
+      return;
+    }
+    begin(name, instanceId, keySize, valueSize);
+  }
+  ~MMKVTraceScope() {
+    if (_sink != nullptr) [[unlikely]] {
+      end();
+    }
+  }
+
+  MMKVTraceScope(const MMKVTraceScope&) = delete;
+  MMKVTraceScope& operator=(const MMKVTraceScope&) = delete;
+
+public:
+  /**
+   * Sets the size of the value, for operations that only know it once they are done (e.g. getters).
+   */
+  void setValueSize(size_t valueSize) {
+    _event.valueSize = valueSize;
+  }
+
+private:
+  void begin(const char* name, std::string_view instanceId, size_t keySize, size_t valueSize);
+  void end();
+
+private:
+  // Keeps the sink alive until the event ended, even if it is replaced in the meantime
+  std::shared_ptr<MMKVTraceSink> _sink;
+  MMKVTraceEvent _event{};
+};
+
+} // namespace margelo::nitro::mmkv
@@ -6,53 +6,244 @@
 //
 
 #include "MMKVValueChangedListenerRegistry.hpp"
+#include <algorithm>
 
 namespace margelo::nitro::mmkv {
 
 // static members
 std::atomic<ListenerID> MMKVValueChangedListenerRegistry::_listenersCounter = 0;
-std::unordered_map<MMKVID, std::vector<ListenerSubscription>> MMKVValueChangedListenerRegistry::_listeners;
+std::mutex MMKVValueChangedListenerRegistry::_writeMutex;
+std::shared_ptr<const ListenersSnapshot> MMKVValueChangedListenerRegistry::_snapshot = std::make_shared<const ListenersSnapshot>();
+std::unordered_map<ListenerID, std::string> MMKVValueChangedListenerRegistry::_keyOfListener;
 
-ListenerID MMKVValueChangedListenerRegistry::addListener(const std::string& mmkvID,
-                                                         const std::function<void(const std::string& /* key */)>& callback) {
-  // 1. Get (or create) the listeners array for these MMKV instances
-  auto& listeners = _listeners[mmkvID];
-  // 2. Get (and increment) the listener ID counter
+// std::atomic<std::shared_ptr<T>> is not available in libc++ yet, so we use the
+// (C++20-deprecated) free function overloads which are available everywhere.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+std::shared_ptr<const ListenersSnapshot> MMKVValueChangedListenerRegistry::loadSnapshot() {
+  return std::atomic_load_explicit(&_snapshot, std::memory_order_acquire);
+}
+
+void MMKVValueChangedListenerRegistry::updateListeners(const std::string& mmkvID,
+                                                       const std::function<void(InstanceListeners& listeners)>& update) {
+  std::unique_lock lock(_writeMutex);
+  // 1. Copy the current snapshot - this only copies pointers, `update` copies the bucket it changes
+  auto current = loadSnapshot();
+  auto next = std::make_shared<ListenersSnapshot>(*current);
+  auto entry = next->find(mmkvID);
+  auto listeners = entry != next->end() ? std::make_shared<InstanceListeners>(*entry->second) : std::make_shared<InstanceListeners>();
+  // 2. Apply the change to the copy
+  update(*listeners);
+  if (listeners->count == 0) {
+    next->erase(mmkvID);
+  } else {
+    (*next)[mmkvID] = std::move(listeners);
+  }
+  // 3. Publish the new snapshot
+  std::atomic_store_explicit(&_snapshot, std::shared_ptr<const ListenersSnapshot>(std::move(next)), std::memory_order_release);
+}
+#pragma GCC diagnostic pop
+
+template <typename T>
+static void addToBucket(ListenerBucket<T>& bucket, T&& subscription) {
+  auto next = bucket != nullptr ? std::make_shared<std::vector<T>>(*bucket) : std::make_shared<std::vector<T>>();
+  next->push_back(std::move(subscription));
+  bucket = std::move(next);
+}
+
+template <typename T>
+static bool removeFromBucket(ListenerBucket<T>& bucket, ListenerID id) {
+  if (bucket == nullptr) {
+    return false;
+  }
+  auto isListener = [id](const T& e) { return e.id == id; };
+  if (std::none_of(bucket->begin(), bucket->end(), isListener)) {
+    return false;
+  }
+  auto next = std::make_shared<std::vector<T>>(*bucket);
+  next->erase(std::remove_if(next->begin(), next->end(), isListener), next->end());
+  bucket = next->empty() ? nullptr : std::move(next);
+  return true;
+}
+
+ListenerID MMKVValueChangedListenerRegistry::addListener(const std::string& mmkvID, const ListenerCallback& callback) {
+  // 1. Get (and increment) the listener ID counter
+  auto id = _listenersCounter.fetch_add(1);
+  // 2. Add the listener to our array
+  updateListeners(mmkvID, [&](InstanceListeners& listeners) {
+    addToBucket(listeners.all, ListenerSubscription{
+                                   .id = id,
+                                   .callback = std::make_shared<const ListenerCallback>(callback),
+                               });
+    listeners.count++;
+  });
+  // 3. Return the ID used to unsubscribe later on
+  return id;
+}
+
+ListenerID MMKVValueChangedListenerRegistry::addKeyListener(const std::string& mmkvID, const std::string& key,
+                                                            const ListenerCallback& callback) {
+  // 1. Get (and increment) the listener ID counter
+  auto id = _listenersCounter.fetch_add(1);
+  // 2. Add the listener to the index for this key - only the shard of this key is copied
+  updateListeners(mmkvID, [&](InstanceListeners& listeners) {
+    auto& shard = listeners.byKey[InstanceListeners::getShardIndex(key)];
+    auto next = shard != nullptr ? std::make_shared<KeyListenerShard>(*shard) : std::make_shared<KeyListenerShard>();
+    (*next)[key].push_back(ListenerSubscription{
+        .id = id,
+        .callback = std::make_shared<const ListenerCallback>(callback),
+    });
+    shard = std::move(next);
+    listeners.count++;
+    _keyOfListener[id] = key;
+  });
+  // 3. Return the ID used to unsubscribe later on
+  return id;
+}
+
+ListenerID MMKVValueChangedListenerRegistry::addPrefixListener(const std::string& mmkvID, const std::string& prefix,
+                                                               const ListenerCallback& callback) {
+  // 1. Get (and increment) the listener ID counter
   auto id = _listenersCounter.fetch_add(1);
-  // 3. Add the listener to our array
-  listeners.push_back(ListenerSubscription{
-      .id = id,
-      .callback = callback,
+  // 2. Add the listener to our prefix array
+  updateListeners(mmkvID, [&](InstanceListeners& listeners) {
+    addToBucket(listeners.byPrefix, PrefixListenerSubscription{
+                                        .id = id,
+                                        .prefix = prefix,
+                                        .callback = std::make_shared<const ListenerCallback>(callback),
+                                    });
+    listeners.count++;
   });
-  // 4. Return the ID used to unsubscribe later on
+  // 3. Return the ID used to unsubscribe later on
+  return id;
+}
+
+ListenerID MMKVValueChangedListenerRegistry::addBatchListener(const std::string& mmkvID, const BatchListenerCallback& callback) {
+  // 1. Get (and increment) the listener ID counter
+  auto id = _listenersCounter.fetch_add(1);
+  // 2. Add the listener to our batch array
+  updateListeners(mmkvID, [&](InstanceListeners& listeners) {
+    addToBucket(listeners.batches, BatchListenerSubscription{
+                                       .id = id,
+                                       .callback = std::make_shared<const BatchListenerCallback>(callback),
+                                   });
+    listeners.count++;
+  });
+  // 3. Return the ID used to unsubscribe later on
   return id;
 }
 
 void MMKVValueChangedListenerRegistry::removeListener(const std::string& mmkvID, ListenerID id) {
-  // 1. Get the listeners array for these MMKV instances
-  auto entry = _listeners.find(mmkvID);
-  if (entry == _listeners.end()) {
+  // 1. Check if there even are listeners for this MMKV instance, so we don't copy for nothing
+  auto snapshot = loadSnapshot();
+  if (!snapshot->contains(mmkvID)) {
     // There's no more listeners for this instance anyways.
     return;
   }
-  // 2. Remove all listeners where the ID matches. Should only be one.
-  auto& listeners = entry->second;
-  listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [id](const ListenerSubscription& e) { return e.id == id; }),
-                  listeners.end());
+  updateListeners(mmkvID, [&](InstanceListeners& listeners) {
+    // 2. If it is a key-scoped listener, only remove it from that key's shard
+    auto keyEntry = _keyOfListener.find(id);
+    if (keyEntry != _keyOfListener.end()) {
+      const std::string& key = keyEntry->second;
+      auto& shard = listeners.byKey[InstanceListeners::getShardIndex(key)];
+      if (shard != nullptr && shard->contains(key)) {
+        auto next = std::make_shared<KeyListenerShard>(*shard);
+        auto& keyListeners = next->at(key);
+        auto previousSize = keyListeners.size();
+        keyListeners.erase(std::remove_if(keyListeners.begin(), keyListeners.end(), [id](const auto& e) { return e.id == id; }),
+                           keyListeners.end());
+        listeners.count -= previousSize - keyListeners.size();
+        if (keyListeners.empty()) {
+          next->erase(key);
+        }
+        shard = next->empty() ? nullptr : std::move(next);
+      }
+      _keyOfListener.erase(keyEntry);
+      return;
+    }
+    // 3. Otherwise remove the listener from the bucket where the ID matches. Should only be one.
+    if (removeFromBucket(listeners.all, id) || removeFromBucket(listeners.byPrefix, id) || removeFromBucket(listeners.batches, id)) {
+      listeners.count--;
+    }
+  });
+}
+
+size_t MMKVValueChangedListenerRegistry::getListenerCount(const std::string& mmkvID) {
+  auto snapshot = loadSnapshot();
+  auto entry = snapshot->find(mmkvID);
+  if (entry == snapshot->end()) {
+    return 0;
+  }
+  return entry->second->count;
+}
+
+void MMKVValueChangedListenerRegistry::notifyListeners(const InstanceListeners& listeners, const std::string& key) {
+  // 1. Call each listener that listens to all keys.
+  if (listeners.all != nullptr) {
+    for (const auto& listener : *listeners.all) {
+      (*listener.callback)(key);
+    }
+  }
+  // 2. Call each listener that listens to exactly this key.
+  const auto& shard = listeners.byKey[InstanceListeners::getShardIndex(key)];
+  if (shard != nullptr) {
+    auto keyListeners = shard->find(key);
+    if (keyListeners != shard->end()) {
+      for (const auto& listener : keyListeners->second) {
+        (*listener.callback)(key);
+      }
+    }
+  }
+  // 3. Call each listener whose prefix matches this key.
+  if (listeners.byPrefix != nullptr) {
+    for (const auto& listener : *listeners.byPrefix) {
+      if (key.starts_with(listener.prefix)) {
+        (*listener.callback)(key);
+      }
+    }
+  }
+}
+
+void MMKVValueChangedListenerRegistry::notifyBatchListeners(const InstanceListeners& listeners, std::span<const std::string> keys) {
+  if (listeners.batches == nullptr) {
+    return;
+  }
+  for (const auto& listener : *listeners.batches) {
+    (*listener.callback)(keys);
+  }
 }
 
 void MMKVValueChangedListenerRegistry::notifyOnValueChanged(const std::string& mmkvID, const std::string& key) {
   // 1. Get all listeners for the specific MMKV ID
-  auto entry = _listeners.find(mmkvID);
-  if (entry == _listeners.end()) {
+  auto snapshot = loadSnapshot();
+  auto entry = snapshot->find(mmkvID);
+  if (entry == snapshot->end()) {
+    // There are no listeners. Return
+    return;
+  }
+  // 2. Call each interested listener.
+  notifyListeners(*entry->second, key);
+  // 3. Call each batch listener with just this key - viewed in place, without copying it into a vector.
+  notifyBatchListeners(*entry->second, std::span<const std::string>(&key, 1));
+}
+
+void MMKVValueChangedListenerRegistry::notifyOnValuesChanged(const std::string& mmkvID, const std::vector<std::string>& keys) {
+  if (keys.empty()) {
+    return;
+  }
+  // 1. Get all listeners for the specific MMKV ID (only once for all keys)
+  auto snapshot = loadSnapshot();
+  auto entry = snapshot->find(mmkvID);
+  if (entry == snapshot->end()) {
     // There are no listeners. Return
     return;
   }
-  // 2. Call each listener.
-  auto& listeners = entry->second;
-  for (const auto& listener : listeners) {
-    listener.callback(key);
+  // 2. Call each interested listener for each key.
+  for (const auto& key : keys) {
+    notifyListeners(*entry->second, key);
   }
+  // 3. Call each batch listener only once, with all keys.
+  notifyBatchListeners(*entry->second, keys);
 }
 
 } // namespace margelo::nitro::mmkv
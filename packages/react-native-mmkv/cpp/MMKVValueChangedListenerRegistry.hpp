@@ -5,23 +5,87 @@
 //  Created by Marc Rousavy on 21.08.2025.
 //
 
-#include "MMKVTypes.hpp"
+#pragma once
+
+#include <array>
 #include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace margelo::nitro::mmkv {
 
 using ListenerID = size_t;
 using MMKVID = std::string;
+using ListenerCallback = std::function<void(const std::string& /* key */)>;
+using BatchListenerCallback = std::function<void(std::span<const std::string> /* keys */)>;
 
 struct ListenerSubscription {
   ListenerID id;
-  std::function<void(const std::string& /* key */)> callback;
+  std::shared_ptr<const ListenerCallback> callback;
 };
 
+struct BatchListenerSubscription {
+  ListenerID id;
+  std::shared_ptr<const BatchListenerCallback> callback;
+};
+
+struct PrefixListenerSubscription {
+  ListenerID id;
+  std::string prefix;
+  std::shared_ptr<const ListenerCallback> callback;
+};
+
+template <typename T>
+using ListenerBucket = std::shared_ptr<const std::vector<T>>;
+using KeyListenerShard = std::unordered_map<std::string, std::vector<ListenerSubscription>>;
+
+/**
+ * All listeners of a single MMKV instance.
+ * Key-scoped listeners are indexed by their key, so notifying
+ * a change only calls listeners that are interested in that key.
+ *
+ * Each kind of listener lives in its own immutable bucket, and key-scoped listeners are spread
+ * across a fixed number of shards by the hash of their key. Copying this struct only copies
+ * pointers, so adding or removing a listener only has to copy the one bucket or shard it touches.
+ */
+struct InstanceListeners {
+  static constexpr size_t KEY_SHARDS_COUNT = 64;
+
+  // Listeners for all keys
+  ListenerBucket<ListenerSubscription> all;
+  // Listeners for one specific key, indexed by the key, in the shard at `hash(key) % KEY_SHARDS_COUNT`
+  std::array<std::shared_ptr<const KeyListenerShard>, KEY_SHARDS_COUNT> byKey;
+  // Listeners for all keys that start with a given prefix
+  ListenerBucket<PrefixListenerSubscription> byPrefix;
+  // Listeners for all keys that are called once per change with all of its keys
+  ListenerBucket<BatchListenerSubscription> batches;
+  // The number of listeners in all buckets and shards
+  size_t count = 0;
+
+  static size_t getShardIndex(const std::string& key) {
+    return std::hash<std::string>{}(key) % KEY_SHARDS_COUNT;
+  }
+};
+
+using ListenersSnapshot = std::unordered_map<MMKVID, std::shared_ptr<const InstanceListeners>>;
+
 /**
  * Listeners are tracked across instances - so we need an extra static class for
  * the registry.
+ *
+ * The registry is thread-safe: Listeners are stored in an immutable snapshot which is
+ * atomically swapped out (copy-on-write) whenever a listener is added or removed.
+ * Notifying never takes the writers' lock and does not allocate, it just iterates the snapshot
+ * that was current when it started. Loading the snapshot is not lock-free though - the
+ * `std::atomic_load` overloads for `std::shared_ptr` briefly take a spinlock from a global pool
+ * in both libc++ and libstdc++. A listener may safely add or remove listeners (including itself)
+ * while it is being called, and a listener that is removed while a notification is
+ * in-flight on another thread may still receive that one last notification.
  */
 class MMKVValueChangedListenerRegistry final {
 public:
@@ -29,15 +93,37 @@ public:
   ~MMKVValueChangedListenerRegistry() = delete;
 
 public:
-  static ListenerID addListener(const std::string& mmkvID, const std::function<void(const std::string& /* key */)>& callback);
+  static ListenerID addListener(const std::string& mmkvID, const ListenerCallback& callback);
+  static ListenerID addKeyListener(const std::string& mmkvID, const std::string& key, const ListenerCallback& callback);
+  static ListenerID addPrefixListener(const std::string& mmkvID, const std::string& prefix, const ListenerCallback& callback);
+  /**
+   * Adds a listener for all keys that is called only once for all keys that changed together
+   * (e.g. in a write batch), instead of once per key.
+   */
+  static ListenerID addBatchListener(const std::string& mmkvID, const BatchListenerCallback& callback);
   static void removeListener(const std::string& mmkvID, ListenerID id);
+  /**
+   * Gets the number of listeners (of any kind) that are currently added for the given MMKV instance.
+   */
+  static size_t getListenerCount(const std::string& mmkvID);
 
 public:
   static void notifyOnValueChanged(const std::string& mmkvID, const std::string& key);
+  static void notifyOnValuesChanged(const std::string& mmkvID, const std::vector<std::string>& keys);
+
+private:
+  static void notifyListeners(const InstanceListeners& listeners, const std::string& key);
+  static void notifyBatchListeners(const InstanceListeners& listeners, std::span<const std::string> keys);
+  static std::shared_ptr<const ListenersSnapshot> loadSnapshot();
+  static void updateListeners(const std::string& mmkvID, const std::function<void(InstanceListeners& listeners)>& update);
 
 private:
   static std::atomic<ListenerID> _listenersCounter;
-  static std::unordered_map<MMKVID, std::vector<ListenerSubscription>> _listeners;
+  // Serializes writers (add/remove). Readers never take this lock.
+  static std::mutex _writeMutex;
+  static std::shared_ptr<const ListenersSnapshot> _snapshot;
+  // The key of each key-scoped listener, used for removal. Only accessed by writers.
+  static std::unordered_map<ListenerID, std::string> _keyOfListener;
 };
 
 } // namespace margelo::nitro::mmkv
@@ -0,0 +1,423 @@
+//
+//  ContentionBenchmarks.cpp
+//  react-native-mmkv
+//
+
+// Drives one shared `HybridMMKV` instance from N threads (or, with `--mode=processes`, from N forked
+// processes on a `MULTI_PROCESS` instance) with a mix of reads and writes, and reports how throughput,
+// latency and the time spent waiting for MMKV's lock scale with N.
+// Only built if MMKV core, Nitro and JSI were found, see `CMakeLists.txt`.
+//
+// Options:
+// - `--mode=threads|processes` (default: threads)
+// - `--workers=1,2,4,8,16,32`: The worker counts to run, one after another
+// - `--read-ratio=0.9`: The share of operations that are reads, the others are writes
+// - `--keys=10000`: The number of distinct keys
+// - `--zipf=0.99`: The skew of the key distribution (0 is uniform, values close to 1 have a few very hot keys)
+// - `--value-size=64`: The size of the written string values, in bytes
+// - `--duration-ms=2000`: How long every worker count runs
+// - `--lock-probe-interval=16`: Measures the lock wait time of every Nth operation (0 disables it).
+//   Probed reads take the exclusive lock, which in `processes` mode slightly overstates contention.
+
+#include "HybridMMKV.hpp"
+#include "LatencyHistogram.hpp"
+#include "MMKVBenchmark.hpp"
+#include "MMKVTypes.hpp"
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <latch>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+using namespace margelo::nitro;
+using namespace margelo::nitro::mmkv;
+using namespace margelo::nitro::mmkv::benchmark;
+
+namespace {
+
+enum class WorkerMode { THREADS, PROCESSES };
+
+struct Workload {
+  WorkerMode mode;
+  std::vector<size_t> workerCounts;
+  double readRatio;
+  size_t keyCount;
+  double zipfTheta;
+  size_t valueSize;
+  std::chrono::milliseconds duration;
+  size_t lockProbeInterval;
+};
+
+struct WorkerResult {
+  LatencyHistogram reads;
+  LatencyHistogram writes;
+  LatencyHistogram lockWaits;
+  std::chrono::nanoseconds elapsed{0};
+};
+static_assert(std::is_trivially_copyable_v<WorkerResult>, "WorkerResult is sent through a pipe!");
+
+/**
+ * Picks keys following a Zipfian distribution, like YCSB does (Gray et al., "Quickly Generating
+ * Billion-Record Synthetic Databases"). Key 0 is the hottest one. A theta of 0 is uniform.
+ */
+class KeyDistribution final {
+public:
+  KeyDistribution(size_t keyCount, double theta) : _keyCount(keyCount), _theta(theta) {
+    if (keyCount < 2 || theta < 0.0 || theta >= 1.0) [[unlikely]] {
+      throw std::runtime_error("`--keys` must be at least 2, and `--zipf` must be in [0, 1)!");
+    }
+    _zetaN = getZeta(keyCount, theta);
+    double zeta2 = getZeta(2, theta);
+    _alpha = 1.0 / (1.0 - theta);
+    _eta = (1.0 - std::pow(2.0 / static_cast<double>(keyCount), 1.0 - theta)) / (1.0 - zeta2 / _zetaN);
+  }
+
+  size_t operator()(std::mt19937_64& random) const {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+    if (_theta == 0.0) {
+      return std::min(static_cast<size_t>(u * static_cast<double>(_keyCount)), _keyCount - 1);
+    }
+    double uz = u * _zetaN;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, _theta)) {
+      return 1;
+    }
+    auto index = static_cast<size_t>(static_cast<double>(_keyCount) * std::pow(_eta * u - _eta + 1.0, _alpha));
+    return std::min(index, _keyCount - 1);
+  }
+
+private:
+  static double getZeta(size_t count, double theta) {
+    double zeta = 0.0;
+    for (size_t i = 1; i <= count; i++) {
+      zeta += 1.0 / std::pow(static_cast<double>(i), theta);
+    }
+    return zeta;
+  }
+
+private:
+  size_t _keyCount;
+  double _theta;
+  double _zetaN;
+  double _alpha;
+  double _eta;
+};
+
+using Value = std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>;
+
+class ContentionBenchmark final {
+public:
+  ContentionBenchmark(Workload workload, std::string rootPath)
+      : _workload(std::move(workload)), _rootPath(std::move(rootPath)), _distribution(_workload.keyCount, _workload.zipfTheta),
+        _value(createJSONValue(_workload.valueSize)) {
+    for (size_t i = 0; i < _workload.keyCount; i++) {
+      _keys.push_back(createKey(16, i));
+    }
+  }
+
+public:
+  void run(BenchmarkRunner& runner) {
+    if (_workload.mode == WorkerMode::THREADS) {
+      auto mmkv = openInstance();
+      populate(*mmkv);
+      for (size_t workerCount : _workload.workerCounts) {
+        if (runner.shouldRun("contention", getParameters(workerCount))) {
+          report(runner, workerCount, runThreads(*mmkv, workerCount));
+        }
+      }
+    } else {
+      // Workers must open the instance themselves, as MMKV's file locks would be shared with a forked parent
+      runInChildProcesses(1, [this](WorkerResult&) { populate(*openInstance()); });
+      for (size_t workerCount : _workload.workerCounts) {
+        if (runner.shouldRun("contention", getParameters(workerCount))) {
+          report(runner, workerCount, runInChildProcesses(workerCount, [this](WorkerResult& result) {
+                   auto mmkv = openInstance();
+                   runWorker(*mmkv, getLockProbe(), /* seed */ getpid(), result);
+                 }));
+        }
+      }
+    }
+  }
+
+private:
+  std::string getId() const {
+    return _workload.mode == WorkerMode::THREADS ? "contention-threads" : "contention-processes";
+  }
+
+  std::shared_ptr<HybridMMKV> openInstance() {
+    Configuration config;
+    config.id = getId();
+    config.path = _rootPath;
+    config.mode = _workload.mode == WorkerMode::THREADS ? Mode::SINGLE_PROCESS : Mode::MULTI_PROCESS;
+    auto mmkv = std::make_shared<HybridMMKV>(config, _threadPool);
+    mmkv->open();
+    return mmkv;
+  }
+
+  /**
+   * Gets the `MMKV*` that `openInstance()` opened (MMKV caches instances by ID and path), whose lock
+   * is taken right before an operation to measure how long it waits.
+   * MMKV's lock is recursive, so the operation itself then does not wait again.
+   */
+  MMKV* getLockProbe() {
+    if (_workload.lockProbeInterval == 0) {
+      return nullptr;
+    }
+    MMKVMode mode = _workload.mode == WorkerMode::THREADS ? ::mmkv::MMKV_SINGLE_PROCESS : ::mmkv::MMKV_MULTI_PROCESS;
+    return MMKV::mmkvWithID(getId(), MMKVConfig{.mode = mode, .rootPath = &_rootPath});
+  }
+
+  void populate(HybridMMKV& mmkv) {
+    mmkv.clearAll();
+    Value value = _value;
+    for (const auto& key : _keys) {
+      mmkv.set(key, value, std::nullopt);
+    }
+  }
+
+  void runWorker(HybridMMKV& mmkv, MMKV* lockProbe, uint64_t seed, WorkerResult& result) const {
+    std::mt19937_64 random(seed);
+    std::uniform_real_distribution<double> operationDistribution(0.0, 1.0);
+    Value value = _value;
+
+    auto start = std::chrono::steady_clock::now();
+    auto deadline = start + _workload.duration;
+    auto now = start;
+    for (size_t i = 0; now < deadline; i++) {
+      const std::string& key = _keys[_distribution(random)];
+      bool isRead = operationDistribution(random) < _workload.readRatio;
+      bool isProbed = lockProbe != nullptr && i % _workload.lockProbeInterval == 0;
+
+      auto operationStart = std::chrono::steady_clock::now();
+      if (isProbed) {
+        lockProbe->lock();
+        result.lockWaits.record(std::chrono::steady_clock::now() - operationStart);
+      }
+      if (isRead) {
+        doNotOptimize(mmkv.getString(key));
+      } else {
+        mmkv.set(key, value, std::nullopt);
+      }
+      if (isProbed) {
+        lockProbe->unlock();
+      }
+      now = std::chrono::steady_clock::now();
+      (isRead ? result.reads : result.writes).record(now - operationStart);
+    }
+    result.elapsed = now - start;
+  }
+
+  std::vector<WorkerResult> runThreads(HybridMMKV& mmkv, size_t workerCount) {
+    std::vector<WorkerResult> results(workerCount);
+    std::latch start(static_cast<std::ptrdiff_t>(workerCount));
+    MMKV* lockProbe = getLockProbe();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < workerCount; i++) {
+      threads.emplace_back([&, i]() {
+        start.arrive_and_wait();
+        runWorker(mmkv, lockProbe, /* seed */ i + 1, results[i]);
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    return results;
+  }
+
+  /**
+   * Forks `workerCount` processes that all start `work` at the same time, and collects their results.
+   */
+  static std::vector<WorkerResult> runInChildProcesses(size_t workerCount, const std::function<void(WorkerResult&)>& work) {
+    int startPipe[2];
+    if (pipe(startPipe) != 0) [[unlikely]] {
+      throw std::runtime_error("Failed to create a pipe!");
+    }
+    std::vector<pid_t> children;
+    std::vector<int> resultPipes;
+    for (size_t i = 0; i < workerCount; i++) {
+      int resultPipe[2];
+      if (pipe(resultPipe) != 0) [[unlikely]] {
+        throw std::runtime_error("Failed to create a pipe!");
+      }
+      pid_t pid = fork();
+      if (pid < 0) [[unlikely]] {
+        throw std::runtime_error("Failed to fork a worker process!");
+      }
+      if (pid == 0) {
+        // Child: wait until the parent closes the start pipe, then work
+        close(startPipe[1]);
+        close(resultPipe[0]);
+        char byte;
+        while (read(startPipe[0], &byte, 1) < 0 && errno == EINTR) {
+        }
+        WorkerResult result;
+        int exitCode = 0;
+        try {
+          work(result);
+        } catch (const std::exception& exception) {
+          std::fprintf(stderr, "Worker failed: %s\n", exception.what());
+          exitCode = 1;
+        }
+        bool didWrite = write(resultPipe[1], &result, sizeof(result)) == static_cast<ssize_t>(sizeof(result));
+        // Skip destructors and atexit handlers of the parent's state
+        _exit(didWrite ? exitCode : 1);
+      }
+      close(resultPipe[1]);
+      children.push_back(pid);
+      resultPipes.push_back(resultPipe[0]);
+    }
+    close(startPipe[0]);
+    // Wakes up all children at once
+    close(startPipe[1]);
+
+    std::vector<WorkerResult> results(workerCount);
+    bool didFail = false;
+    for (size_t i = 0; i < workerCount; i++) {
+      auto* bytes = reinterpret_cast<char*>(&results[i]);
+      size_t received = 0;
+      while (received < sizeof(WorkerResult)) {
+        ssize_t count = read(resultPipes[i], bytes + received, sizeof(WorkerResult) - received);
+        if (count <= 0) {
+          break;
+        }
+        received += static_cast<size_t>(count);
+      }
+      close(resultPipes[i]);
+      int status = 0;
+      waitpid(children[i], &status, 0);
+      didFail |= received != sizeof(WorkerResult) || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    if (didFail) [[unlikely]] {
+      throw std::runtime_error("A worker process failed!");
+    }
+    return results;
+  }
+
+  Parameters getParameters(size_t workerCount) const {
+    char readRatio[16];
+    std::snprintf(readRatio, sizeof(readRatio), "%g", _workload.readRatio);
+    char zipf[16];
+    std::snprintf(zipf, sizeof(zipf), "%g", _workload.zipfTheta);
+    return {
+        {"mode", _workload.mode == WorkerMode::THREADS ? "threads" : "processes"},
+        {"workers", std::to_string(workerCount)},
+        {"readRatio", readRatio},
+        {"keys", std::to_string(_workload.keyCount)},
+        {"zipf", zipf},
+        {"valueSize", std::to_string(_workload.valueSize)},
+    };
+  }
+
+  void report(BenchmarkRunner& runner, size_t workerCount, const std::vector<WorkerResult>& results) const {
+    LatencyHistogram all;
+    LatencyHistogram reads;
+    LatencyHistogram writes;
+    LatencyHistogram lockWaits;
+    double opsPerSecond = 0.0;
+    for (const auto& result : results) {
+      reads.merge(result.reads);
+      writes.merge(result.writes);
+      lockWaits.merge(result.lockWaits);
+      uint64_t operations = result.reads.getCount() + result.writes.getCount();
+      opsPerSecond += static_cast<double>(operations) * 1e9 / static_cast<double>(std::max<int64_t>(result.elapsed.count(), 1));
+    }
+    all.merge(reads);
+    all.merge(writes);
+
+    BenchmarkResult result{
+        .name = "contention",
+        .parameters = getParameters(workerCount),
+        .iterations = all.getCount(),
+        .samples = all.getCount(),
+        .meanNanoseconds = all.getMean(),
+        .p50Nanoseconds = all.getPercentile(0.50),
+        .p99Nanoseconds = all.getPercentile(0.99),
+        .p999Nanoseconds = all.getPercentile(0.999),
+        .minNanoseconds = all.getMin(),
+        .opsPerSecond = opsPerSecond,
+        .bytesPerOperation = 0,
+        .metrics =
+            {
+                {"readP50Ns", reads.getPercentile(0.50)},
+                {"readP99Ns", reads.getPercentile(0.99)},
+                {"readP999Ns", reads.getPercentile(0.999)},
+                {"writeP50Ns", writes.getPercentile(0.50)},
+                {"writeP99Ns", writes.getPercentile(0.99)},
+                {"writeP999Ns", writes.getPercentile(0.999)},
+            },
+    };
+    if (lockWaits.getCount() > 0) {
+      result.metrics.emplace_back("lockWaitMeanNs", lockWaits.getMean());
+      result.metrics.emplace_back("lockWaitP99Ns", lockWaits.getPercentile(0.99));
+      result.metrics.emplace_back("lockWaitP999Ns", lockWaits.getPercentile(0.999));
+      // The share of an operation's time that is spent waiting for the lock
+      result.metrics.emplace_back("lockWaitRatio", lockWaits.getMean() / all.getMean());
+    }
+    runner.addResult(std::move(result));
+  }
+
+private:
+  Workload _workload;
+  std::string _rootPath;
+  KeyDistribution _distribution;
+  std::string _value;
+  std::vector<std::string> _keys;
+  std::shared_ptr<MMKVThreadPool> _threadPool = std::make_shared<MMKVThreadPool>(/* maxThreads */ 2);
+};
+
+std::vector<size_t> parseList(const std::string& list) {
+  std::vector<size_t> values;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t end = std::min(list.find(',', start), list.size());
+    values.push_back(std::stoul(list.substr(start, end - start)));
+    start = end + 1;
+  }
+  return values;
+}
+
+Workload parseWorkload(const BenchmarkOptions& options) {
+  std::string mode = options.getExtraOption("mode", "threads");
+  if (mode != "threads" && mode != "processes") [[unlikely]] {
+    throw std::runtime_error("`--mode` must be either \"threads\" or \"processes\"! (Received: " + mode + ")");
+  }
+  return Workload{
+      .mode = mode == "threads" ? WorkerMode::THREADS : WorkerMode::PROCESSES,
+      .workerCounts = parseList(options.getExtraOption("workers", options.isQuick ? "1,2,4,8" : "1,2,4,8,16,32")),
+      .readRatio = std::stod(options.getExtraOption("read-ratio", "0.9")),
+      .keyCount = std::stoul(options.getExtraOption("keys", options.isQuick ? "1000" : "10000")),
+      .zipfTheta = std::stod(options.getExtraOption("zipf", "0.99")),
+      .valueSize = std::stoul(options.getExtraOption("value-size", "64")),
+      .duration = std::chrono::milliseconds(std::stoul(options.getExtraOption("duration-ms", options.isQuick ? "300" : "2000"))),
+      .lockProbeInterval = std::stoul(options.getExtraOption("lock-probe-interval", "16")),
+  };
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  auto rootPath = std::filesystem::temp_directory_path() / ("mmkv-contention-" + std::to_string(getpid()));
+  std::filesystem::create_directories(rootPath);
+  MMKV::initializeMMKV(rootPath.string(), MMKVLogNone);
+
+  int exitCode = runBenchmarkSuite(
+      argc, argv, "contention",
+      [&](BenchmarkRunner& runner) {
+        ContentionBenchmark benchmark(parseWorkload(runner.getOptions()), rootPath.string());
+        benchmark.run(runner);
+      },
+      {"mode", "workers", "read-ratio", "keys", "zipf", "value-size", "duration-ms", "lock-probe-interval"});
+
+  std::filesystem::remove_all(rootPath);
+  return exitCode;
+}
@@ -0,0 +1,123 @@
+//
+//  CoreBenchmarks.cpp
+//  react-native-mmkv
+//
+
+// Benchmarks of the shared C++ building blocks that don't need MMKV core, Nitro or JSI,
+// so they can always be built and run on a host.
+
+#include "MMKVBenchmark.hpp"
+#include "MMKVCompression.hpp"
+#include "MMKVStatsRecorder.hpp"
+#include "MMKVTracer.hpp"
+#include "MMKVValueChangedListenerRegistry.hpp"
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+using namespace margelo::nitro::mmkv::benchmark;
+using namespace std::chrono_literals;
+
+static std::vector<size_t> getValueSizes(const BenchmarkRunner& runner) {
+  if (runner.isQuick()) {
+    return {64, 1024, 64 * 1024, 1024 * 1024};
+  }
+  return {64, 1024, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024};
+}
+
+static void benchmarkListenerFanOut(BenchmarkRunner& runner) {
+  for (size_t listenerCount : {0, 1, 10, 100, 1000}) {
+    std::string mmkvID = "fan-out-" + std::to_string(listenerCount);
+    size_t calls = 0;
+    std::vector<ListenerID> listeners;
+    for (size_t i = 0; i < listenerCount; i++) {
+      listeners.push_back(MMKVValueChangedListenerRegistry::addListener(mmkvID, [&calls](const std::string&) { calls++; }));
+    }
+    std::string key = "key";
+    runner.run("listeners/notify", {{"listeners", std::to_string(listenerCount)}},
+               [&]() { MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, key); });
+    doNotOptimize(calls);
+    for (ListenerID id : listeners) {
+      MMKVValueChangedListenerRegistry::removeListener(mmkvID, id);
+    }
+  }
+}
+
+static void benchmarkKeyListenerLookup(BenchmarkRunner& runner) {
+  // Many key-scoped listeners on other keys should not slow down notifying one key
+  for (size_t listenerCount : {1, 100, 10000}) {
+    std::string mmkvID = "key-listeners-" + std::to_string(listenerCount);
+    size_t calls = 0;
+    std::vector<ListenerID> listeners;
+    for (size_t i = 0; i < listenerCount; i++) {
+      listeners.push_back(
+          MMKVValueChangedListenerRegistry::addKeyListener(mmkvID, createKey(16, i), [&calls](const std::string&) { calls++; }));
+    }
+    std::string key = createKey(16, 0);
+    runner.run("listeners/notifyKey", {{"keyListeners", std::to_string(listenerCount)}},
+               [&]() { MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, key); });
+    doNotOptimize(calls);
+    for (ListenerID id : listeners) {
+      MMKVValueChangedListenerRegistry::removeListener(mmkvID, id);
+    }
+  }
+}
+
+static void benchmarkCompression(BenchmarkRunner& runner) {
+  for (size_t valueSize : getValueSizes(runner)) {
+    Parameters parameters = {{"valueSize", std::to_string(valueSize)}};
+    if (!runner.shouldRun("compression/encode", parameters) && !runner.shouldRun("compression/decode", parameters)) {
+      continue;
+    }
+    std::string value = createJSONValue(valueSize);
+    runner.run("compression/encode", parameters,
+               [&]() { return MMKVCompression::encode(value.data(), value.size(), MMKVCompression::Codec::LZ4, 0); }, valueSize);
+
+    auto encoded = MMKVCompression::encode(value.data(), value.size(), MMKVCompression::Codec::LZ4, 0);
+    if (!encoded.has_value()) {
+      continue;
+    }
+    std::string decoded(valueSize, '\0');
+    runner.run("compression/decode", parameters, [&]() { MMKVCompression::decode(encoded->data(), encoded->size(), decoded.data()); },
+               valueSize);
+  }
+}
+
+static void benchmarkStats(BenchmarkRunner& runner) {
+  if constexpr (MMKVStatsRecorder::IS_ENABLED) {
+    MMKVStatsRecorder recorder;
+    runner.run("stats/record", {}, [&]() { recorder.record(MMKVOperation::GET, 100ns); });
+    runner.run("stats/operationTimer", {}, [&]() { MMKVOperationTimer timer(&recorder, MMKVOperation::SET); });
+  }
+}
+
+namespace {
+
+class NoOpTraceSink final : public MMKVTraceSink {
+public:
+  void beginEvent(const MMKVTraceEvent&) override {}
+  void endEvent(const MMKVTraceEvent& event) override {
+    doNotOptimize(event.duration);
+  }
+};
+
+} // namespace
+
+static void benchmarkTracer(BenchmarkRunner& runner) {
+  std::string instanceId = "benchmark";
+  MMKVTracer::setSink(nullptr);
+  runner.run("tracer/scope", {{"enabled", "false"}}, [&]() { MMKVTraceScope trace("getString", instanceId, 3); });
+  MMKVTracer::setSink(std::make_shared<NoOpTraceSink>());
+  runner.run("tracer/scope", {{"enabled", "true"}}, [&]() { MMKVTraceScope trace("getString", instanceId, 3); });
+  MMKVTracer::setSink(nullptr);
+}
+
+int main(int argc, char** argv) {
+  return runBenchmarkSuite(argc, argv, "core", [](BenchmarkRunner& runner) {
+    benchmarkListenerFanOut(runner);
+    benchmarkKeyListenerLookup(runner);
+    benchmarkCompression(runner);
+    benchmarkStats(runner);
+    benchmarkTracer(runner);
+  });
+}
@@ -0,0 +1,334 @@
+//
+//  HybridMMKVBenchmarks.cpp
+//  react-native-mmkv
+//
+
+// End-to-end benchmarks of `HybridMMKV` on top of the real MMKV core, measured right below the JSI boundary.
+// Only built if MMKV core, Nitro and JSI were found, see `CMakeLists.txt`.
+
+#include "HybridMMKV.hpp"
+#include "MMKVBenchmark.hpp"
+#include "MMKVTypes.hpp"
+#include <NitroModules/ArrayBuffer.hpp>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace margelo::nitro;
+using namespace margelo::nitro::mmkv;
+using namespace margelo::nitro::mmkv::benchmark;
+
+namespace {
+
+struct Encryption {
+  const char* name;
+  std::optional<std::string> key;
+  std::optional<EncryptionType> type;
+};
+
+const std::vector<Encryption> ENCRYPTIONS = {
+    {"plain", std::nullopt, std::nullopt},
+    {"aes128", "0123456789abcdef", EncryptionType::AES_128},
+    {"aes256", "0123456789abcdef0123456789abcdef", EncryptionType::AES_256},
+};
+
+struct NamedSyncPolicy {
+  const char* name;
+  SyncPolicy policy;
+};
+
+const std::vector<NamedSyncPolicy> SYNC_POLICIES = {
+    {"os", SyncPolicy::OS},
+    {"periodic", SyncPolicy::PERIODIC},
+    {"every-write", SyncPolicy::EVERY_WRITE},
+    {"every-batch", SyncPolicy::EVERY_BATCH},
+};
+
+class InstanceFactory final {
+public:
+  explicit InstanceFactory(std::string rootPath) : _rootPath(std::move(rootPath)) {}
+
+  /**
+   * Creates a new, empty instance.
+   */
+  std::shared_ptr<HybridMMKV> create(const std::string& id, const Encryption& encryption = ENCRYPTIONS[0],
+                                     std::optional<bool> compareBeforeSet = std::nullopt) {
+    Configuration config;
+    config.id = id;
+    config.encryptionKey = encryption.key;
+    config.encryptionType = encryption.type;
+    config.compareBeforeSet = compareBeforeSet;
+    return create(std::move(config));
+  }
+  /**
+   * Creates a new, empty instance with the given configuration (its `path` is ignored).
+   */
+  std::shared_ptr<HybridMMKV> create(Configuration config) {
+    config.path = _rootPath;
+    auto mmkv = std::make_shared<HybridMMKV>(config, _threadPool);
+    mmkv->clearAll();
+    return mmkv;
+  }
+
+private:
+  std::string _rootPath;
+  std::shared_ptr<MMKVThreadPool> _threadPool = std::make_shared<MMKVThreadPool>(/* maxThreads */ 2);
+};
+
+} // namespace
+
+using Value = std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>;
+
+static std::vector<size_t> getValueSizes(const BenchmarkRunner& runner) {
+  if (runner.isQuick()) {
+    return {8, 64, 1024, 64 * 1024, 1024 * 1024};
+  }
+  return {8, 64, 1024, 64 * 1024, 1024 * 1024, 8 * 1024 * 1024};
+}
+
+static std::shared_ptr<ArrayBuffer> createBuffer(size_t size) {
+  std::string value = createJSONValue(size);
+  return ArrayBuffer::copy(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+}
+
+static void benchmarkPrimitives(BenchmarkRunner& runner, InstanceFactory& factory) {
+  auto mmkv = factory.create("primitives");
+  std::string key = createKey(16, 0);
+
+  Value boolean = true;
+  runner.run("set/boolean", {}, [&]() { mmkv->set(key, boolean, std::nullopt); });
+  runner.run("get/boolean", {}, [&]() { return mmkv->getBoolean(key); });
+
+  Value number = 42.5;
+  runner.run("set/number", {}, [&]() { mmkv->set(key, number, std::nullopt); });
+  runner.run("get/number", {}, [&]() { return mmkv->getNumber(key); });
+}
+
+static void benchmarkValueSizes(BenchmarkRunner& runner, InstanceFactory& factory) {
+  auto mmkv = factory.create("value-sizes");
+  std::string key = createKey(16, 0);
+  for (size_t valueSize : getValueSizes(runner)) {
+    Parameters parameters = {{"valueSize", std::to_string(valueSize)}};
+    if (runner.shouldRun("set/string", parameters) || runner.shouldRun("get/string", parameters)) {
+      Value string = createJSONValue(valueSize);
+      runner.run("set/string", parameters, [&]() { mmkv->set(key, string, std::nullopt); }, valueSize);
+      runner.run("get/string", parameters, [&]() { return mmkv->getString(key); }, valueSize);
+    }
+    if (runner.shouldRun("set/buffer", parameters) || runner.shouldRun("get/buffer", parameters) ||
+        runner.shouldRun("get/bufferInto", parameters)) {
+      Value buffer = createBuffer(valueSize);
+      runner.run("set/buffer", parameters, [&]() { mmkv->set(key, buffer, std::nullopt); }, valueSize);
+      runner.run("get/buffer", parameters, [&]() { return mmkv->getBuffer(key); }, valueSize);
+      // Reuses one target buffer, so this only measures the copy out of the mmap
+      auto target = ArrayBuffer::allocate(valueSize);
+      runner.run("get/bufferInto", parameters, [&]() { return mmkv->getBufferInto(key, target); }, valueSize);
+    }
+    // Keeps the file from growing to the sum of all value sizes
+    mmkv->clearAll();
+  }
+}
+
+static void benchmarkKeyLengths(BenchmarkRunner& runner, InstanceFactory& factory) {
+  auto mmkv = factory.create("key-lengths");
+  Value value = createJSONValue(64);
+  for (size_t keyLength : {8, 64, 512}) {
+    Parameters parameters = {{"keyLength", std::to_string(keyLength)}};
+    std::string key = createKey(keyLength, 0);
+    runner.run("set/string", parameters, [&]() { mmkv->set(key, value, std::nullopt); });
+    runner.run("get/string", parameters, [&]() { return mmkv->getString(key); });
+  }
+}
+
+static void benchmarkEncryption(BenchmarkRunner& runner, InstanceFactory& factory) {
+  std::string key = createKey(16, 0);
+  for (const Encryption& encryption : ENCRYPTIONS) {
+    auto mmkv = factory.create(std::string("encryption-") + encryption.name, encryption);
+    for (size_t valueSize : {64, 64 * 1024}) {
+      Parameters parameters = {{"encryption", encryption.name}, {"valueSize", std::to_string(valueSize)}};
+      Value value = createJSONValue(valueSize);
+      runner.run("set/string", parameters, [&]() { mmkv->set(key, value, std::nullopt); }, valueSize);
+      runner.run("get/string", parameters, [&]() { return mmkv->getString(key); }, valueSize);
+    }
+  }
+}
+
+static void benchmarkCompareBeforeSet(BenchmarkRunner& runner, InstanceFactory& factory) {
+  std::string key = createKey(16, 0);
+  std::string json = createJSONValue(1024);
+  Value value = json;
+  // Same size, different content - so comparing has to look at the whole value
+  Value otherValue = json.substr(0, json.size() - 1) + "!";
+  for (bool compareBeforeSet : {false, true}) {
+    auto mmkv = factory.create(compareBeforeSet ? "compare-before-set-on" : "compare-before-set-off", ENCRYPTIONS[0], compareBeforeSet);
+    std::string isEnabled = compareBeforeSet ? "true" : "false";
+    runner.run("set/string/unchanged", {{"compareBeforeSet", isEnabled}}, [&]() { mmkv->set(key, value, std::nullopt); });
+    bool isOther = false;
+    runner.run("set/string/changed", {{"compareBeforeSet", isEnabled}}, [&]() {
+      isOther = !isOther;
+      mmkv->set(key, isOther ? otherValue : value, std::nullopt);
+    });
+  }
+}
+
+static void benchmarkGetAllKeys(BenchmarkRunner& runner, InstanceFactory& factory) {
+  std::vector<size_t> keyCounts = {1'000, 10'000, 100'000, 1'000'000};
+  if (runner.isQuick()) {
+    keyCounts.pop_back();
+  }
+  auto mmkv = factory.create("get-all-keys");
+  Value value = 1.0;
+  size_t keyCount = 0;
+  for (size_t targetKeyCount : keyCounts) {
+    Parameters parameters = {{"keys", std::to_string(targetKeyCount)}};
+    if (!runner.shouldRun("getAllKeys", parameters)) {
+      continue;
+    }
+    // Each step only adds the keys that are missing
+    for (; keyCount < targetKeyCount; keyCount++) {
+      mmkv->set(createKey(16, keyCount), value, std::nullopt);
+    }
+    runner.run("getAllKeys", parameters, [&]() { return mmkv->getAllKeys(); });
+  }
+}
+
+static void benchmarkSyncPolicies(BenchmarkRunner& runner, InstanceFactory& factory) {
+  Value value = createJSONValue(64);
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 10; i++) {
+    keys.push_back(createKey(16, i));
+  }
+  for (const NamedSyncPolicy& syncPolicy : SYNC_POLICIES) {
+    Parameters parameters = {{"syncPolicy", syncPolicy.name}};
+    if (!runner.shouldRun("set/string/sync", parameters)) {
+      continue;
+    }
+    Configuration config;
+    config.id = std::string("sync-") + syncPolicy.name;
+    config.syncPolicy = syncPolicy.policy;
+    auto mmkv = factory.create(std::move(config));
+    size_t i = 0;
+    runner.run("set/string/sync", parameters, [&]() { mmkv->set(keys[i++ % keys.size()], value, std::nullopt); });
+  }
+}
+
+static void benchmarkAccessTracking(BenchmarkRunner& runner, InstanceFactory& factory) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 100; i++) {
+    keys.push_back(createKey(16, i));
+  }
+  // `maxEntries` turns on per-read access tracking for the LRU eviction
+  for (std::optional<double> maxEntries : {std::optional<double>(), std::optional<double>(10000)}) {
+    Parameters parameters = {{"maxEntries", maxEntries.has_value() ? std::to_string(static_cast<size_t>(*maxEntries)) : "none"}};
+    if (!runner.shouldRun("get/string/tracked", parameters)) {
+      continue;
+    }
+    Configuration config;
+    config.id = maxEntries.has_value() ? "access-tracking-on" : "access-tracking-off";
+    config.maxEntries = maxEntries;
+    auto mmkv = factory.create(std::move(config));
+    for (const auto& key : keys) {
+      mmkv->set(key, createJSONValue(64), std::nullopt);
+    }
+    size_t i = 0;
+    runner.run("get/string/tracked", parameters, [&]() { return mmkv->getString(keys[i++ % keys.size()]); });
+  }
+}
+
+static void benchmarkListenerFanOut(BenchmarkRunner& runner, InstanceFactory& factory) {
+  auto mmkv = factory.create("listener-fan-out");
+  std::string key = createKey(16, 0);
+  Value value = 1.0;
+  for (size_t listenerCount : {0, 1, 10, 100, 1000}) {
+    size_t calls = 0;
+    std::vector<Listener> listeners;
+    for (size_t i = 0; i < listenerCount; i++) {
+      listeners.push_back(mmkv->addOnValueChangedListener([&calls](const std::string&) { calls++; }));
+    }
+    runner.run("set/number/listeners", {{"listeners", std::to_string(listenerCount)}}, [&]() { mmkv->set(key, value, std::nullopt); });
+    doNotOptimize(calls);
+    for (const Listener& listener : listeners) {
+      listener.remove();
+    }
+  }
+}
+
+static void benchmarkKeyListeners(BenchmarkRunner& runner, InstanceFactory& factory) {
+  auto mmkv = factory.create("key-listeners");
+  std::string key = createKey(16, 0);
+  Value value = 1.0;
+  for (size_t listenerCount : {1, 100, 1000}) {
+    Parameters parameters = {{"listeners", std::to_string(listenerCount)}};
+    size_t calls = 0;
+    std::vector<Listener> listeners;
+    // Every listener watches a different key and filters the others out itself
+    for (size_t i = 0; i < listenerCount; i++) {
+      std::string watchedKey = createKey(16, i);
+      listeners.push_back(mmkv->addOnValueChangedListener([&calls, watchedKey](const std::string& changedKey) {
+        if (changedKey == watchedKey) {
+          calls++;
+        }
+      }));
+    }
+    runner.run("set/number/listeners/filtering", parameters, [&]() { mmkv->set(key, value, std::nullopt); });
+    for (const Listener& listener : listeners) {
+      listener.remove();
+    }
+    listeners.clear();
+
+    for (size_t i = 0; i < listenerCount; i++) {
+      listeners.push_back(mmkv->addOnKeyChangedListener(createKey(16, i), [&calls](const std::string&) { calls++; }));
+    }
+    runner.run("set/number/listeners/keyed", parameters, [&]() { mmkv->set(key, value, std::nullopt); });
+    doNotOptimize(calls);
+    for (const Listener& listener : listeners) {
+      listener.remove();
+    }
+  }
+}
+
+static void benchmarkGetMany(BenchmarkRunner& runner, InstanceFactory& factory) {
+  auto mmkv = factory.create("get-many");
+  for (size_t keyCount : {10, 100, 1000}) {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < keyCount; i++) {
+      keys.push_back(createKey(16, i));
+      mmkv->set(keys.back(), createJSONValue(64), std::nullopt);
+    }
+    Parameters parameters = {{"keys", std::to_string(keyCount)}};
+    runner.run("get/string/each", parameters, [&]() {
+      size_t found = 0;
+      for (const auto& key : keys) {
+        found += mmkv->getString(key).has_value();
+      }
+      return found;
+    });
+    runner.run("getMany", parameters, [&]() { return mmkv->getMany(keys, std::nullopt); });
+  }
+}
+
+int main(int argc, char** argv) {
+  auto rootPath = std::filesystem::temp_directory_path() / ("mmkv-benchmarks-" + std::to_string(getpid()));
+  std::filesystem::create_directories(rootPath);
+  MMKV::initializeMMKV(rootPath.string(), MMKVLogNone);
+
+  int exitCode = runBenchmarkSuite(argc, argv, "hybrid-mmkv", [&](BenchmarkRunner& runner) {
+    InstanceFactory factory(rootPath.string());
+    benchmarkPrimitives(runner, factory);
+    benchmarkValueSizes(runner, factory);
+    benchmarkKeyLengths(runner, factory);
+    benchmarkEncryption(runner, factory);
+    benchmarkCompareBeforeSet(runner, factory);
+    benchmarkGetAllKeys(runner, factory);
+    benchmarkSyncPolicies(runner, factory);
+    benchmarkAccessTracking(runner, factory);
+    benchmarkListenerFanOut(runner, factory);
+    benchmarkKeyListeners(runner, factory);
+    benchmarkGetMany(runner, factory);
+  });
+
+  MMKV::onExit();
+  std::filesystem::remove_all(rootPath);
+  return exitCode;
+}
@@ -0,0 +1,78 @@
+//
+//  LatencyHistogram.cpp
+//  react-native-mmkv
+//
+
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace margelo::nitro::mmkv::benchmark {
+
+size_t LatencyHistogram::getBucketIndex(uint64_t value) {
+  if (value < SUB_BUCKET_COUNT) {
+    return static_cast<size_t>(value);
+  }
+  // Values in [2^n, 2^(n+1)) are split linearly by their next SUB_BUCKET_BITS bits
+  size_t exponent = static_cast<size_t>(std::bit_width(value)) - 1;
+  size_t shift = exponent - SUB_BUCKET_BITS;
+  size_t subBucket = static_cast<size_t>(value >> shift) & (SUB_BUCKET_COUNT - 1);
+  return (shift + 1) * SUB_BUCKET_COUNT + subBucket;
+}
+
+double LatencyHistogram::getBucketValue(size_t index) {
+  if (index < SUB_BUCKET_COUNT) {
+    return static_cast<double>(index);
+  }
+  size_t shift = index / SUB_BUCKET_COUNT - 1;
+  uint64_t lowerBound = static_cast<uint64_t>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+  uint64_t width = uint64_t(1) << shift;
+  return static_cast<double>(lowerBound) + static_cast<double>(width - 1) / 2.0;
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+  uint64_t nanoseconds = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+  _buckets[getBucketIndex(nanoseconds)]++;
+  _count++;
+  _totalNanoseconds += nanoseconds;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    _buckets[i] += other._buckets[i];
+  }
+  _count += other._count;
+  _totalNanoseconds += other._totalNanoseconds;
+}
+
+double LatencyHistogram::getMean() const {
+  return _count > 0 ? static_cast<double>(_totalNanoseconds) / static_cast<double>(_count) : 0.0;
+}
+
+double LatencyHistogram::getMin() const {
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    if (_buckets[i] > 0) {
+      return getBucketValue(i);
+    }
+  }
+  return 0.0;
+}
+
+double LatencyHistogram::getPercentile(double percentile) const {
+  if (_count == 0) {
+    return 0.0;
+  }
+  // Nearest-rank method
+  uint64_t rank = std::clamp<uint64_t>(static_cast<uint64_t>(std::ceil(percentile * static_cast<double>(_count))), 1, _count);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    seen += _buckets[i];
+    if (seen >= rank) {
+      return getBucketValue(i);
+    }
+  }
+  return getBucketValue(BUCKET_COUNT - 1);
+}
+
+} // namespace margelo::nitro::mmkv::benchmark
@@ -0,0 +1,56 @@
+//
+//  LatencyHistogram.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace margelo::nitro::mmkv::benchmark {
+
+/**
+ * A log-linear histogram of latencies with a relative error of at most 1/32, so even p999
+ * of millions of operations can be reported without storing every sample.
+ *
+ * Recording is a few instructions and never allocates. It is not thread-safe - every
+ * thread records into its own histogram, and they are merged afterwards.
+ * It is trivially copyable, so it can also be sent from a forked process through a pipe.
+ */
+class LatencyHistogram final {
+public:
+  void record(std::chrono::nanoseconds duration);
+  void merge(const LatencyHistogram& other);
+
+public:
+  uint64_t getCount() const {
+    return _count;
+  }
+  double getMean() const;
+  double getMin() const;
+  /**
+   * Gets the latency (in nanoseconds) at the given percentile, e.g. `0.999`.
+   */
+  double getPercentile(double percentile) const;
+
+private:
+  static size_t getBucketIndex(uint64_t value);
+  // The middle of the range of values that fall into the given bucket
+  static double getBucketValue(size_t index);
+
+private:
+  // Every power of two is split into this many linear sub-buckets
+  static constexpr size_t SUB_BUCKET_BITS = 4;
+  static constexpr size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+private:
+  std::array<uint64_t, BUCKET_COUNT> _buckets{};
+  uint64_t _count = 0;
+  uint64_t _totalNanoseconds = 0;
+};
+
+} // namespace margelo::nitro::mmkv::benchmark
@@ -0,0 +1,347 @@
+//
+//  MMKVBenchmark.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVBenchmark.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+#ifndef MMKV_BENCHMARK_VERSION
+#define MMKV_BENCHMARK_VERSION "unknown"
+#endif
+#ifndef MMKV_BENCHMARK_COMPILER
+#define MMKV_BENCHMARK_COMPILER "unknown"
+#endif
+#ifndef MMKV_BENCHMARK_BUILD_TYPE
+#define MMKV_BENCHMARK_BUILD_TYPE "unknown"
+#endif
+#ifndef MMKV_BENCHMARK_SYSTEM
+#define MMKV_BENCHMARK_SYSTEM "unknown"
+#endif
+
+namespace margelo::nitro::mmkv::benchmark {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+  struct Budget {
+    // Keeps sampling until both of these are reached...
+    std::chrono::nanoseconds minDuration;
+    size_t minSamples;
+    // ...unless one of these is reached first
+    std::chrono::nanoseconds maxDuration;
+    size_t maxSamples;
+  };
+
+  constexpr Budget DEFAULT_BUDGET{200ms, 20, 10s, 10'000};
+  constexpr Budget QUICK_BUDGET{20ms, 5, 2s, 1'000};
+  // Batches shorter than this are dominated by the cost of reading the clock
+  constexpr std::chrono::nanoseconds MIN_BATCH_DURATION = 10us;
+
+  std::string formatDuration(double nanoseconds) {
+    char formatted[32];
+    if (nanoseconds < 1'000) {
+      std::snprintf(formatted, sizeof(formatted), "%.1f ns", nanoseconds);
+    } else if (nanoseconds < 1'000'000) {
+      std::snprintf(formatted, sizeof(formatted), "%.2f us", nanoseconds / 1'000);
+    } else if (nanoseconds < 1'000'000'000) {
+      std::snprintf(formatted, sizeof(formatted), "%.2f ms", nanoseconds / 1'000'000);
+    } else {
+      std::snprintf(formatted, sizeof(formatted), "%.2f s", nanoseconds / 1'000'000'000);
+    }
+    return formatted;
+  }
+
+  std::string formatRate(double opsPerSecond) {
+    char formatted[32];
+    if (opsPerSecond >= 1'000'000) {
+      std::snprintf(formatted, sizeof(formatted), "%.2fM ops/s", opsPerSecond / 1'000'000);
+    } else {
+      std::snprintf(formatted, sizeof(formatted), "%.0f ops/s", opsPerSecond);
+    }
+    return formatted;
+  }
+
+  std::string formatThroughput(double bytesPerSecond) {
+    char formatted[32];
+    std::snprintf(formatted, sizeof(formatted), "%.1f MB/s", bytesPerSecond / (1024 * 1024));
+    return formatted;
+  }
+
+  double getPercentile(const std::vector<double>& sortedSamples, double percentile) {
+    // Nearest-rank method
+    size_t rank = static_cast<size_t>(std::ceil(percentile * static_cast<double>(sortedSamples.size())));
+    return sortedSamples[std::clamp<size_t>(rank, 1, sortedSamples.size()) - 1];
+  }
+
+  void appendEscaped(std::string& output, const std::string& string) {
+    for (char c : string) {
+      if (c == '"' || c == '\\') {
+        output += '\\';
+        output += c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+        output += escaped;
+      } else {
+        output += c;
+      }
+    }
+  }
+
+  void appendString(std::string& output, const std::string& key, const std::string& value) {
+    output += '"';
+    output += key;
+    output += "\":\"";
+    appendEscaped(output, value);
+    output += '"';
+  }
+
+  void appendNumber(std::string& output, const std::string& key, double value) {
+    char formatted[64];
+    std::snprintf(formatted, sizeof(formatted), "\"%s\":%.3f", key.c_str(), value);
+    output += formatted;
+  }
+
+  void appendInteger(std::string& output, const std::string& key, size_t value) {
+    output += '"';
+    output += key;
+    output += "\":";
+    output += std::to_string(value);
+  }
+
+  std::string getCurrentDate() {
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+    gmtime_r(&now, &utc);
+    char formatted[32];
+    std::strftime(formatted, sizeof(formatted), "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return formatted;
+  }
+
+} // namespace
+
+BenchmarkOptions BenchmarkOptions::parse(int argc, char** argv, const std::vector<std::string>& extraOptionNames) {
+  BenchmarkOptions options;
+  for (int i = 1; i < argc; i++) {
+    std::string argument = argv[i];
+    size_t separator = argument.find('=');
+    std::string name = argument.starts_with("--") && separator != std::string::npos ? argument.substr(2, separator - 2) : "";
+    if (!name.empty() && std::find(extraOptionNames.begin(), extraOptionNames.end(), name) != extraOptionNames.end()) {
+      options.extraOptions[name] = argument.substr(separator + 1);
+    } else if (argument.starts_with("--filter=")) {
+      options.filter = argument.substr(std::strlen("--filter="));
+    } else if (argument == "--quick") {
+      options.isQuick = true;
+    } else if (argument.starts_with("--output=")) {
+      options.outputPath = argument.substr(std::strlen("--output="));
+    } else {
+      std::string usage = std::string(argv[0]) + " [--filter=<substring>] [--quick] [--output=<report.json>]";
+      for (const auto& extraOptionName : extraOptionNames) {
+        usage += " [--" + extraOptionName + "=<value>]";
+      }
+      throw std::runtime_error("Unknown argument \"" + argument + "\"! Usage: " + usage);
+    }
+  }
+  return options;
+}
+
+std::string BenchmarkOptions::getExtraOption(const std::string& name, const std::string& defaultValue) const {
+  auto option = extraOptions.find(name);
+  return option != extraOptions.end() ? option->second : defaultValue;
+}
+
+BenchmarkRunner::BenchmarkRunner(BenchmarkOptions options) : _options(std::move(options)) {}
+
+std::string BenchmarkRunner::getFullName(const std::string& name, const Parameters& parameters) {
+  std::string fullName = name;
+  for (const auto& [key, value] : parameters) {
+    fullName += "/" + key + "=" + value;
+  }
+  return fullName;
+}
+
+bool BenchmarkRunner::shouldRun(const std::string& name, const Parameters& parameters) const {
+  if (_options.filter.empty()) {
+    return true;
+  }
+  if (name.find(_options.filter) != std::string::npos) {
+    // Skips building the full name for the common case of filtering by a group, e.g. "compression"
+    return true;
+  }
+  return getFullName(name, parameters).find(_options.filter) != std::string::npos;
+}
+
+void BenchmarkRunner::measure(const std::string& name, const Parameters& parameters, size_t bytesPerOperation, const Batch& batch) {
+  const Budget& budget = _options.isQuick ? QUICK_BUDGET : DEFAULT_BUDGET;
+
+  // 1. Warm up and find a batch size that takes long enough to be measured reliably
+  size_t batchSize = 1;
+  std::chrono::nanoseconds batchDuration = batch(batchSize);
+  while (batchDuration < MIN_BATCH_DURATION) {
+    double scale = static_cast<double>(MIN_BATCH_DURATION.count()) / static_cast<double>(std::max<int64_t>(batchDuration.count(), 1));
+    batchSize = static_cast<size_t>(static_cast<double>(batchSize) * std::clamp(scale * 1.2, 2.0, 100.0));
+    batchDuration = batch(batchSize);
+  }
+
+  // 2. Collect samples
+  std::vector<double> samples;
+  std::chrono::nanoseconds totalDuration = 0ns;
+  while (samples.size() < budget.maxSamples) {
+    bool hasEnoughSamples = totalDuration >= budget.minDuration && samples.size() >= budget.minSamples;
+    bool isOverBudget = totalDuration >= budget.maxDuration && !samples.empty();
+    if (hasEnoughSamples || isOverBudget) {
+      break;
+    }
+    std::chrono::nanoseconds duration = batch(batchSize);
+    totalDuration += duration;
+    samples.push_back(static_cast<double>(duration.count()) / static_cast<double>(batchSize));
+  }
+
+  std::sort(samples.begin(), samples.end());
+  BenchmarkResult result{
+      .name = name,
+      .parameters = parameters,
+      .iterations = samples.size() * batchSize,
+      .samples = samples.size(),
+      .meanNanoseconds = static_cast<double>(totalDuration.count()) / static_cast<double>(samples.size() * batchSize),
+      .p50Nanoseconds = getPercentile(samples, 0.50),
+      .p99Nanoseconds = getPercentile(samples, 0.99),
+      .p999Nanoseconds = getPercentile(samples, 0.999),
+      .minNanoseconds = samples.front(),
+      .opsPerSecond = 1e9 * static_cast<double>(samples.size() * batchSize) / static_cast<double>(totalDuration.count()),
+      .bytesPerOperation = bytesPerOperation,
+      .metrics = {},
+  };
+  addResult(std::move(result));
+}
+
+void BenchmarkRunner::addResult(BenchmarkResult result) {
+  std::string line = getFullName(result.name, result.parameters);
+  line.resize(std::max<size_t>(line.size(), 56), ' ');
+  line += "  mean " + formatDuration(result.meanNanoseconds) + "  p50 " + formatDuration(result.p50Nanoseconds) + "  p99 " +
+          formatDuration(result.p99Nanoseconds);
+  line += "  " + formatRate(result.opsPerSecond);
+  if (result.bytesPerOperation > 0) {
+    line += "  " + formatThroughput(static_cast<double>(result.bytesPerOperation) * result.opsPerSecond);
+  }
+  std::fprintf(stderr, "%s\n", line.c_str());
+
+  _results.push_back(std::move(result));
+}
+
+void BenchmarkRunner::writeReport(const std::string& suite) const {
+  std::string report = "{\n  \"context\": {";
+  appendString(report, "suite", suite);
+  report += ",";
+  appendString(report, "version", MMKV_BENCHMARK_VERSION);
+  report += ",";
+  appendString(report, "date", getCurrentDate());
+  report += ",";
+  appendString(report, "system", MMKV_BENCHMARK_SYSTEM);
+  report += ",";
+  appendString(report, "compiler", MMKV_BENCHMARK_COMPILER);
+  report += ",";
+  appendString(report, "buildType", MMKV_BENCHMARK_BUILD_TYPE);
+  report += ",";
+  appendInteger(report, "hardwareConcurrency", std::thread::hardware_concurrency());
+  report += ",\"quick\":";
+  report += _options.isQuick ? "true" : "false";
+  report += "},\n  \"benchmarks\": [";
+
+  for (size_t i = 0; i < _results.size(); i++) {
+    const BenchmarkResult& result = _results[i];
+    report += i == 0 ? "\n    {" : ",\n    {";
+    appendString(report, "name", getFullName(result.name, result.parameters));
+    report += ",";
+    appendString(report, "group", result.name);
+    report += ",\"parameters\":{";
+    for (size_t p = 0; p < result.parameters.size(); p++) {
+      if (p > 0) {
+        report += ",";
+      }
+      appendString(report, result.parameters[p].first, result.parameters[p].second);
+    }
+    report += "},";
+    appendInteger(report, "iterations", result.iterations);
+    report += ",";
+    appendInteger(report, "samples", result.samples);
+    report += ",";
+    appendNumber(report, "meanNs", result.meanNanoseconds);
+    report += ",";
+    appendNumber(report, "p50Ns", result.p50Nanoseconds);
+    report += ",";
+    appendNumber(report, "p99Ns", result.p99Nanoseconds);
+    report += ",";
+    appendNumber(report, "p999Ns", result.p999Nanoseconds);
+    report += ",";
+    appendNumber(report, "minNs", result.minNanoseconds);
+    report += ",";
+    appendNumber(report, "opsPerSecond", result.opsPerSecond);
+    if (result.bytesPerOperation > 0) {
+      report += ",";
+      appendNumber(report, "bytesPerSecond", static_cast<double>(result.bytesPerOperation) * result.opsPerSecond);
+    }
+    for (const auto& [metric, value] : result.metrics) {
+      report += ",";
+      appendNumber(report, metric, value);
+    }
+    report += "}";
+  }
+  report += "\n  ]\n}\n";
+
+  if (_options.outputPath.empty()) {
+    std::fwrite(report.data(), 1, report.size(), stdout);
+    return;
+  }
+  std::FILE* file = std::fopen(_options.outputPath.c_str(), "w");
+  if (file == nullptr) [[unlikely]] {
+    throw std::runtime_error("Failed to create report file \"" + _options.outputPath + "\"! " + std::strerror(errno));
+  }
+  std::fwrite(report.data(), 1, report.size(), file);
+  std::fclose(file);
+}
+
+std::string createJSONValue(size_t size) {
+  std::mt19937 random(42);
+  std::string json = "[";
+  for (size_t i = 0; json.size() < size; i++) {
+    json += R"({"id":)" + std::to_string(i) + R"(,"name":"User )" + std::to_string(random() % 10000) + R"(","score":)" +
+            std::to_string(random() % 1000) + "},";
+  }
+  json.resize(size);
+  return json;
+}
+
+std::string createKey(size_t length, size_t index) {
+  char prefix[32];
+  std::snprintf(prefix, sizeof(prefix), "key%05zu", index);
+  std::string key = prefix;
+  key.resize(std::max(length, key.size()), '-');
+  return key;
+}
+
+int runBenchmarkSuite(int argc, char** argv, const std::string& suite, const std::function<void(BenchmarkRunner& runner)>& benchmarks,
+                      const std::vector<std::string>& extraOptionNames) {
+  try {
+    BenchmarkRunner runner(BenchmarkOptions::parse(argc, argv, extraOptionNames));
+    benchmarks(runner);
+    runner.writeReport(suite);
+    return 0;
+  } catch (const std::exception& exception) {
+    std::fprintf(stderr, "%s\n", exception.what());
+    return 1;
+  }
+}
+
+} // namespace margelo::nitro::mmkv::benchmark
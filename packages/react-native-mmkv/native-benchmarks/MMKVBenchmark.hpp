@@ -0,0 +1,161 @@
+//
+//  MMKVBenchmark.hpp
+//  react-native-mmkv
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace margelo::nitro::mmkv::benchmark {
+
+/**
+ * Keeps the compiler from optimizing away a value that is computed, but never used.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Parameters of a single benchmark, e.g. `{"valueSize", "1024"}`, in the order they were given
+using Parameters = std::vector<std::pair<std::string, std::string>>;
+
+struct BenchmarkOptions {
+  // Only benchmarks whose full name contains this are run
+  std::string filter;
+  // Runs every benchmark for a shorter time and skips the largest inputs, e.g. for CI
+  bool isQuick = false;
+  // Writes the JSON report to this file instead of stdout
+  std::string outputPath;
+  // Suite-specific `--<name>=<value>` options
+  std::unordered_map<std::string, std::string> extraOptions;
+
+  /**
+   * Parses `--filter=<substring>`, `--quick`, `--output=<path>` and the given suite-specific options,
+   * or throws for unknown arguments.
+   */
+  static BenchmarkOptions parse(int argc, char** argv, const std::vector<std::string>& extraOptionNames = {});
+
+  /**
+   * Gets the value of a suite-specific option, or `defaultValue` if it was not passed.
+   */
+  std::string getExtraOption(const std::string& name, const std::string& defaultValue) const;
+};
+
+struct BenchmarkResult {
+  std::string name;
+  Parameters parameters;
+  size_t iterations;
+  size_t samples;
+  double meanNanoseconds;
+  double p50Nanoseconds;
+  double p99Nanoseconds;
+  double p999Nanoseconds;
+  double minNanoseconds;
+  // Of all threads together, if the benchmark runs on multiple threads
+  double opsPerSecond;
+  // 0 if the benchmark does not process any bytes
+  size_t bytesPerOperation;
+  // Additional numbers of a benchmark, e.g. `{"lockWaitMeanNs", 120.5}`
+  std::vector<std::pair<std::string, double>> metrics;
+};
+
+/**
+ * Runs benchmarks and collects their results into a machine-readable JSON report,
+ * so results of two releases can be compared with `compare.js`.
+ *
+ * Every operation runs in batches that take at least ten microseconds, so even operations
+ * that only take a few nanoseconds can be measured with `steady_clock`. Latency percentiles
+ * are therefore percentiles of the batch averages, which is exact for slow operations and
+ * hides outliers of very fast ones.
+ */
+class BenchmarkRunner final {
+public:
+  explicit BenchmarkRunner(BenchmarkOptions options);
+
+public:
+  bool isQuick() const {
+    return _options.isQuick;
+  }
+  const BenchmarkOptions& getOptions() const {
+    return _options;
+  }
+
+  /**
+   * Whether the given benchmark passes the `--filter`. Benchmarks with an expensive setup
+   * should check this first, so they don't set up what is never measured.
+   */
+  bool shouldRun(const std::string& name, const Parameters& parameters = {}) const;
+
+  /**
+   * Measures `operation` until enough samples were collected.
+   * If it returns a value, that value is kept from being optimized away.
+   */
+  template <typename Operation>
+  void run(const std::string& name, const Parameters& parameters, Operation&& operation, size_t bytesPerOperation = 0) {
+    if (!shouldRun(name, parameters)) {
+      return;
+    }
+    measure(name, parameters, bytesPerOperation, [&](size_t iterations) {
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < iterations; i++) {
+        if constexpr (std::is_void_v<std::invoke_result_t<Operation&>>) {
+          operation();
+        } else {
+          doNotOptimize(operation());
+        }
+      }
+      return std::chrono::steady_clock::now() - start;
+    });
+  }
+
+  /**
+   * Adds the result of a benchmark that was measured by the suite itself, e.g. on multiple threads.
+   */
+  void addResult(BenchmarkResult result);
+
+  /**
+   * Writes the JSON report of all results to stdout, or to the `--output` file.
+   */
+  void writeReport(const std::string& suite) const;
+
+  const std::vector<BenchmarkResult>& getResults() const {
+    return _results;
+  }
+
+public:
+  static std::string getFullName(const std::string& name, const Parameters& parameters);
+
+private:
+  using Batch = std::function<std::chrono::nanoseconds(size_t iterations)>;
+  void measure(const std::string& name, const Parameters& parameters, size_t bytesPerOperation, const Batch& batch);
+
+private:
+  BenchmarkOptions _options;
+  std::vector<BenchmarkResult> _results;
+};
+
+/**
+ * Creates a JSON string of exactly `size` bytes, which compresses about as well as typical app data.
+ */
+std::string createJSONValue(size_t size);
+/**
+ * Creates a unique key for the given index, padded to `length` characters (keys of huge indexes may be longer).
+ */
+std::string createKey(size_t length, size_t index);
+
+/**
+ * Parses the arguments, runs all benchmarks of a suite and writes the report.
+ * Returns the process' exit code.
+ */
+int runBenchmarkSuite(int argc, char** argv, const std::string& suite, const std::function<void(BenchmarkRunner& runner)>& benchmarks,
+                      const std::vector<std::string>& extraOptionNames = {});
+
+} // namespace margelo::nitro::mmkv::benchmark
@@ -0,0 +1,71 @@
+// Compares two benchmark reports, e.g. of the last release and this branch:
+//
+//   node compare.js baseline.json current.json [--threshold=10]
+//
+// Exits with 1 if the mean time of any benchmark got slower by more than the
+// threshold (in percent, defaults to 10).
+
+const fs = require('fs')
+
+function parseArguments(args) {
+  const files = args.filter((arg) => !arg.startsWith('--'))
+  const thresholdArg = args.find((arg) => arg.startsWith('--threshold='))
+  if (files.length !== 2) {
+    throw new Error(
+      'Usage: node compare.js <baseline.json> <current.json> [--threshold=10]'
+    )
+  }
+  const threshold =
+    thresholdArg != null ? Number(thresholdArg.split('=')[1]) : 10
+  return { baselinePath: files[0], currentPath: files[1], threshold }
+}
+
+function readBenchmarks(path) {
+  const report = JSON.parse(fs.readFileSync(path, 'utf8'))
+  return new Map(report.benchmarks.map((b) => [b.name, b]))
+}
+
+function formatNanoseconds(ns) {
+  if (ns < 1e3) return `${ns.toFixed(1)} ns`
+  if (ns < 1e6) return `${(ns / 1e3).toFixed(2)} us`
+  if (ns < 1e9) return `${(ns / 1e6).toFixed(2)} ms`
+  return `${(ns / 1e9).toFixed(2)} s`
+}
+
+function main() {
+  const { baselinePath, currentPath, threshold } = parseArguments(
+    process.argv.slice(2)
+  )
+  const baseline = readBenchmarks(baselinePath)
+  const current = readBenchmarks(currentPath)
+
+  const regressions = []
+  for (const [name, result] of current) {
+    const before = baseline.get(name)
+    if (before == null) {
+      console.log(`${name.padEnd(56)}  (new)`)
+      continue
+    }
+    const change = (result.meanNs / before.meanNs - 1) * 100
+    const sign = change > 0 ? '+' : ''
+    console.log(
+      `${name.padEnd(56)}  ${formatNanoseconds(before.meanNs).padStart(10)}` +
+        ` -> ${formatNanoseconds(result.meanNs).padStart(10)}` +
+        `  ${`${sign}${change.toFixed(1)}%`.padStart(8)}`
+    )
+    if (change > threshold) regressions.push(name)
+  }
+  for (const name of baseline.keys()) {
+    if (!current.has(name)) console.log(`${name.padEnd(56)}  (removed)`)
+  }
+
+  if (regressions.length > 0) {
+    console.error(
+      `\n${regressions.length} benchmark(s) got more than ${threshold}% slower:`
+    )
+    for (const name of regressions) console.error(`  - ${name}`)
+    process.exit(1)
+  }
+}
+
+main()
@@ -0,0 +1,44 @@
+//
+//  NitroHostPlatform.cpp
+//  react-native-mmkv
+//
+
+// Nitro implements a few functions per platform (in its `ios/` and `android/` folders).
+// These are the minimal implementations for a Linux or macOS host, which is all the benchmarks need.
+
+#include <NitroModules/NitroLogger.hpp>
+#include <NitroModules/ThreadUtils.hpp>
+#include <cstdio>
+#include <pthread.h>
+
+namespace margelo::nitro {
+
+void Logger::nativeLog(LogLevel level, const char* tag, const std::string& message) {
+  if (level < LogLevel::Warning) {
+    // Debug logs would skew the results
+    return;
+  }
+  std::fprintf(stderr, "[Nitro.%s] %s\n", tag, message.c_str());
+}
+
+std::string ThreadUtils::getThreadName() {
+  char name[64] = {};
+  pthread_getname_np(pthread_self(), name, sizeof(name));
+  return name;
+}
+
+void ThreadUtils::setThreadName(const std::string& name) {
+#ifdef __APPLE__
+  pthread_setname_np(name.c_str());
+#else
+  // Linux limits thread names to 15 characters
+  pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+}
+
+bool ThreadUtils::isUIThread() {
+  // There is no UI thread on a host
+  return false;
+}
+
+} // namespace margelo::nitro
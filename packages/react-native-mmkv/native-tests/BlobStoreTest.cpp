@@ -0,0 +1,183 @@
+//
+//  BlobStoreTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVBlobStore.hpp"
+#include "MMKVCompression.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using namespace margelo::nitro::mmkv;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+static std::string createTemporaryDirectory() {
+  char path[] = "/tmp/mmkv-blob-test-XXXXXX";
+  EXPECT(mkdtemp(path) != nullptr);
+  return path;
+}
+
+static size_t countFiles(const std::string& directory) {
+  DIR* dir = opendir(directory.c_str());
+  if (dir == nullptr) {
+    return 0;
+  }
+  size_t count = 0;
+  while (dirent* entry = readdir(dir)) {
+    if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+      count++;
+    }
+  }
+  closedir(dir);
+  return count;
+}
+
+static void testWritesAndMapsBlobs() {
+  std::string root = createTemporaryDirectory();
+  MMKVBlobStore store(MMKVBlobStore::getDirectory(root, "test"));
+  EXPECT(!store.exists());
+
+  std::string value(5 * 1024 * 1024, 'x');
+  value[1234] = 'y';
+  std::string id = store.write(value.data(), value.size());
+  EXPECT(id.size() == MMKVBlobStore::ID_LENGTH);
+  EXPECT(store.exists());
+
+  auto blob = store.read(id);
+  EXPECT(blob->size() == value.size());
+  EXPECT(std::memcmp(blob->data(), value.data(), value.size()) == 0);
+
+  // Writing to the mapped memory never changes the blob
+  blob->data()[0] = 'z';
+  EXPECT(store.read(id)->data()[0] == 'x');
+
+  // Corrupted references must never reach outside of the blob directory
+  bool threw = false;
+  try {
+    store.read("../../../../../../../../etc/passwd");
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  EXPECT(threw);
+
+  store.removeAll();
+  EXPECT(!store.exists());
+  rmdir(root.c_str());
+}
+
+static void testDeduplicatesEqualContent() {
+  std::string root = createTemporaryDirectory();
+  MMKVBlobStore store(MMKVBlobStore::getDirectory(root, "test"));
+  std::string first(100 * 1024, 'a');
+  std::string second(100 * 1024, 'b');
+
+  std::string firstId = store.write(first.data(), first.size());
+  EXPECT(store.write(first.data(), first.size()) == firstId);
+  EXPECT(store.write(second.data(), second.size()) != firstId);
+  EXPECT(countFiles(MMKVBlobStore::getDirectory(root, "test")) == 2);
+
+  store.removeAll();
+  rmdir(root.c_str());
+}
+
+static void testReplacesDamagedBlobs() {
+  std::string root = createTemporaryDirectory();
+  std::string directory = MMKVBlobStore::getDirectory(root, "test");
+  MMKVBlobStore store(directory);
+  std::string value(100 * 1024, 'v');
+  std::string id = store.write(value.data(), value.size());
+
+  // Same size, different content - e.g. a bit flipped on disk
+  FILE* file = std::fopen((directory + "/" + id + ".blob").c_str(), "r+b");
+  EXPECT(file != nullptr);
+  EXPECT(std::fwrite("x", 1, 1, file) == 1);
+  std::fclose(file);
+  EXPECT(store.read(id)->data()[0] == 'x');
+
+  EXPECT(store.write(value.data(), value.size()) == id);
+  EXPECT(store.read(id)->data()[0] == 'v');
+
+  store.removeAll();
+  rmdir(root.c_str());
+}
+
+static void testRemovesOnlyUnreferencedBlobs() {
+  std::string root = createTemporaryDirectory();
+  std::string directory = MMKVBlobStore::getDirectory(root, "test");
+  MMKVBlobStore store(directory);
+  std::string kept(1024, 'k');
+  std::string orphaned(1024, 'o');
+  std::string keptId = store.write(kept.data(), kept.size());
+  store.write(orphaned.data(), orphaned.size());
+
+  // Recently written blobs are kept, their reference might just not be written yet
+  EXPECT(store.removeUnreferenced({keptId}) == 0);
+  EXPECT(countFiles(directory) == 2);
+
+  EXPECT(store.removeUnreferenced({keptId}, std::chrono::seconds(0)) == 1);
+  EXPECT(countFiles(directory) == 1);
+  EXPECT(store.read(keptId)->size() == kept.size());
+
+  store.removeAll();
+  rmdir(root.c_str());
+}
+
+static void testSanitizesDirectoryNames() {
+  EXPECT(MMKVBlobStore::getDirectory("/root", "mmkv.default") == "/root/mmkv.default.blobs");
+  EXPECT(MMKVBlobStore::getDirectory("/root/", "user-1_cache") == "/root/user-1_cache.blobs");
+  std::string slashes = MMKVBlobStore::getDirectory("/root", "a/b");
+  std::string underscores = MMKVBlobStore::getDirectory("/root", "a_b");
+  EXPECT(slashes.find('/', 6) == std::string::npos);
+  EXPECT(slashes != underscores);
+}
+
+static void testEncodesReferences() {
+  std::string id(MMKVBlobStore::ID_LENGTH, 'f');
+  std::string reference = MMKVCompression::encodeExternal(id, 5 * 1024 * 1024);
+  EXPECT(MMKVCompression::isEncoded(reference.data(), reference.size()));
+  EXPECT(MMKVCompression::getCodec(reference.data(), reference.size()) == MMKVCompression::Codec::EXTERNAL);
+  EXPECT(MMKVCompression::getDecodedSize(reference.data(), reference.size()) == 5 * 1024 * 1024);
+  EXPECT(MMKVCompression::getExternalId(reference.data(), reference.size()) == id);
+}
+
+static void testWriteThroughput() {
+  std::string root = createTemporaryDirectory();
+  MMKVBlobStore store(MMKVBlobStore::getDirectory(root, "test"));
+  std::string value(5 * 1024 * 1024, 'x');
+
+  constexpr int iterations = 10;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    // Different content every time, like a value that keeps changing
+    std::memcpy(value.data(), &i, sizeof(i));
+    store.write(value.data(), value.size());
+  }
+  double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / iterations;
+  std::printf("write(5 MB): %.2fms\n", milliseconds);
+
+  store.removeAll();
+  rmdir(root.c_str());
+}
+
+int main() {
+  testWritesAndMapsBlobs();
+  testDeduplicatesEqualContent();
+  testReplacesDamagedBlobs();
+  testRemovesOnlyUnreferencedBlobs();
+  testSanitizesDirectoryNames();
+  testEncodesReferences();
+  testWriteThroughput();
+  std::printf("All blob store tests passed.\n");
+  return 0;
+}
@@ -0,0 +1,158 @@
+//
+//  CoalescingListenerTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVCoalescingListener.hpp"
+#include "MMKVTimerQueue.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+using namespace std::chrono_literals;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+static void testTimerQueueRunsTasksInDeadlineOrder() {
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<int> order;
+
+  auto push = [&](int value) {
+    std::unique_lock lock(mutex);
+    order.push_back(value);
+    condition.notify_all();
+  };
+  MMKVTimerQueue::shared().schedule(30ms, [&]() { push(3); });
+  MMKVTimerQueue::shared().schedule(10ms, [&]() { push(1); });
+  MMKVTimerQueue::shared().schedule(10ms, [&]() { push(2); });
+
+  std::unique_lock lock(mutex);
+  EXPECT(condition.wait_for(lock, 2s, [&]() { return order.size() == 3; }));
+  EXPECT((order == std::vector<int>{1, 2, 3}));
+}
+
+static void testBurstIsCoalescedIntoOneCall() {
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<std::vector<std::string>> calls;
+
+  auto listener = std::make_shared<MMKVCoalescingListener>(
+      [&](const std::vector<std::string>& keys) {
+        std::unique_lock lock(mutex);
+        calls.push_back(keys);
+        condition.notify_all();
+      },
+      50ms);
+
+  for (int i = 0; i < 1000; i++) {
+    listener->onValueChanged("key-" + std::to_string(i % 10));
+  }
+
+  std::unique_lock lock(mutex);
+  EXPECT(condition.wait_for(lock, 2s, [&]() { return !calls.empty(); }));
+  EXPECT(calls.size() == 1);
+  EXPECT(calls[0].size() == 10);
+  for (int i = 0; i < 10; i++) {
+    EXPECT(calls[0][i] == "key-" + std::to_string(i));
+  }
+}
+
+static void testBatchesAreMergedAndDeduplicated() {
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<std::vector<std::string>> calls;
+
+  auto listener = std::make_shared<MMKVCoalescingListener>(
+      [&](const std::vector<std::string>& keys) {
+        std::unique_lock lock(mutex);
+        calls.push_back(keys);
+        condition.notify_all();
+      },
+      50ms);
+
+  listener->onValuesChanged(std::vector<std::string>{"a", "b", "a"});
+  listener->onValuesChanged(std::vector<std::string>{"b", "c"});
+  listener->onValuesChanged({});
+
+  std::unique_lock lock(mutex);
+  EXPECT(condition.wait_for(lock, 2s, [&]() { return !calls.empty(); }));
+  EXPECT(calls.size() == 1);
+  EXPECT((calls[0] == std::vector<std::string>{"a", "b", "c"}));
+}
+
+static void testConcurrentChangesAreNeverLost() {
+  constexpr int threadsCount = 4;
+  constexpr int changesPerThread = 5000;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::unordered_set<std::string> delivered;
+
+  auto listener = std::make_shared<MMKVCoalescingListener>(
+      [&](const std::vector<std::string>& keys) {
+        std::unique_lock lock(mutex);
+        delivered.insert(keys.begin(), keys.end());
+        condition.notify_all();
+      },
+      1ms);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadsCount; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < changesPerThread; i++) {
+        listener->onValueChanged(std::to_string(t) + "-" + std::to_string(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::unique_lock lock(mutex);
+  EXPECT(condition.wait_for(lock, 5s, [&]() { return delivered.size() == threadsCount * changesPerThread; }));
+}
+
+static void testCancelDropsPendingChanges() {
+  std::atomic<int> calls = 0;
+  auto listener = std::make_shared<MMKVCoalescingListener>([&](const std::vector<std::string>&) { calls++; }, 20ms);
+
+  listener->onValueChanged("key");
+  listener->cancel();
+  listener->onValueChanged("other-key");
+
+  std::this_thread::sleep_for(100ms);
+  EXPECT(calls == 0);
+}
+
+static void testDestroyedListenerIsNeverCalled() {
+  std::atomic<int> calls = 0;
+  {
+    auto listener = std::make_shared<MMKVCoalescingListener>([&](const std::vector<std::string>&) { calls++; }, 20ms);
+    listener->onValueChanged("key");
+  }
+
+  std::this_thread::sleep_for(100ms);
+  EXPECT(calls == 0);
+}
+
+int main() {
+  testTimerQueueRunsTasksInDeadlineOrder();
+  testBurstIsCoalescedIntoOneCall();
+  testBatchesAreMergedAndDeduplicated();
+  testConcurrentChangesAreNeverLost();
+  testCancelDropsPendingChanges();
+  testDestroyedListenerIsNeverCalled();
+  std::printf("All coalescing listener tests passed.\n");
+  return 0;
+}
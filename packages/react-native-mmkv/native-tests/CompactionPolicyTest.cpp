@@ -0,0 +1,95 @@
+//
+//  CompactionPolicyTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVCompactionPolicy.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+using namespace std::chrono_literals;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+static constexpr size_t MB = 1024 * 1024;
+
+static void testOnlyCompactsFragmentedFiles() {
+  MMKVCompactionPolicy policy(0.5, 50ms);
+  EXPECT(policy.isAutomatic());
+  EXPECT(policy.isFragmented(1 * MB, 4 * MB));
+  EXPECT(!policy.isFragmented(3 * MB, 4 * MB));
+  // Small files are never worth it
+  EXPECT(!policy.isFragmented(0, MMKVCompactionPolicy::MIN_FILE_SIZE - 1));
+  EXPECT(policy.isFragmented(0, MMKVCompactionPolicy::MIN_FILE_SIZE));
+}
+
+static void testNeverCompactsWithoutThreshold() {
+  MMKVCompactionPolicy policy(std::nullopt, 50ms);
+  EXPECT(!policy.isAutomatic());
+  EXPECT(!policy.isFragmented(0, 100 * MB));
+}
+
+static void testBoundsThePause() {
+  MMKVCompactionPolicy policy(0.5, 20ms);
+  // 256 bytes per microsecond until anything was measured
+  EXPECT(policy.isWithinMaxPause(4 * MB));
+  EXPECT(!policy.isWithinMaxPause(8 * MB));
+
+  // A slow device: 1 MB took 10ms, so 4 MB no longer fit into 20ms
+  policy.didCompact(8 * MB, 4 * MB, 1 * MB, 10ms);
+  EXPECT(!policy.isWithinMaxPause(4 * MB));
+  EXPECT(policy.isWithinMaxPause(1 * MB));
+
+  // Too short to be measured reliably - must not change the estimate
+  auto estimate = policy.estimateDuration(1 * MB);
+  policy.didCompact(8 * MB, 4 * MB, 1 * MB, 10us);
+  EXPECT(policy.estimateDuration(1 * MB) == estimate);
+}
+
+static void testCollectsStats() {
+  MMKVCompactionPolicy policy(std::nullopt, 50ms);
+  policy.didCompact(8 * MB, 2 * MB, 1 * MB, 3ms);
+  policy.didCompact(2 * MB, 2 * MB, 1 * MB, 5ms);
+  auto stats = policy.getStats();
+  EXPECT(stats.compactionCount == 2);
+  EXPECT(stats.bytesReclaimed == 6 * MB);
+  EXPECT(stats.totalDuration == 8ms);
+  EXPECT(stats.lastDuration == 5ms);
+  EXPECT(stats.maxDuration == 5ms);
+}
+
+static void testIsThreadSafe() {
+  // Run with -DMMKV_SANITIZER=thread
+  MMKVCompactionPolicy policy(0.5, 50ms);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&policy]() {
+      for (int i = 0; i < 10000; i++) {
+        policy.didCompact(2 * MB, 1 * MB, 1 * MB, 2ms);
+        policy.isWithinMaxPause(1 * MB);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT(policy.getStats().compactionCount == 40000);
+  EXPECT(policy.getStats().bytesReclaimed == 40000 * MB);
+}
+
+int main() {
+  testOnlyCompactsFragmentedFiles();
+  testNeverCompactsWithoutThreshold();
+  testBoundsThePause();
+  testCollectsStats();
+  testIsThreadSafe();
+  std::printf("All compaction policy tests passed.\n");
+  return 0;
+}
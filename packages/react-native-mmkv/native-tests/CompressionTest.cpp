@@ -0,0 +1,170 @@
+//
+//  CompressionTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVCompression.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+static constexpr auto LZ4 = MMKVCompression::Codec::LZ4;
+
+// A JSON array of objects, similar to what apps typically cache
+static std::string createJSON(size_t minSize) {
+  std::mt19937 random(42);
+  std::string json = "[";
+  for (size_t i = 0; json.size() < minSize; i++) {
+    json += R"({"id":)" + std::to_string(i) + R"(,"name":"User )" + std::to_string(random() % 10000) +
+            R"(","email":"user)" + std::to_string(random() % 100000) + R"(@example.com","isActive":)" +
+            (random() % 2 == 0 ? "true" : "false") + R"(,"score":)" + std::to_string(random() % 1000) + "},";
+  }
+  json.back() = ']';
+  return json;
+}
+
+static std::string createRandom(size_t size) {
+  std::mt19937 random(1337);
+  std::string data(size, '\0');
+  for (auto& byte : data) {
+    byte = static_cast<char>(random());
+  }
+  return data;
+}
+
+static std::string roundTrip(const std::string& value, size_t threshold = 0) {
+  auto encoded = MMKVCompression::encode(value.data(), value.size(), LZ4, threshold);
+  if (!encoded.has_value()) {
+    EXPECT(!MMKVCompression::isEncoded(value.data(), value.size()));
+    return value;
+  }
+  EXPECT(MMKVCompression::isEncoded(encoded->data(), encoded->size()));
+  EXPECT(MMKVCompression::getDecodedSize(encoded->data(), encoded->size()) == value.size());
+  return MMKVCompression::decodeToString(encoded->data(), encoded->size());
+}
+
+static void testRoundTripsAllKindsOfData() {
+  std::vector<std::string> values = {
+      "",
+      "a",
+      "hello world",
+      std::string(13, 'x'),
+      std::string(100000, 'x'),
+      "abcabcabcabcabcabcabcabcabcabcabcabcabcabcabcabc",
+      createJSON(1000),
+      createJSON(2 * 1024 * 1024),
+      createRandom(64 * 1024),
+      createJSON(64 * 1024) + createRandom(1024) + createJSON(1024),
+  };
+  for (const auto& value : values) {
+    EXPECT(roundTrip(value) == value);
+  }
+  // Every length around the format's edge cases
+  std::string json = createJSON(512);
+  for (size_t length = 0; length < 300; length++) {
+    std::string value = json.substr(0, length);
+    EXPECT(roundTrip(value) == value);
+  }
+}
+
+static void testOnlyCompressesAboveThreshold() {
+  std::string json = createJSON(8 * 1024);
+  EXPECT(!MMKVCompression::encode(json.data(), json.size(), LZ4, json.size() + 1).has_value());
+  EXPECT(MMKVCompression::encode(json.data(), json.size(), LZ4, json.size()).has_value());
+  EXPECT(!MMKVCompression::encode(json.data(), json.size(), MMKVCompression::Codec::NONE, 0).has_value());
+}
+
+static void testKeepsIncompressibleDataAsIs() {
+  std::string random = createRandom(64 * 1024);
+  EXPECT(!MMKVCompression::encode(random.data(), random.size(), LZ4, 0).has_value());
+}
+
+static void testEscapesValuesThatLookEncoded() {
+  std::string json = createJSON(8 * 1024);
+  auto encoded = MMKVCompression::encode(json.data(), json.size(), LZ4, 0);
+  EXPECT(encoded.has_value());
+  // Storing an already encoded value as-is must give back exactly that value, even without compression.
+  auto escaped = MMKVCompression::encode(encoded->data(), encoded->size(), MMKVCompression::Codec::NONE, 0);
+  EXPECT(escaped.has_value());
+  EXPECT(MMKVCompression::decodeToString(escaped->data(), escaped->size()) == encoded.value());
+  EXPECT(roundTrip(encoded.value()) == encoded.value());
+}
+
+static void testRejectsCorruptedValues() {
+  std::string json = createJSON(16 * 1024);
+  auto encoded = MMKVCompression::encode(json.data(), json.size(), LZ4, 0).value();
+
+  // Truncated
+  for (size_t length = MMKVCompression::HEADER_SIZE; length < encoded.size(); length += 97) {
+    std::string truncated = encoded.substr(0, length);
+    bool threw = false;
+    try {
+      MMKVCompression::decodeToString(truncated.data(), truncated.size());
+    } catch (const std::runtime_error&) {
+      threw = true;
+    }
+    EXPECT(threw);
+  }
+
+  // Random garbage must never read or write out of bounds (run with -DMMKV_SANITIZER=address)
+  std::mt19937 random(7);
+  for (int round = 0; round < 10000; round++) {
+    std::string garbage = encoded;
+    for (int flips = 0; flips < 8; flips++) {
+      size_t index = MMKVCompression::HEADER_SIZE + random() % (garbage.size() - MMKVCompression::HEADER_SIZE);
+      garbage[index] = static_cast<char>(random());
+    }
+    try {
+      MMKVCompression::decodeToString(garbage.data(), garbage.size());
+    } catch (const std::runtime_error&) {
+      // Expected for most of them
+    }
+  }
+}
+
+static void testThroughput() {
+  std::string json = createJSON(1024 * 1024);
+  constexpr int iterations = 20;
+  double megabytes = static_cast<double>(json.size()) * iterations / (1024 * 1024);
+
+  std::optional<std::string> encoded;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    encoded = MMKVCompression::encode(json.data(), json.size(), LZ4, 0);
+  }
+  double compressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::string decoded;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    decoded = MMKVCompression::decodeToString(encoded->data(), encoded->size());
+  }
+  double decompressSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  EXPECT(decoded == json);
+
+  std::printf("1 MB JSON: %.1fx smaller, compress %.0f MB/s, decompress %.0f MB/s\n",
+              static_cast<double>(json.size()) / static_cast<double>(encoded->size()), megabytes / compressSeconds,
+              megabytes / decompressSeconds);
+}
+
+int main() {
+  testRoundTripsAllKindsOfData();
+  testOnlyCompressesAboveThreshold();
+  testKeepsIncompressibleDataAsIs();
+  testEscapesValuesThatLookEncoded();
+  testRejectsCorruptedValues();
+  testThroughput();
+  std::printf("All compression tests passed.\n");
+  return 0;
+}
@@ -0,0 +1,130 @@
+//
+//  ContentChangeObserverTest.cpp
+//  react-native-mmkv
+//
+
+// Writes to a real multi-process MMKV file from a second process, and checks which keys the observer reports.
+// Only built if the MMKV core sources were passed, see `CMakeLists.txt`.
+
+#include "MMKVContentChangeObserver.hpp"
+#include "MMKVTypes.hpp"
+#include "MMKVValueChangedListenerRegistry.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <span>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+using namespace std::chrono_literals;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+static constexpr auto MMKV_ID = "content-change-observer-test";
+
+static MMKV* openInstance(const std::string& rootDir) {
+  MMKV::initializeMMKV(rootDir, MMKVLogNone);
+  MMKV* instance = MMKV::mmkvWithID(MMKV_ID, MMKVConfig{.mode = MMKV_MULTI_PROCESS});
+  EXPECT(instance != nullptr);
+  return instance;
+}
+
+/**
+ * Forks a second process that waits until a byte is written to the returned pipe, then runs `write` on its own
+ * instance of the MMKV file and exits. It is forked before this process opens MMKV or starts any threads.
+ */
+template <typename Func>
+static pid_t forkWriter(const std::string& rootDir, int& startPipe, Func&& write) {
+  int fds[2];
+  EXPECT(pipe(fds) == 0);
+  pid_t pid = fork();
+  EXPECT(pid >= 0);
+  if (pid == 0) {
+    close(fds[1]);
+    char start;
+    if (read(fds[0], &start, 1) != 1) {
+      _exit(2);
+    }
+    MMKV* instance = openInstance(rootDir);
+    write(instance);
+    instance->sync(MMKV_SYNC);
+    _exit(0);
+  }
+  close(fds[0]);
+  startPipe = fds[1];
+  return pid;
+}
+
+static void testReportsKeysChangedByOtherProcess() {
+  char directoryTemplate[] = "/tmp/mmkv-observer-XXXXXX";
+  std::string rootDir = mkdtemp(directoryTemplate);
+
+  int startPipe = -1;
+  pid_t pid = forkWriter(rootDir, startPipe, [](MMKV* instance) {
+    instance->set(std::string("new value"), "changed");
+    instance->removeValueForKey("removed");
+    instance->set(true, "added");
+  });
+
+  MMKV* instance = openInstance(rootDir);
+  instance->clearAll();
+  instance->set(std::string("value"), "unchanged");
+  instance->set(std::string("old value"), "changed");
+  instance->set(42.0, "removed");
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<std::vector<std::string>> batches;
+  // The observer pauses itself without listeners, so add one first
+  ListenerID listenerID = MMKVValueChangedListenerRegistry::addBatchListener(instance->mmapID(), [&](std::span<const std::string> keys) {
+    std::unique_lock lock(mutex);
+    batches.emplace_back(keys.begin(), keys.end());
+    condition.notify_all();
+  });
+  auto observer = MMKVContentChangeObserver::getOrCreate(instance, rootDir);
+  // Give the watcher thread time to fingerprint the values before they change
+  std::this_thread::sleep_for(200ms);
+
+  EXPECT(write(startPipe, "1", 1) == 1);
+  close(startPipe);
+  int status = 0;
+  EXPECT(waitpid(pid, &status, 0) == pid);
+  EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  {
+    std::unique_lock lock(mutex);
+    EXPECT(condition.wait_for(lock, 5s, [&]() { return !batches.empty(); }));
+    std::vector<std::string> keys = batches.front();
+    std::sort(keys.begin(), keys.end());
+    EXPECT((keys == std::vector<std::string>{"added", "changed", "removed"}));
+  }
+  EXPECT(instance->getBool("added"));
+
+  // Nothing changed since, so the next checks must not report anything
+  std::this_thread::sleep_for(2 * MMKVFileWatcher::DEFAULT_POLL_INTERVAL);
+  {
+    std::unique_lock lock(mutex);
+    EXPECT(batches.size() == 1);
+  }
+
+  observer->stop();
+  MMKVValueChangedListenerRegistry::removeListener(instance->mmapID(), listenerID);
+  observer = nullptr;
+  MMKV::removeStorage(MMKV_ID);
+}
+
+int main() {
+  testReportsKeysChangedByOtherProcess();
+  std::printf("All content change observer tests passed.\n");
+  return 0;
+}
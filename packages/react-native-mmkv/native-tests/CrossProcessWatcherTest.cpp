@@ -0,0 +1,170 @@
+//
+//  CrossProcessWatcherTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVFileWatcher.hpp"
+#include "MMKVKeyFingerprints.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <mutex>
+#include <string>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace margelo::nitro::mmkv;
+using namespace std::chrono_literals;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+/**
+ * A file shared between two processes, where the first 8 bytes are a sequence number -
+ * similar to how MMKV's meta file stores a sequence that changes on every full write-back.
+ */
+struct SharedFile {
+  std::string directory;
+  std::string path;
+  int fd;
+  uint64_t* sequence;
+
+  SharedFile() {
+    char directoryTemplate[] = "/tmp/mmkv-watcher-XXXXXX";
+    directory = mkdtemp(directoryTemplate);
+    path = directory + "/shared.crc";
+    fd = open(path.c_str(), O_RDWR | O_CREAT, 0600);
+    EXPECT(fd >= 0);
+    EXPECT(ftruncate(fd, sizeof(uint64_t)) == 0);
+    sequence = static_cast<uint64_t*>(mmap(nullptr, sizeof(uint64_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    EXPECT(sequence != MAP_FAILED);
+  }
+  ~SharedFile() {
+    munmap(sequence, sizeof(uint64_t));
+    close(fd);
+    unlink(path.c_str());
+    rmdir(directory.c_str());
+  }
+};
+
+/**
+ * Forks a second process that runs `write` after a short delay and exits.
+ */
+template <typename Func>
+static pid_t runInOtherProcess(Func&& write) {
+  pid_t pid = fork();
+  EXPECT(pid >= 0);
+  if (pid == 0) {
+    std::this_thread::sleep_for(50ms);
+    write();
+    _exit(0);
+  }
+  return pid;
+}
+
+static void waitForOtherProcess(pid_t pid) {
+  int status = 0;
+  EXPECT(waitpid(pid, &status, 0) == pid);
+  EXPECT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+/**
+ * Runs `test` with a watcher on `file`, which records every time the shared sequence changed.
+ */
+static void expectChangeIsSeen(SharedFile& file, std::chrono::milliseconds pollInterval, std::chrono::milliseconds timeout,
+                               const std::function<pid_t()>& changeInOtherProcess) {
+  std::mutex mutex;
+  std::condition_variable condition;
+  uint64_t lastSeenSequence = *file.sequence;
+  int changes = 0;
+
+  MMKVFileWatcher watcher(file.directory, pollInterval, [&]() {
+    // This is what MMKV's checkContentChanged() does: compare the sequence in the shared meta file.
+    uint64_t sequence = __atomic_load_n(file.sequence, __ATOMIC_ACQUIRE);
+    std::unique_lock lock(mutex);
+    if (sequence != lastSeenSequence) {
+      lastSeenSequence = sequence;
+      changes++;
+      condition.notify_all();
+    }
+  });
+
+  pid_t pid = changeInOtherProcess();
+  {
+    std::unique_lock lock(mutex);
+    EXPECT(condition.wait_for(lock, timeout, [&]() { return changes == 1; }));
+  }
+  waitForOtherProcess(pid);
+}
+
+static void testFileSystemEventsWakeUpTheWatcher() {
+  SharedFile file;
+  // With a very long poll interval, only an inotify event can make the change visible in time.
+  expectChangeIsSeen(file, 10s, 2s, [&]() {
+    return runInOtherProcess([&]() {
+      uint64_t sequence = *file.sequence + 1;
+      EXPECT(pwrite(file.fd, &sequence, sizeof(sequence), 0) == sizeof(sequence));
+    });
+  });
+}
+
+static void testMmapWritesAreSeenByPolling() {
+  SharedFile file;
+  // Writes through mmap don't produce file system events, so polling has to catch them.
+  expectChangeIsSeen(file, 20ms, 2s, [&]() {
+    return runInOtherProcess([&]() { __atomic_add_fetch(file.sequence, 1, __ATOMIC_RELEASE); });
+  });
+}
+
+static void testWakeRunsCallbackImmediately() {
+  SharedFile file;
+  std::atomic<int> calls = 0;
+  MMKVFileWatcher watcher(file.directory, 10s, [&]() { calls++; });
+  watcher.wake();
+  for (int i = 0; i < 200 && calls == 0; i++) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT(calls >= 1);
+}
+
+static void testPausedWatcherDoesNotPoll() {
+  SharedFile file;
+  std::atomic<int> calls = 0;
+  MMKVFileWatcher watcher(file.directory, 10ms, [&]() { calls++; });
+  watcher.pause();
+  // The watcher might still be in its last poll
+  std::this_thread::sleep_for(50ms);
+  int callsWhenPaused = calls;
+  std::this_thread::sleep_for(200ms);
+  EXPECT(calls == callsWhenPaused);
+
+  watcher.resume();
+  for (int i = 0; i < 200 && calls < callsWhenPaused + 3; i++) {
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT(calls >= callsWhenPaused + 3);
+}
+
+static void testDiffKeyFingerprints() {
+  MMKVKeyFingerprints before = {{"unchanged", 1}, {"changed", 2}, {"removed", 3}};
+  MMKVKeyFingerprints after = {{"unchanged", 1}, {"changed", 4}, {"added", 5}};
+  EXPECT((diffKeyFingerprints(before, after) == std::vector<std::string>{"added", "changed", "removed"}));
+  EXPECT(diffKeyFingerprints(after, after).empty());
+}
+
+int main() {
+  testFileSystemEventsWakeUpTheWatcher();
+  testMmapWritesAreSeenByPolling();
+  testWakeRunsCallbackImmediately();
+  testPausedWatcherDoesNotPoll();
+  testDiffKeyFingerprints();
+  std::printf("All cross-process watcher tests passed.\n");
+  return 0;
+}
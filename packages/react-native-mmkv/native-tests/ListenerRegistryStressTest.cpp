@@ -0,0 +1,190 @@
+//
+//  ListenerRegistryStressTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVValueChangedListenerRegistry.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+static void testListenerCanRemoveItselfWhileBeingNotified() {
+  const std::string mmkvID = "self-removal";
+  std::atomic<int> calls = 0;
+  ListenerID id = 0;
+  id = MMKVValueChangedListenerRegistry::addListener(mmkvID, [&](const std::string&) {
+    calls++;
+    MMKVValueChangedListenerRegistry::removeListener(mmkvID, id);
+  });
+  int otherCalls = 0;
+  ListenerID otherID = MMKVValueChangedListenerRegistry::addListener(mmkvID, [&](const std::string&) { otherCalls++; });
+
+  MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, "key");
+  MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, "key");
+
+  EXPECT(calls == 1);
+  EXPECT(otherCalls == 2);
+  MMKVValueChangedListenerRegistry::removeListener(mmkvID, otherID);
+}
+
+static void testScopedListeners() {
+  const std::string mmkvID = "scoped";
+  int keyCalls = 0;
+  int prefixCalls = 0;
+  ListenerID keyID = MMKVValueChangedListenerRegistry::addKeyListener(mmkvID, "user.name", [&](const std::string&) { keyCalls++; });
+  ListenerID prefixID = MMKVValueChangedListenerRegistry::addPrefixListener(mmkvID, "user.", [&](const std::string&) { prefixCalls++; });
+
+  MMKVValueChangedListenerRegistry::notifyOnValuesChanged(mmkvID, {"user.name", "user.age", "settings.theme"});
+  EXPECT(keyCalls == 1);
+  EXPECT(prefixCalls == 2);
+  EXPECT(MMKVValueChangedListenerRegistry::getListenerCount(mmkvID) == 2);
+
+  MMKVValueChangedListenerRegistry::removeListener(mmkvID, keyID);
+  MMKVValueChangedListenerRegistry::removeListener(mmkvID, prefixID);
+  EXPECT(MMKVValueChangedListenerRegistry::getListenerCount(mmkvID) == 0);
+  MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, "user.name");
+  EXPECT(keyCalls == 1);
+  EXPECT(prefixCalls == 2);
+}
+
+static void testBatchListenersAreCalledOncePerChange() {
+  const std::string mmkvID = "batches";
+  std::vector<std::vector<std::string>> calls;
+  int keyCalls = 0;
+  ListenerID batchID = MMKVValueChangedListenerRegistry::addBatchListener(
+      mmkvID, [&](std::span<const std::string> keys) { calls.emplace_back(keys.begin(), keys.end()); });
+  ListenerID keyID = MMKVValueChangedListenerRegistry::addListener(mmkvID, [&](const std::string&) { keyCalls++; });
+
+  MMKVValueChangedListenerRegistry::notifyOnValuesChanged(mmkvID, {"a", "b", "c"});
+  MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, "d");
+  EXPECT(calls.size() == 2);
+  EXPECT((calls[0] == std::vector<std::string>{"a", "b", "c"}));
+  EXPECT((calls[1] == std::vector<std::string>{"d"}));
+  EXPECT(keyCalls == 4);
+  EXPECT(MMKVValueChangedListenerRegistry::getListenerCount(mmkvID) == 2);
+
+  MMKVValueChangedListenerRegistry::removeListener(mmkvID, batchID);
+  MMKVValueChangedListenerRegistry::removeListener(mmkvID, keyID);
+  EXPECT(MMKVValueChangedListenerRegistry::getListenerCount(mmkvID) == 0);
+  MMKVValueChangedListenerRegistry::notifyOnValuesChanged(mmkvID, {"a"});
+  EXPECT(calls.size() == 2);
+}
+
+static void testManyKeyListeners() {
+  const std::string mmkvID = "many-keys";
+  constexpr int keysCount = 1000;
+  std::vector<int> calls(keysCount, 0);
+  std::vector<ListenerID> ids;
+  for (int i = 0; i < keysCount; i++) {
+    // Two listeners per key, so keys share shards and listeners share keys
+    for (int j = 0; j < 2; j++) {
+      ids.push_back(MMKVValueChangedListenerRegistry::addKeyListener(mmkvID, "key-" + std::to_string(i), [&calls, i](const std::string&) {
+        calls[i]++;
+      }));
+    }
+  }
+  EXPECT(MMKVValueChangedListenerRegistry::getListenerCount(mmkvID) == 2 * keysCount);
+
+  // Remove both listeners of every even key, and one listener of every odd key
+  for (int i = 0; i < keysCount; i++) {
+    MMKVValueChangedListenerRegistry::removeListener(mmkvID, ids[2 * i]);
+    if (i % 2 == 0) {
+      MMKVValueChangedListenerRegistry::removeListener(mmkvID, ids[2 * i + 1]);
+    }
+  }
+  EXPECT(MMKVValueChangedListenerRegistry::getListenerCount(mmkvID) == keysCount / 2);
+  for (int i = 0; i < keysCount; i++) {
+    MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, "key-" + std::to_string(i));
+    EXPECT(calls[i] == i % 2);
+  }
+
+  for (int i = 1; i < keysCount; i += 2) {
+    MMKVValueChangedListenerRegistry::removeListener(mmkvID, ids[2 * i + 1]);
+  }
+  EXPECT(MMKVValueChangedListenerRegistry::getListenerCount(mmkvID) == 0);
+}
+
+static void testConcurrentNotifyAndSubscribe() {
+  const std::string mmkvID = "stress";
+  constexpr int notifierThreads = 4;
+  constexpr int subscriberThreads = 4;
+  constexpr int notificationsPerThread = 20000;
+  constexpr int subscriptionsPerThread = 2000;
+
+  // A listener that stays subscribed the whole time must see every notification.
+  std::atomic<int> permanentCalls = 0;
+  ListenerID permanentID =
+      MMKVValueChangedListenerRegistry::addKeyListener(mmkvID, "key-0", [&](const std::string&) { permanentCalls.fetch_add(1); });
+
+  std::atomic<int> transientCalls = 0;
+  std::atomic<bool> start = false;
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < notifierThreads; t++) {
+    threads.emplace_back([&]() {
+      while (!start) {
+      }
+      for (int i = 0; i < notificationsPerThread; i++) {
+        MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, "key-" + std::to_string(i % 4));
+      }
+    });
+  }
+  for (int t = 0; t < subscriberThreads; t++) {
+    threads.emplace_back([&, t]() {
+      while (!start) {
+      }
+      for (int i = 0; i < subscriptionsPerThread; i++) {
+        auto callback = [&](const std::string&) { transientCalls.fetch_add(1); };
+        ListenerID id;
+        switch ((t + i) % 3) {
+          case 0:
+            id = MMKVValueChangedListenerRegistry::addListener(mmkvID, callback);
+            break;
+          case 1:
+            id = MMKVValueChangedListenerRegistry::addKeyListener(mmkvID, "key-" + std::to_string(i % 4), callback);
+            break;
+          default:
+            id = MMKVValueChangedListenerRegistry::addPrefixListener(mmkvID, "key-", callback);
+            break;
+        }
+        MMKVValueChangedListenerRegistry::removeListener(mmkvID, id);
+      }
+    });
+  }
+
+  start = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT(permanentCalls == notifierThreads * notificationsPerThread / 4);
+  MMKVValueChangedListenerRegistry::removeListener(mmkvID, permanentID);
+
+  // After everything has been removed, nothing must be called anymore.
+  int callsBefore = transientCalls;
+  MMKVValueChangedListenerRegistry::notifyOnValueChanged(mmkvID, "key-0");
+  EXPECT(transientCalls == callsBefore);
+  EXPECT(permanentCalls == notifierThreads * notificationsPerThread / 4);
+}
+
+int main() {
+  testListenerCanRemoveItselfWhileBeingNotified();
+  testScopedListeners();
+  testBatchListenersAreCalledOncePerChange();
+  testManyKeyListeners();
+  testConcurrentNotifyAndSubscribe();
+  std::printf("All listener registry tests passed.\n");
+  return 0;
+}
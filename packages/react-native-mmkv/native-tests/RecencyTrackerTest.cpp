@@ -0,0 +1,120 @@
+//
+//  RecencyTrackerTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVRecencyTracker.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+static void testOrdersKeysByLastAccess() {
+  MMKVRecencyTracker tracker(1024);
+  tracker.touch("a");
+  tracker.touch("b");
+  tracker.touch("c");
+  tracker.touch("a");
+
+  auto keys = tracker.sortByRecency({"a", "b", "c"});
+  EXPECT((keys == std::vector<std::string>{"b", "c", "a"}));
+}
+
+static void testUntouchedKeysAreLeastRecentlyUsed() {
+  MMKVRecencyTracker tracker(1024);
+  tracker.touch("recent");
+
+  auto keys = tracker.sortByRecency({"recent", "old"});
+  EXPECT((keys == std::vector<std::string>{"old", "recent"}));
+}
+
+static void testClearForgetsAllAccesses() {
+  MMKVRecencyTracker tracker(1024);
+  tracker.touch("a");
+  tracker.touch("b");
+  tracker.clear();
+  tracker.touch("a");
+
+  auto keys = tracker.sortByRecency({"a", "b"});
+  EXPECT((keys == std::vector<std::string>{"b", "a"}));
+}
+
+static void testRoundsCapacityUpToPowerOfTwo() {
+  EXPECT(MMKVRecencyTracker(1000).capacity() == 1024);
+  EXPECT(MMKVRecencyTracker(0).capacity() == 1);
+}
+
+static void testCollidingKeysShareTheirLastAccess() {
+  // A single slot - all keys collide
+  MMKVRecencyTracker tracker(1);
+  tracker.touch("a");
+  auto keys = tracker.sortByRecency({"a", "b"});
+  // Both look equally recent, so the order of the input is kept
+  EXPECT((keys == std::vector<std::string>{"a", "b"}));
+}
+
+static void testConcurrentTouchesAndSorts() {
+  MMKVRecencyTracker tracker(512);
+  std::atomic<bool> isRunning = true;
+  std::vector<std::string> allKeys;
+  for (int i = 0; i < 512; i++) {
+    allKeys.push_back("key-" + std::to_string(i));
+  }
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; t++) {
+    readers.emplace_back([&, t]() {
+      size_t i = 0;
+      while (isRunning) {
+        tracker.touch(allKeys[(i++ * (t + 1)) % allKeys.size()]);
+      }
+    });
+  }
+  for (int round = 0; round < 100; round++) {
+    EXPECT(tracker.sortByRecency(allKeys).size() == allKeys.size());
+  }
+  isRunning = false;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
+
+static void testTouchOverhead() {
+  MMKVRecencyTracker tracker(16 * 1024);
+  std::vector<std::string> keys;
+  for (int i = 0; i < 1000; i++) {
+    keys.push_back("some.realistic.key." + std::to_string(i));
+  }
+
+  constexpr size_t iterations = 1'000'000;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    tracker.touch(keys[i % keys.size()]);
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  double nanoseconds = std::chrono::duration<double, std::nano>(duration).count() / iterations;
+  std::printf("touch(...): %.1fns\n", nanoseconds);
+}
+
+int main() {
+  testOrdersKeysByLastAccess();
+  testUntouchedKeysAreLeastRecentlyUsed();
+  testClearForgetsAllAccesses();
+  testRoundsCapacityUpToPowerOfTwo();
+  testCollidingKeysShareTheirLastAccess();
+  testConcurrentTouchesAndSorts();
+  testTouchOverhead();
+  std::printf("All recency tracker tests passed.\n");
+  return 0;
+}
@@ -0,0 +1,136 @@
+//
+//  StatsRecorderTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVStatsRecorder.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+using namespace std::chrono_literals;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+#if MMKV_ENABLE_STATS
+
+static void testRecordsHistograms() {
+  MMKVStatsRecorder recorder;
+  for (int i = 0; i < 98; i++) {
+    recorder.record(MMKVOperation::GET, 100ns);
+  }
+  recorder.record(MMKVOperation::GET, 5us);
+  recorder.record(MMKVOperation::GET, 10s);
+  recorder.record(MMKVOperation::SET, 1us);
+
+  auto snapshot = recorder.getSnapshot();
+  const auto& gets = snapshot[MMKVOperation::GET];
+  EXPECT(gets.count == 100);
+  EXPECT(gets.totalNanoseconds == 98 * 100 + 5'000 + 10'000'000'000ULL);
+  // 100ns is in [64, 128)
+  EXPECT(gets.buckets[7] == 98);
+  EXPECT(gets.getPercentile(0.5) == 128);
+  EXPECT(gets.getPercentile(0.99) == 8192);
+  // Way too slow for any bucket, so it goes into the last one
+  EXPECT(gets.buckets[MMKVStatsRecorder::BUCKET_COUNT - 1] == 1);
+  EXPECT(snapshot[MMKVOperation::SET].count == 1);
+  EXPECT(snapshot[MMKVOperation::REMOVE].count == 0);
+  EXPECT(snapshot[MMKVOperation::REMOVE].getPercentile(0.5) == 0);
+}
+
+static void testDetectsFileEvents() {
+  MMKVStatsRecorder recorder;
+  recorder.didObserveSizes(4096, 100);
+  recorder.didObserveSizes(4096, 300);
+  // Grown
+  recorder.didObserveSizes(8192, 5000);
+  // Rewritten
+  recorder.didObserveSizes(8192, 2000);
+  recorder.didObserveSizes(8192, 2100);
+
+  auto snapshot = recorder.getSnapshot();
+  EXPECT(snapshot.bytesWritten == 200 + 4700 + 100);
+  EXPECT(snapshot.fileGrowths == 1);
+  EXPECT(snapshot.fullWriteBacks == 1);
+}
+
+static void testMergesSnapshots() {
+  MMKVStatsRecorder first;
+  MMKVStatsRecorder second;
+  first.record(MMKVOperation::NOTIFY, 1us);
+  second.record(MMKVOperation::NOTIFY, 1us);
+  second.didObserveSizes(4096, 0);
+  second.didObserveSizes(8192, 10);
+
+  auto total = first.getSnapshot();
+  total += second.getSnapshot();
+  EXPECT(total[MMKVOperation::NOTIFY].count == 2);
+  EXPECT(total.fileGrowths == 1);
+  EXPECT(total.bytesWritten == 10);
+}
+
+static void testCountsFromManyThreads() {
+  // Run with -DMMKV_SANITIZER=thread
+  MMKVStatsRecorder recorder;
+  constexpr int threadCount = 8;
+  constexpr int iterations = 100000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; t++) {
+    threads.emplace_back([&recorder]() {
+      for (int i = 0; i < iterations; i++) {
+        recorder.record(MMKVOperation::SET, 200ns);
+      }
+    });
+  }
+  // Reading while writing is allowed
+  for (int i = 0; i < 100; i++) {
+    EXPECT(recorder.getSnapshot()[MMKVOperation::SET].count <= threadCount * iterations);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT(recorder.getSnapshot()[MMKVOperation::SET].count == threadCount * iterations);
+}
+
+static void testOverhead() {
+  MMKVStatsRecorder recorder;
+  constexpr int iterations = 1'000'000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    MMKVOperationTimer timer(&recorder, MMKVOperation::GET);
+  }
+  double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+  std::printf("Timed operation overhead: %.1fns\n", nanoseconds);
+  EXPECT(recorder.getSnapshot()[MMKVOperation::GET].count == iterations);
+}
+
+int main() {
+  testRecordsHistograms();
+  testDetectsFileEvents();
+  testMergesSnapshots();
+  testCountsFromManyThreads();
+  testOverhead();
+  std::printf("All stats recorder tests passed.\n");
+  return 0;
+}
+
+#else
+
+int main() {
+  // Nothing may be left of the timer that sits in every hot path
+  static_assert(std::is_empty_v<MMKVOperationTimer>);
+  static_assert(!MMKVStatsRecorder::IS_ENABLED);
+  MMKVOperationTimer timer(nullptr, MMKVOperation::GET);
+  std::printf("Stats are compiled out.\n");
+  return 0;
+}
+
+#endif
@@ -0,0 +1,120 @@
+//
+//  ThreadPoolTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+using namespace std::chrono_literals;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+static void testRunsAllTasksBeforeShuttingDown() {
+  std::atomic<int> calls = 0;
+  {
+    MMKVThreadPool pool(2);
+    for (int i = 0; i < 1000; i++) {
+      pool.run([&]() { calls++; });
+    }
+  }
+  EXPECT(calls == 1000);
+}
+
+static void testNeverSpawnsMoreThanMaxThreads() {
+  std::mutex mutex;
+  std::set<std::thread::id> threadIDs;
+  {
+    MMKVThreadPool pool(3);
+    for (int i = 0; i < 100; i++) {
+      pool.run([&]() {
+        std::this_thread::sleep_for(1ms);
+        std::unique_lock lock(mutex);
+        threadIDs.insert(std::this_thread::get_id());
+      });
+    }
+  }
+  EXPECT(threadIDs.size() >= 1);
+  EXPECT(threadIDs.size() <= 3);
+  EXPECT(!threadIDs.contains(std::this_thread::get_id()));
+}
+
+static void testKeepsCapturedBuffersAliveUntilTaskRan() {
+  auto buffer = std::make_shared<std::vector<uint8_t>>(1024 * 1024, 42);
+  std::weak_ptr<std::vector<uint8_t>> weakBuffer = buffer;
+  std::atomic<bool> sawBuffer = false;
+  {
+    MMKVThreadPool pool(1);
+    pool.run([]() { std::this_thread::sleep_for(20ms); });
+    pool.run([&sawBuffer, buffer = std::move(buffer)]() { sawBuffer = buffer->size() == 1024 * 1024 && (*buffer)[0] == 42; });
+    // The caller no longer holds the buffer - only the pending task does
+    EXPECT(!weakBuffer.expired());
+  }
+  EXPECT(sawBuffer);
+  EXPECT(weakBuffer.expired());
+}
+
+static void testThrowingTaskDoesNotStopWorker() {
+  std::atomic<int> calls = 0;
+  {
+    MMKVThreadPool pool(1);
+    pool.run([]() { throw std::runtime_error("Task failed!"); });
+    pool.run([&]() { calls++; });
+  }
+  EXPECT(calls == 1);
+}
+
+static void testTaskCanReleaseTheLastReferenceToThePool() {
+  // Like a `HybridMMKV` that owns its pool and is only kept alive by one of its tasks
+  struct Owner {
+    std::shared_ptr<MMKVThreadPool> pool = std::make_shared<MMKVThreadPool>(1);
+    std::atomic<bool>* wasDestroyed;
+    ~Owner() {
+      pool = nullptr;
+      *wasDestroyed = true;
+    }
+  };
+  std::atomic<bool> wasDestroyed = false;
+  std::atomic<bool> wasReleased = false;
+  auto owner = std::make_shared<Owner>();
+  owner->wasDestroyed = &wasDestroyed;
+  owner->pool->run([owner, &wasReleased]() {
+    while (!wasReleased) {
+      std::this_thread::sleep_for(1ms);
+    }
+  });
+  owner = nullptr;
+  wasReleased = true;
+
+  auto deadline = std::chrono::steady_clock::now() + 5s;
+  while (!wasDestroyed && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(1ms);
+  }
+  EXPECT(wasDestroyed);
+  // Let the detached worker exit
+  std::this_thread::sleep_for(10ms);
+}
+
+int main() {
+  testRunsAllTasksBeforeShuttingDown();
+  testNeverSpawnsMoreThanMaxThreads();
+  testKeepsCapturedBuffersAliveUntilTaskRan();
+  testThrowingTaskDoesNotStopWorker();
+  testTaskCanReleaseTheLastReferenceToThePool();
+  std::printf("All thread pool tests passed.\n");
+  return 0;
+}
@@ -0,0 +1,159 @@
+//
+//  TracerTest.cpp
+//  react-native-mmkv
+//
+
+#include "MMKVChromeTraceSink.hpp"
+#include "MMKVTracer.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace margelo::nitro::mmkv;
+
+#define EXPECT(condition)                                                                                                                  \
+  if (!(condition)) {                                                                                                                      \
+    std::fprintf(stderr, "%s:%d: Expectation failed: %s\n", __FILE__, __LINE__, #condition);                                              \
+    std::exit(1);                                                                                                                          \
+  }
+
+class RecordingSink final : public MMKVTraceSink {
+public:
+  void beginEvent(const MMKVTraceEvent& event) override {
+    begins.push_back(event.name);
+  }
+  void endEvent(const MMKVTraceEvent& event) override {
+    ends.push_back(event);
+  }
+
+public:
+  std::vector<std::string> begins;
+  std::vector<MMKVTraceEvent> ends;
+};
+
+static std::string readFile(const std::filesystem::path& path) {
+  std::ifstream file(path);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+static void testDoesNothingWithoutSink() {
+  MMKVTracer::setSink(nullptr);
+  EXPECT(!MMKVTracer::isEnabled());
+  MMKVTraceScope scope("getString", "instance", 3);
+  scope.setValueSize(10);
+}
+
+static void testSendsScopedEvents() {
+  auto sink = std::make_shared<RecordingSink>();
+  MMKVTracer::setSink(sink);
+  {
+    MMKVTraceScope scope("getString", "instance", 3);
+    EXPECT(sink->begins.size() == 1);
+    EXPECT(sink->ends.empty());
+    scope.setValueSize(10);
+  }
+  MMKVTracer::setSink(nullptr);
+
+  EXPECT(sink->ends.size() == 1);
+  const auto& event = sink->ends[0];
+  EXPECT(std::string(event.name) == "getString");
+  EXPECT(event.keySize == 3);
+  EXPECT(event.valueSize == 10);
+  EXPECT(event.duration.count() >= 0);
+}
+
+static void testEndsEventsOnReplacedSink() {
+  auto first = std::make_shared<RecordingSink>();
+  auto second = std::make_shared<RecordingSink>();
+  MMKVTracer::setSink(first);
+  {
+    MMKVTraceScope scope("trim", "instance");
+    MMKVTracer::setSink(second);
+  }
+  MMKVTracer::setSink(nullptr);
+  EXPECT(first->begins.size() == 1);
+  EXPECT(first->ends.size() == 1);
+  EXPECT(second->ends.empty());
+}
+
+static void testWritesChromeTraceFile() {
+  auto path = std::filesystem::temp_directory_path() / "mmkv-tracer-test.json";
+  auto sink = std::make_shared<MMKVChromeTraceSink>(path.string());
+  MMKVTracer::setSink(sink);
+  {
+    MMKVTraceScope scope("set", "weird \"id\"\n", 5, 42);
+  }
+  std::thread([]() { MMKVTraceScope scope("getNumber", "other", 4, 8); }).join();
+  MMKVTracer::setSink(nullptr);
+  sink->close();
+
+  std::string trace = readFile(path);
+  EXPECT(trace.starts_with("[\n"));
+  EXPECT(trace.ends_with("\n]\n"));
+  EXPECT(trace.find(R"("name":"set","ph":"X")") != std::string::npos);
+  EXPECT(trace.find(R"("keySize":5,"valueSize":42)") != std::string::npos);
+  EXPECT(trace.find(R"("instanceId":"weird \"id\"\u000a")") != std::string::npos);
+  EXPECT(trace.find(R"("name":"getNumber")") != std::string::npos);
+  // Exactly two events, separated by a comma
+  EXPECT(trace.find("},\n{") != std::string::npos);
+  EXPECT(trace.find("},\n{", trace.find("},\n{") + 1) == std::string::npos);
+  std::filesystem::remove(path);
+}
+
+static void testTracesFromManyThreads() {
+  // Run with -DMMKV_SANITIZER=thread
+  auto path = std::filesystem::temp_directory_path() / "mmkv-tracer-threads-test.json";
+  auto sink = std::make_shared<MMKVChromeTraceSink>(path.string());
+  constexpr int threadCount = 8;
+  constexpr int iterations = 10000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; t++) {
+    threads.emplace_back([t]() {
+      for (int i = 0; i < iterations; i++) {
+        MMKVTraceScope scope("set", "instance", 3, 3);
+      }
+      if (t == 0) {
+        // Tracing may be switched on and off while other threads are tracing
+        MMKVTracer::setSink(nullptr);
+      }
+    });
+  }
+  MMKVTracer::setSink(sink);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  MMKVTracer::setSink(nullptr);
+  sink->close();
+
+  std::string trace = readFile(path);
+  EXPECT(trace.ends_with("\n]\n"));
+  std::filesystem::remove(path);
+}
+
+static void testThrowsForInvalidPath() {
+  bool didThrow = false;
+  try {
+    MMKVChromeTraceSink sink("/this/directory/does/not/exist/trace.json");
+  } catch (const std::runtime_error&) {
+    didThrow = true;
+  }
+  EXPECT(didThrow);
+}
+
+int main() {
+  testDoesNothingWithoutSink();
+  testSendsScopedEvents();
+  testEndsEventsOnReplacedSink();
+  testWritesChromeTraceFile();
+  testTracesFromManyThreads();
+  testThrowsForInvalidPath();
+  std::printf("All tracer tests passed.\n");
+  return 0;
+}
@@ -34,6 +34,7 @@ target_sources(
   ../nitrogen/generated/android/NitroMmkvOnLoad.cpp
   # Shared Nitrogen C++ sources
   ../nitrogen/generated/shared/c++/HybridMMKVSpec.cpp
+  ../nitrogen/generated/shared/c++/HybridKeyHandleSpec.cpp
   ../nitrogen/generated/shared/c++/HybridMMKVFactorySpec.cpp
   ../nitrogen/generated/shared/c++/HybridMMKVPlatformContextSpec.cpp
   # Android-specific Nitrogen C++ sources
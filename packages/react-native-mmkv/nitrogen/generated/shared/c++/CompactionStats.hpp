@@ -0,0 +1,99 @@
+///
+/// CompactionStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * A struct which can be represented as a JavaScript object (CompactionStats).
+   */
+  struct CompactionStats final {
+  public:
+    double count     SWIFT_PRIVATE;
+    double bytesReclaimed     SWIFT_PRIVATE;
+    double totalDurationMs     SWIFT_PRIVATE;
+    double lastDurationMs     SWIFT_PRIVATE;
+    double maxDurationMs     SWIFT_PRIVATE;
+
+  public:
+    CompactionStats() = default;
+    explicit CompactionStats(double count, double bytesReclaimed, double totalDurationMs, double lastDurationMs, double maxDurationMs): count(count), bytesReclaimed(bytesReclaimed), totalDurationMs(totalDurationMs), lastDurationMs(lastDurationMs), maxDurationMs(maxDurationMs) {}
+
+  public:
+    friend bool operator==(const CompactionStats& lhs, const CompactionStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ CompactionStats <> JS CompactionStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::CompactionStats> final {
+    static inline margelo::nitro::mmkv::CompactionStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::mmkv::CompactionStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "count"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesReclaimed"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "totalDurationMs"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "lastDurationMs"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxDurationMs")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::mmkv::CompactionStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "count"), JSIConverter<double>::toJSI(runtime, arg.count));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "bytesReclaimed"), JSIConverter<double>::toJSI(runtime, arg.bytesReclaimed));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "totalDurationMs"), JSIConverter<double>::toJSI(runtime, arg.totalDurationMs));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "lastDurationMs"), JSIConverter<double>::toJSI(runtime, arg.lastDurationMs));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxDurationMs"), JSIConverter<double>::toJSI(runtime, arg.maxDurationMs));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "count")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesReclaimed")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "totalDurationMs")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "lastDurationMs")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxDurationMs")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
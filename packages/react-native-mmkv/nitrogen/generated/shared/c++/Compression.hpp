@@ -0,0 +1,76 @@
+///
+/// Compression.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * An enum which can be represented as a JavaScript union (Compression).
+   */
+  enum class Compression {
+    NONE      SWIFT_NAME(none) = 0,
+    LZ4      SWIFT_NAME(lz4) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ Compression <> JS Compression (union)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::Compression> final {
+    static inline margelo::nitro::mmkv::Compression fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("none"): return margelo::nitro::mmkv::Compression::NONE;
+        case hashString("lz4"): return margelo::nitro::mmkv::Compression::LZ4;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum Compression - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::mmkv::Compression arg) {
+      switch (arg) {
+        case margelo::nitro::mmkv::Compression::NONE: return JSIConverter<std::string>::toJSI(runtime, "none");
+        case margelo::nitro::mmkv::Compression::LZ4: return JSIConverter<std::string>::toJSI(runtime, "lz4");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert Compression to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("none"):
+        case hashString("lz4"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
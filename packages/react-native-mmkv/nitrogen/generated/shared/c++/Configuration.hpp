@@ -32,11 +32,17 @@
 namespace margelo::nitro::mmkv { enum class EncryptionType; }
 // Forward declaration of `Mode` to properly resolve imports.
 namespace margelo::nitro::mmkv { enum class Mode; }
+// Forward declaration of `SyncPolicy` to properly resolve imports.
+namespace margelo::nitro::mmkv { enum class SyncPolicy; }
+// Forward declaration of `Compression` to properly resolve imports.
+namespace margelo::nitro::mmkv { enum class Compression; }
 
 #include <string>
 #include <optional>
 #include "EncryptionType.hpp"
 #include "Mode.hpp"
+#include "SyncPolicy.hpp"
+#include "Compression.hpp"
 
 namespace margelo::nitro::mmkv {
 
@@ -52,10 +58,20 @@ namespace margelo::nitro::mmkv {
     std::optional<Mode> mode     SWIFT_PRIVATE;
     std::optional<bool> readOnly     SWIFT_PRIVATE;
     std::optional<bool> compareBeforeSet     SWIFT_PRIVATE;
+    std::optional<SyncPolicy> syncPolicy     SWIFT_PRIVATE;
+    std::optional<double> syncIntervalMs     SWIFT_PRIVATE;
+    std::optional<bool> lazy     SWIFT_PRIVATE;
+    std::optional<double> defaultTTLSeconds     SWIFT_PRIVATE;
+    std::optional<double> maxBytes     SWIFT_PRIVATE;
+    std::optional<double> maxEntries     SWIFT_PRIVATE;
+    std::optional<Compression> compression     SWIFT_PRIVATE;
+    std::optional<double> compressionThresholdBytes     SWIFT_PRIVATE;
+    std::optional<double> blobThresholdBytes     SWIFT_PRIVATE;
+    std::optional<double> autoCompactionThreshold     SWIFT_PRIVATE;
 
   public:
     Configuration() = default;
-    explicit Configuration(std::string id, std::optional<std::string> path, std::optional<std::string> encryptionKey, std::optional<EncryptionType> encryptionType, std::optional<Mode> mode, std::optional<bool> readOnly, std::optional<bool> compareBeforeSet): id(id), path(path), encryptionKey(encryptionKey), encryptionType(encryptionType), mode(mode), readOnly(readOnly), compareBeforeSet(compareBeforeSet) {}
+    explicit Configuration(std::string id, std::optional<std::string> path, std::optional<std::string> encryptionKey, std::optional<EncryptionType> encryptionType, std::optional<Mode> mode, std::optional<bool> readOnly, std::optional<bool> compareBeforeSet, std::optional<SyncPolicy> syncPolicy, std::optional<double> syncIntervalMs, std::optional<bool> lazy, std::optional<double> defaultTTLSeconds, std::optional<double> maxBytes, std::optional<double> maxEntries, std::optional<Compression> compression, std::optional<double> compressionThresholdBytes, std::optional<double> blobThresholdBytes, std::optional<double> autoCompactionThreshold): id(id), path(path), encryptionKey(encryptionKey), encryptionType(encryptionType), mode(mode), readOnly(readOnly), compareBeforeSet(compareBeforeSet), syncPolicy(syncPolicy), syncIntervalMs(syncIntervalMs), lazy(lazy), defaultTTLSeconds(defaultTTLSeconds), maxBytes(maxBytes), maxEntries(maxEntries), compression(compression), compressionThresholdBytes(compressionThresholdBytes), blobThresholdBytes(blobThresholdBytes), autoCompactionThreshold(autoCompactionThreshold) {}
 
   public:
     friend bool operator==(const Configuration& lhs, const Configuration& rhs) = default;
@@ -77,7 +93,17 @@ namespace margelo::nitro {
         JSIConverter<std::optional<margelo::nitro::mmkv::EncryptionType>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "encryptionType"))),
         JSIConverter<std::optional<margelo::nitro::mmkv::Mode>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mode"))),
         JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "readOnly"))),
-        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compareBeforeSet")))
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compareBeforeSet"))),
+        JSIConverter<std::optional<margelo::nitro::mmkv::SyncPolicy>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "syncPolicy"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "syncIntervalMs"))),
+        JSIConverter<std::optional<bool>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "lazy"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "defaultTTLSeconds"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxBytes"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxEntries"))),
+        JSIConverter<std::optional<margelo::nitro::mmkv::Compression>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compression"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compressionThresholdBytes"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "blobThresholdBytes"))),
+        JSIConverter<std::optional<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "autoCompactionThreshold")))
       );
     }
     static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::mmkv::Configuration& arg) {
@@ -89,6 +115,16 @@ namespace margelo::nitro {
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "mode"), JSIConverter<std::optional<margelo::nitro::mmkv::Mode>>::toJSI(runtime, arg.mode));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "readOnly"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.readOnly));
       obj.setProperty(runtime, PropNameIDCache::get(runtime, "compareBeforeSet"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.compareBeforeSet));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "syncPolicy"), JSIConverter<std::optional<margelo::nitro::mmkv::SyncPolicy>>::toJSI(runtime, arg.syncPolicy));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "syncIntervalMs"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.syncIntervalMs));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "lazy"), JSIConverter<std::optional<bool>>::toJSI(runtime, arg.lazy));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "defaultTTLSeconds"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.defaultTTLSeconds));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxBytes"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxBytes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "maxEntries"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.maxEntries));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "compression"), JSIConverter<std::optional<margelo::nitro::mmkv::Compression>>::toJSI(runtime, arg.compression));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "compressionThresholdBytes"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.compressionThresholdBytes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "blobThresholdBytes"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.blobThresholdBytes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "autoCompactionThreshold"), JSIConverter<std::optional<double>>::toJSI(runtime, arg.autoCompactionThreshold));
       return obj;
     }
     static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
@@ -106,6 +142,16 @@ namespace margelo::nitro {
       if (!JSIConverter<std::optional<margelo::nitro::mmkv::Mode>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "mode")))) return false;
       if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "readOnly")))) return false;
       if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compareBeforeSet")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::mmkv::SyncPolicy>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "syncPolicy")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "syncIntervalMs")))) return false;
+      if (!JSIConverter<std::optional<bool>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "lazy")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "defaultTTLSeconds")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxBytes")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "maxEntries")))) return false;
+      if (!JSIConverter<std::optional<margelo::nitro::mmkv::Compression>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compression")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "compressionThresholdBytes")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "blobThresholdBytes")))) return false;
+      if (!JSIConverter<std::optional<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "autoCompactionThreshold")))) return false;
       return true;
     }
   };
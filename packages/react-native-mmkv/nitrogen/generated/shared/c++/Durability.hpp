@@ -0,0 +1,76 @@
+///
+/// Durability.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * An enum which can be represented as a JavaScript union (Durability).
+   */
+  enum class Durability {
+    ASYNC      SWIFT_NAME(async) = 0,
+    SYNC      SWIFT_NAME(sync) = 1,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ Durability <> JS Durability (union)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::Durability> final {
+    static inline margelo::nitro::mmkv::Durability fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("async"): return margelo::nitro::mmkv::Durability::ASYNC;
+        case hashString("sync"): return margelo::nitro::mmkv::Durability::SYNC;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum Durability - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::mmkv::Durability arg) {
+      switch (arg) {
+        case margelo::nitro::mmkv::Durability::ASYNC: return JSIConverter<std::string>::toJSI(runtime, "async");
+        case margelo::nitro::mmkv::Durability::SYNC: return JSIConverter<std::string>::toJSI(runtime, "sync");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert Durability to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("async"):
+        case hashString("sync"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
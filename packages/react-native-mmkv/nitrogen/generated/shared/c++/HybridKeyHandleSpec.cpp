@@ -0,0 +1,31 @@
+///
+/// HybridKeyHandleSpec.cpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#include "HybridKeyHandleSpec.hpp"
+
+namespace margelo::nitro::mmkv {
+
+  void HybridKeyHandleSpec::loadHybridMethods() {
+    // load base methods/properties
+    HybridObject::loadHybridMethods();
+    // load custom methods/properties
+    registerHybrids(this, [](Prototype& prototype) {
+      prototype.registerHybridGetter("key", &HybridKeyHandleSpec::getKey);
+      prototype.registerHybridMethod("set", &HybridKeyHandleSpec::set);
+      prototype.registerHybridMethod("setString", &HybridKeyHandleSpec::setString);
+      prototype.registerHybridMethod("setNumber", &HybridKeyHandleSpec::setNumber);
+      prototype.registerHybridMethod("setBoolean", &HybridKeyHandleSpec::setBoolean);
+      prototype.registerHybridMethod("getBoolean", &HybridKeyHandleSpec::getBoolean);
+      prototype.registerHybridMethod("getString", &HybridKeyHandleSpec::getString);
+      prototype.registerHybridMethod("getNumber", &HybridKeyHandleSpec::getNumber);
+      prototype.registerHybridMethod("getBuffer", &HybridKeyHandleSpec::getBuffer);
+      prototype.registerHybridMethod("contains", &HybridKeyHandleSpec::contains);
+      prototype.registerHybridMethod("remove", &HybridKeyHandleSpec::remove);
+    });
+  }
+
+} // namespace margelo::nitro::mmkv
@@ -0,0 +1,74 @@
+///
+/// HybridKeyHandleSpec.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/HybridObject.hpp>)
+#include <NitroModules/HybridObject.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <variant>
+#include <optional>
+
+namespace margelo::nitro::mmkv {
+
+  using namespace margelo::nitro;
+
+  /**
+   * An abstract base class for `KeyHandle`
+   * Inherit this class to create instances of `HybridKeyHandleSpec` in C++.
+   * You must explicitly call `HybridObject`'s constructor yourself, because it is virtual.
+   * @example
+   * ```cpp
+   * class HybridKeyHandle: public HybridKeyHandleSpec {
+   * public:
+   *   HybridKeyHandle(...): HybridObject(TAG) { ... }
+   *   // ...
+   * };
+   * ```
+   */
+  class HybridKeyHandleSpec: public virtual HybridObject {
+    public:
+      // Constructor
+      explicit HybridKeyHandleSpec(): HybridObject(TAG) { }
+
+      // Destructor
+      ~HybridKeyHandleSpec() override = default;
+
+    public:
+      // Properties
+      virtual std::string getKey() = 0;
+
+    public:
+      // Methods
+      virtual void set(const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) = 0;
+      virtual void setString(const std::string& value) = 0;
+      virtual void setNumber(double value) = 0;
+      virtual void setBoolean(bool value) = 0;
+      virtual std::optional<bool> getBoolean() = 0;
+      virtual std::optional<std::string> getString() = 0;
+      virtual std::optional<double> getNumber() = 0;
+      virtual std::optional<std::shared_ptr<ArrayBuffer>> getBuffer() = 0;
+      virtual bool contains() = 0;
+      virtual bool remove() = 0;
+
+    protected:
+      // Hybrid Setup
+      void loadHybridMethods() override;
+
+    protected:
+      // Tag for logging
+      static constexpr auto TAG = "KeyHandle";
+  };
+
+} // namespace margelo::nitro::mmkv
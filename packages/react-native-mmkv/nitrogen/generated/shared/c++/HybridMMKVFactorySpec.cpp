@@ -19,6 +19,11 @@ namespace margelo::nitro::mmkv {
       prototype.registerHybridMethod("createMMKV", &HybridMMKVFactorySpec::createMMKV);
       prototype.registerHybridMethod("deleteMMKV", &HybridMMKVFactorySpec::deleteMMKV);
       prototype.registerHybridMethod("existsMMKV", &HybridMMKVFactorySpec::existsMMKV);
+      prototype.registerHybridMethod("preloadMMKV", &HybridMMKVFactorySpec::preloadMMKV);
+      prototype.registerHybridMethod("getInstanceCacheStats", &HybridMMKVFactorySpec::getInstanceCacheStats);
+      prototype.registerHybridMethod("getStats", &HybridMMKVFactorySpec::getStats);
+      prototype.registerHybridMethod("startTracing", &HybridMMKVFactorySpec::startTracing);
+      prototype.registerHybridMethod("stopTracing", &HybridMMKVFactorySpec::stopTracing);
     });
   }
 
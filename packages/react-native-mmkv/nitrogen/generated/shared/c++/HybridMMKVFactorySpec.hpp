@@ -17,11 +17,20 @@
 namespace margelo::nitro::mmkv { class HybridMMKVSpec; }
 // Forward declaration of `Configuration` to properly resolve imports.
 namespace margelo::nitro::mmkv { struct Configuration; }
+// Forward declaration of `InstanceCacheStats` to properly resolve imports.
+namespace margelo::nitro::mmkv { struct InstanceCacheStats; }
+// Forward declaration of `InstanceStats` to properly resolve imports.
+namespace margelo::nitro::mmkv { struct InstanceStats; }
 
 #include <string>
 #include <memory>
 #include "HybridMMKVSpec.hpp"
 #include "Configuration.hpp"
+#include <NitroModules/Promise.hpp>
+#include <vector>
+#include "InstanceCacheStats.hpp"
+#include "InstanceStats.hpp"
+#include <optional>
 
 namespace margelo::nitro::mmkv {
 
@@ -56,8 +65,13 @@ namespace margelo::nitro::mmkv {
       // Methods
       virtual void initializeMMKV(const std::string& rootPath) = 0;
       virtual std::shared_ptr<HybridMMKVSpec> createMMKV(const Configuration& configuration) = 0;
-      virtual bool deleteMMKV(const std::string& id) = 0;
+      virtual bool deleteMMKV(const std::string& id, const std::optional<std::string>& path) = 0;
       virtual bool existsMMKV(const std::string& id) = 0;
+      virtual std::shared_ptr<Promise<void>> preloadMMKV(const std::vector<Configuration>& configurations) = 0;
+      virtual InstanceCacheStats getInstanceCacheStats() = 0;
+      virtual InstanceStats getStats() = 0;
+      virtual std::string startTracing(const std::optional<std::string>& filePath) = 0;
+      virtual void stopTracing() = 0;
 
     protected:
       // Hybrid Setup
@@ -21,10 +21,14 @@ namespace margelo::nitro::mmkv {
       prototype.registerHybridGetter("isReadOnly", &HybridMMKVSpec::getIsReadOnly);
       prototype.registerHybridGetter("isEncrypted", &HybridMMKVSpec::getIsEncrypted);
       prototype.registerHybridMethod("set", &HybridMMKVSpec::set);
+      prototype.registerHybridMethod("setString", &HybridMMKVSpec::setString);
+      prototype.registerHybridMethod("setNumber", &HybridMMKVSpec::setNumber);
+      prototype.registerHybridMethod("setBoolean", &HybridMMKVSpec::setBoolean);
       prototype.registerHybridMethod("getBoolean", &HybridMMKVSpec::getBoolean);
       prototype.registerHybridMethod("getString", &HybridMMKVSpec::getString);
       prototype.registerHybridMethod("getNumber", &HybridMMKVSpec::getNumber);
       prototype.registerHybridMethod("getBuffer", &HybridMMKVSpec::getBuffer);
+      prototype.registerHybridMethod("getBufferInto", &HybridMMKVSpec::getBufferInto);
       prototype.registerHybridMethod("contains", &HybridMMKVSpec::contains);
       prototype.registerHybridMethod("remove", &HybridMMKVSpec::remove);
       prototype.registerHybridMethod("getAllKeys", &HybridMMKVSpec::getAllKeys);
@@ -34,7 +38,28 @@ namespace margelo::nitro::mmkv {
       prototype.registerHybridMethod("decrypt", &HybridMMKVSpec::decrypt);
       prototype.registerHybridMethod("trim", &HybridMMKVSpec::trim);
       prototype.registerHybridMethod("addOnValueChangedListener", &HybridMMKVSpec::addOnValueChangedListener);
+      prototype.registerHybridMethod("addOnKeyChangedListener", &HybridMMKVSpec::addOnKeyChangedListener);
+      prototype.registerHybridMethod("addOnKeyPrefixChangedListener", &HybridMMKVSpec::addOnKeyPrefixChangedListener);
+      prototype.registerHybridMethod("addOnValuesChangedListener", &HybridMMKVSpec::addOnValuesChangedListener);
       prototype.registerHybridMethod("importAllFrom", &HybridMMKVSpec::importAllFrom);
+      prototype.registerHybridMethod("getMany", &HybridMMKVSpec::getMany);
+      prototype.registerHybridMethod("writeBatch", &HybridMMKVSpec::writeBatch);
+      prototype.registerHybridMethod("setAsync", &HybridMMKVSpec::setAsync);
+      prototype.registerHybridMethod("getStringAsync", &HybridMMKVSpec::getStringAsync);
+      prototype.registerHybridMethod("getBufferAsync", &HybridMMKVSpec::getBufferAsync);
+      prototype.registerHybridMethod("importAllFromAsync", &HybridMMKVSpec::importAllFromAsync);
+      prototype.registerHybridMethod("trimAsync", &HybridMMKVSpec::trimAsync);
+      prototype.registerHybridMethod("flush", &HybridMMKVSpec::flush);
+      prototype.registerHybridMethod("key", &HybridMMKVSpec::key);
+      prototype.registerHybridMethod("setInt", &HybridMMKVSpec::setInt);
+      prototype.registerHybridMethod("getInt", &HybridMMKVSpec::getInt);
+      prototype.registerHybridMethod("setInt64", &HybridMMKVSpec::setInt64);
+      prototype.registerHybridMethod("getInt64", &HybridMMKVSpec::getInt64);
+      prototype.registerHybridMethod("increment", &HybridMMKVSpec::increment);
+      prototype.registerHybridMethod("compareAndSet", &HybridMMKVSpec::compareAndSet);
+      prototype.registerHybridMethod("removeExpiredKeys", &HybridMMKVSpec::removeExpiredKeys);
+      prototype.registerHybridMethod("getCompactionStats", &HybridMMKVSpec::getCompactionStats);
+      prototype.registerHybridMethod("getStats", &HybridMMKVSpec::getStats);
     });
   }
 
@@ -13,16 +13,32 @@
 #error NitroModules cannot be found! Are you sure you installed NitroModules properly?
 #endif
 
+// Forward declaration of `SetOptions` to properly resolve imports.
+namespace margelo::nitro::mmkv { struct SetOptions; }
 // Forward declaration of `EncryptionType` to properly resolve imports.
 namespace margelo::nitro::mmkv { enum class EncryptionType; }
 // Forward declaration of `Listener` to properly resolve imports.
 namespace margelo::nitro::mmkv { struct Listener; }
 // Forward declaration of `HybridMMKVSpec` to properly resolve imports.
 namespace margelo::nitro::mmkv { class HybridMMKVSpec; }
+// Forward declaration of `ValueType` to properly resolve imports.
+namespace margelo::nitro::mmkv { enum class ValueType; }
+// Forward declaration of `WriteBatchEntry` to properly resolve imports.
+namespace margelo::nitro::mmkv { struct WriteBatchEntry; }
+// Forward declaration of `Durability` to properly resolve imports.
+namespace margelo::nitro::mmkv { enum class Durability; }
+// Forward declaration of `CompactionStats` to properly resolve imports.
+namespace margelo::nitro::mmkv { struct CompactionStats; }
+// Forward declaration of `InstanceStats` to properly resolve imports.
+namespace margelo::nitro::mmkv { struct InstanceStats; }
+// Forward declaration of `HybridKeyHandleSpec` to properly resolve imports.
+namespace margelo::nitro::mmkv { class HybridKeyHandleSpec; }
 
 #include <string>
 #include <NitroModules/ArrayBuffer.hpp>
+#include <NitroModules/Promise.hpp>
 #include <variant>
+#include "SetOptions.hpp"
 #include <optional>
 #include <vector>
 #include "EncryptionType.hpp"
@@ -30,6 +46,12 @@ namespace margelo::nitro::mmkv { class HybridMMKVSpec; }
 #include <functional>
 #include <memory>
 #include "HybridMMKVSpec.hpp"
+#include "ValueType.hpp"
+#include "WriteBatchEntry.hpp"
+#include "Durability.hpp"
+#include "HybridKeyHandleSpec.hpp"
+#include "CompactionStats.hpp"
+#include "InstanceStats.hpp"
 
 namespace margelo::nitro::mmkv {
 
@@ -67,11 +89,15 @@ namespace margelo::nitro::mmkv {
 
     public:
       // Methods
-      virtual void set(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) = 0;
+      virtual void set(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value, const std::optional<SetOptions>& options) = 0;
+      virtual void setString(const std::string& key, const std::string& value) = 0;
+      virtual void setNumber(const std::string& key, double value) = 0;
+      virtual void setBoolean(const std::string& key, bool value) = 0;
       virtual std::optional<bool> getBoolean(const std::string& key) = 0;
       virtual std::optional<std::string> getString(const std::string& key) = 0;
       virtual std::optional<double> getNumber(const std::string& key) = 0;
       virtual std::optional<std::shared_ptr<ArrayBuffer>> getBuffer(const std::string& key) = 0;
+      virtual std::optional<double> getBufferInto(const std::string& key, const std::shared_ptr<ArrayBuffer>& buffer) = 0;
       virtual bool contains(const std::string& key) = 0;
       virtual bool remove(const std::string& key) = 0;
       virtual std::vector<std::string> getAllKeys() = 0;
@@ -81,7 +107,28 @@ namespace margelo::nitro::mmkv {
       virtual void decrypt() = 0;
       virtual void trim() = 0;
       virtual Listener addOnValueChangedListener(const std::function<void(const std::string& /* key */)>& onValueChanged) = 0;
+      virtual Listener addOnKeyChangedListener(const std::string& key, const std::function<void(const std::string& /* key */)>& onValueChanged) = 0;
+      virtual Listener addOnKeyPrefixChangedListener(const std::string& prefix, const std::function<void(const std::string& /* key */)>& onValueChanged) = 0;
+      virtual Listener addOnValuesChangedListener(const std::function<void(const std::vector<std::string>& /* keys */)>& onValuesChanged, std::optional<double> flushIntervalMs) = 0;
       virtual double importAllFrom(const std::shared_ptr<HybridMMKVSpec>& other) = 0;
+      virtual std::vector<std::optional<std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>>> getMany(const std::vector<std::string>& keys, const std::optional<std::vector<ValueType>>& types) = 0;
+      virtual void writeBatch(const std::vector<WriteBatchEntry>& entries, const std::optional<std::vector<std::string>>& removals) = 0;
+      virtual std::shared_ptr<Promise<void>> setAsync(const std::string& key, const std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>& value) = 0;
+      virtual std::shared_ptr<Promise<std::optional<std::string>>> getStringAsync(const std::string& key) = 0;
+      virtual std::shared_ptr<Promise<std::optional<std::shared_ptr<ArrayBuffer>>>> getBufferAsync(const std::string& key) = 0;
+      virtual std::shared_ptr<Promise<double>> importAllFromAsync(const std::shared_ptr<HybridMMKVSpec>& other) = 0;
+      virtual std::shared_ptr<Promise<void>> trimAsync() = 0;
+      virtual void flush(std::optional<Durability> durability) = 0;
+      virtual std::shared_ptr<HybridKeyHandleSpec> key(const std::string& key) = 0;
+      virtual void setInt(const std::string& key, double value) = 0;
+      virtual std::optional<double> getInt(const std::string& key) = 0;
+      virtual void setInt64(const std::string& key, int64_t value) = 0;
+      virtual std::optional<int64_t> getInt64(const std::string& key) = 0;
+      virtual double increment(const std::string& key, std::optional<double> delta) = 0;
+      virtual bool compareAndSet(const std::string& key, double expected, double next) = 0;
+      virtual std::shared_ptr<Promise<double>> removeExpiredKeys() = 0;
+      virtual CompactionStats getCompactionStats() = 0;
+      virtual InstanceStats getStats() = 0;
 
     protected:
       // Hybrid Setup
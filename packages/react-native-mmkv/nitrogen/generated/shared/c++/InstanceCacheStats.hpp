@@ -0,0 +1,91 @@
+///
+/// InstanceCacheStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * A struct which can be represented as a JavaScript object (InstanceCacheStats).
+   */
+  struct InstanceCacheStats final {
+  public:
+    double hits     SWIFT_PRIVATE;
+    double misses     SWIFT_PRIVATE;
+    double size     SWIFT_PRIVATE;
+
+  public:
+    InstanceCacheStats() = default;
+    explicit InstanceCacheStats(double hits, double misses, double size): hits(hits), misses(misses), size(size) {}
+
+  public:
+    friend bool operator==(const InstanceCacheStats& lhs, const InstanceCacheStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ InstanceCacheStats <> JS InstanceCacheStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::InstanceCacheStats> final {
+    static inline margelo::nitro::mmkv::InstanceCacheStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::mmkv::InstanceCacheStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "hits"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "misses"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "size")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::mmkv::InstanceCacheStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "hits"), JSIConverter<double>::toJSI(runtime, arg.hits));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "misses"), JSIConverter<double>::toJSI(runtime, arg.misses));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "size"), JSIConverter<double>::toJSI(runtime, arg.size));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "hits")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "misses")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "size")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,124 @@
+///
+/// InstanceStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+// Forward declaration of `OperationStats` to properly resolve imports.
+namespace margelo::nitro::mmkv { struct OperationStats; }
+
+#include "OperationStats.hpp"
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * A struct which can be represented as a JavaScript object (InstanceStats).
+   */
+  struct InstanceStats final {
+  public:
+    bool isEnabled     SWIFT_PRIVATE;
+    OperationStats get     SWIFT_PRIVATE;
+    OperationStats set     SWIFT_PRIVATE;
+    OperationStats remove     SWIFT_PRIVATE;
+    OperationStats notify     SWIFT_PRIVATE;
+    double bytesWritten     SWIFT_PRIVATE;
+    double fileGrowths     SWIFT_PRIVATE;
+    double fullWriteBacks     SWIFT_PRIVATE;
+    double listenerCount     SWIFT_PRIVATE;
+    double liveBytes     SWIFT_PRIVATE;
+    double fileBytes     SWIFT_PRIVATE;
+
+  public:
+    InstanceStats() = default;
+    explicit InstanceStats(bool isEnabled, OperationStats get, OperationStats set, OperationStats remove, OperationStats notify, double bytesWritten, double fileGrowths, double fullWriteBacks, double listenerCount, double liveBytes, double fileBytes): isEnabled(isEnabled), get(get), set(set), remove(remove), notify(notify), bytesWritten(bytesWritten), fileGrowths(fileGrowths), fullWriteBacks(fullWriteBacks), listenerCount(listenerCount), liveBytes(liveBytes), fileBytes(fileBytes) {}
+
+  public:
+    friend bool operator==(const InstanceStats& lhs, const InstanceStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ InstanceStats <> JS InstanceStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::InstanceStats> final {
+    static inline margelo::nitro::mmkv::InstanceStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::mmkv::InstanceStats(
+        JSIConverter<bool>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "isEnabled"))),
+        JSIConverter<margelo::nitro::mmkv::OperationStats>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "get"))),
+        JSIConverter<margelo::nitro::mmkv::OperationStats>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "set"))),
+        JSIConverter<margelo::nitro::mmkv::OperationStats>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "remove"))),
+        JSIConverter<margelo::nitro::mmkv::OperationStats>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "notify"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesWritten"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fileGrowths"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fullWriteBacks"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "listenerCount"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "liveBytes"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fileBytes")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::mmkv::InstanceStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "isEnabled"), JSIConverter<bool>::toJSI(runtime, arg.isEnabled));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "get"), JSIConverter<margelo::nitro::mmkv::OperationStats>::toJSI(runtime, arg.get));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "set"), JSIConverter<margelo::nitro::mmkv::OperationStats>::toJSI(runtime, arg.set));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "remove"), JSIConverter<margelo::nitro::mmkv::OperationStats>::toJSI(runtime, arg.remove));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "notify"), JSIConverter<margelo::nitro::mmkv::OperationStats>::toJSI(runtime, arg.notify));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "bytesWritten"), JSIConverter<double>::toJSI(runtime, arg.bytesWritten));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "fileGrowths"), JSIConverter<double>::toJSI(runtime, arg.fileGrowths));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "fullWriteBacks"), JSIConverter<double>::toJSI(runtime, arg.fullWriteBacks));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "listenerCount"), JSIConverter<double>::toJSI(runtime, arg.listenerCount));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "liveBytes"), JSIConverter<double>::toJSI(runtime, arg.liveBytes));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "fileBytes"), JSIConverter<double>::toJSI(runtime, arg.fileBytes));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<bool>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "isEnabled")))) return false;
+      if (!JSIConverter<margelo::nitro::mmkv::OperationStats>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "get")))) return false;
+      if (!JSIConverter<margelo::nitro::mmkv::OperationStats>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "set")))) return false;
+      if (!JSIConverter<margelo::nitro::mmkv::OperationStats>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "remove")))) return false;
+      if (!JSIConverter<margelo::nitro::mmkv::OperationStats>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "notify")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "bytesWritten")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fileGrowths")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fullWriteBacks")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "listenerCount")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "liveBytes")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "fileBytes")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,98 @@
+///
+/// OperationStats.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+#include <vector>
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * A struct which can be represented as a JavaScript object (OperationStats).
+   */
+  struct OperationStats final {
+  public:
+    double count     SWIFT_PRIVATE;
+    double meanMicroseconds     SWIFT_PRIVATE;
+    double p50Microseconds     SWIFT_PRIVATE;
+    double p99Microseconds     SWIFT_PRIVATE;
+    std::vector<double> histogram     SWIFT_PRIVATE;
+
+  public:
+    OperationStats() = default;
+    explicit OperationStats(double count, double meanMicroseconds, double p50Microseconds, double p99Microseconds, std::vector<double> histogram): count(count), meanMicroseconds(meanMicroseconds), p50Microseconds(p50Microseconds), p99Microseconds(p99Microseconds), histogram(histogram) {}
+
+  public:
+    friend bool operator==(const OperationStats& lhs, const OperationStats& rhs) = default;
+  };
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ OperationStats <> JS OperationStats (object)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::OperationStats> final {
+    static inline margelo::nitro::mmkv::OperationStats fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::mmkv::OperationStats(
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "count"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "meanMicroseconds"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "p50Microseconds"))),
+        JSIConverter<double>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "p99Microseconds"))),
+        JSIConverter<std::vector<double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "histogram")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::mmkv::OperationStats& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "count"), JSIConverter<double>::toJSI(runtime, arg.count));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "meanMicroseconds"), JSIConverter<double>::toJSI(runtime, arg.meanMicroseconds));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "p50Microseconds"), JSIConverter<double>::toJSI(runtime, arg.p50Microseconds));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "p99Microseconds"), JSIConverter<double>::toJSI(runtime, arg.p99Microseconds));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "histogram"), JSIConverter<std::vector<double>>::toJSI(runtime, arg.histogram));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "count")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "meanMicroseconds")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "p50Microseconds")))) return false;
+      if (!JSIConverter<double>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "p99Microseconds")))) return false;
+      if (!JSIConverter<std::vector<double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "histogram")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
@@ -0,0 +1,84 @@
+///
+/// SyncPolicy.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * An enum which can be represented as a JavaScript union (SyncPolicy).
+   */
+  enum class SyncPolicy {
+    OS      SWIFT_NAME(os) = 0,
+    PERIODIC      SWIFT_NAME(periodic) = 1,
+    EVERY_WRITE      SWIFT_NAME(everyWrite) = 2,
+    EVERY_BATCH      SWIFT_NAME(everyBatch) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ SyncPolicy <> JS SyncPolicy (union)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::SyncPolicy> final {
+    static inline margelo::nitro::mmkv::SyncPolicy fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("os"): return margelo::nitro::mmkv::SyncPolicy::OS;
+        case hashString("periodic"): return margelo::nitro::mmkv::SyncPolicy::PERIODIC;
+        case hashString("every-write"): return margelo::nitro::mmkv::SyncPolicy::EVERY_WRITE;
+        case hashString("every-batch"): return margelo::nitro::mmkv::SyncPolicy::EVERY_BATCH;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum SyncPolicy - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::mmkv::SyncPolicy arg) {
+      switch (arg) {
+        case margelo::nitro::mmkv::SyncPolicy::OS: return JSIConverter<std::string>::toJSI(runtime, "os");
+        case margelo::nitro::mmkv::SyncPolicy::PERIODIC: return JSIConverter<std::string>::toJSI(runtime, "periodic");
+        case margelo::nitro::mmkv::SyncPolicy::EVERY_WRITE: return JSIConverter<std::string>::toJSI(runtime, "every-write");
+        case margelo::nitro::mmkv::SyncPolicy::EVERY_BATCH: return JSIConverter<std::string>::toJSI(runtime, "every-batch");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert SyncPolicy to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("os"):
+        case hashString("periodic"):
+        case hashString("every-write"):
+        case hashString("every-batch"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
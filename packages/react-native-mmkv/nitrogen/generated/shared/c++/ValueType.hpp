@@ -0,0 +1,84 @@
+///
+/// ValueType.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/NitroHash.hpp>)
+#include <NitroModules/NitroHash.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * An enum which can be represented as a JavaScript union (ValueType).
+   */
+  enum class ValueType {
+    STRING      SWIFT_NAME(string) = 0,
+    NUMBER      SWIFT_NAME(number) = 1,
+    BOOLEAN      SWIFT_NAME(boolean) = 2,
+    BUFFER      SWIFT_NAME(buffer) = 3,
+  } CLOSED_ENUM;
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ ValueType <> JS ValueType (union)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::ValueType> final {
+    static inline margelo::nitro::mmkv::ValueType fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, arg);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("string"): return margelo::nitro::mmkv::ValueType::STRING;
+        case hashString("number"): return margelo::nitro::mmkv::ValueType::NUMBER;
+        case hashString("boolean"): return margelo::nitro::mmkv::ValueType::BOOLEAN;
+        case hashString("buffer"): return margelo::nitro::mmkv::ValueType::BUFFER;
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert \"" + unionValue + "\" to enum ValueType - invalid value!");
+      }
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, margelo::nitro::mmkv::ValueType arg) {
+      switch (arg) {
+        case margelo::nitro::mmkv::ValueType::STRING: return JSIConverter<std::string>::toJSI(runtime, "string");
+        case margelo::nitro::mmkv::ValueType::NUMBER: return JSIConverter<std::string>::toJSI(runtime, "number");
+        case margelo::nitro::mmkv::ValueType::BOOLEAN: return JSIConverter<std::string>::toJSI(runtime, "boolean");
+        case margelo::nitro::mmkv::ValueType::BUFFER: return JSIConverter<std::string>::toJSI(runtime, "buffer");
+        default: [[unlikely]]
+          throw std::invalid_argument("Cannot convert ValueType to JS - invalid value: "
+                                    + std::to_string(static_cast<int>(arg)) + "!");
+      }
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isString()) {
+        return false;
+      }
+      std::string unionValue = JSIConverter<std::string>::fromJSI(runtime, value);
+      switch (hashString(unionValue.c_str(), unionValue.size())) {
+        case hashString("string"):
+        case hashString("number"):
+        case hashString("boolean"):
+        case hashString("buffer"):
+          return true;
+        default:
+          return false;
+      }
+    }
+  };
+
+} // namespace margelo::nitro
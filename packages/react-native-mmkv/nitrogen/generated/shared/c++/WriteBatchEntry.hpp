@@ -0,0 +1,89 @@
+///
+/// WriteBatchEntry.hpp
+/// This file was generated by nitrogen. DO NOT MODIFY THIS FILE.
+/// https://github.com/mrousavy/nitro
+/// Copyright © Marc Rousavy @ Margelo
+///
+
+#pragma once
+
+#if __has_include(<NitroModules/JSIConverter.hpp>)
+#include <NitroModules/JSIConverter.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/NitroDefines.hpp>)
+#include <NitroModules/NitroDefines.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/JSIHelpers.hpp>)
+#include <NitroModules/JSIHelpers.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+#if __has_include(<NitroModules/PropNameIDCache.hpp>)
+#include <NitroModules/PropNameIDCache.hpp>
+#else
+#error NitroModules cannot be found! Are you sure you installed NitroModules properly?
+#endif
+
+
+
+#include <string>
+#include <NitroModules/ArrayBuffer.hpp>
+#include <variant>
+
+namespace margelo::nitro::mmkv {
+
+  /**
+   * A struct which can be represented as a JavaScript object (WriteBatchEntry).
+   */
+  struct WriteBatchEntry final {
+  public:
+    std::string key     SWIFT_PRIVATE;
+    std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double> value     SWIFT_PRIVATE;
+
+  public:
+    WriteBatchEntry() = default;
+    explicit WriteBatchEntry(std::string key, std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double> value): key(key), value(value) {}
+
+  public:
+    friend bool operator==(const WriteBatchEntry& lhs, const WriteBatchEntry& rhs) = default;
+  };
+
+} // namespace margelo::nitro::mmkv
+
+namespace margelo::nitro {
+
+  // C++ WriteBatchEntry <> JS WriteBatchEntry (object)
+  template <>
+  struct JSIConverter<margelo::nitro::mmkv::WriteBatchEntry> final {
+    static inline margelo::nitro::mmkv::WriteBatchEntry fromJSI(jsi::Runtime& runtime, const jsi::Value& arg) {
+      jsi::Object obj = arg.asObject(runtime);
+      return margelo::nitro::mmkv::WriteBatchEntry(
+        JSIConverter<std::string>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "key"))),
+        JSIConverter<std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>>::fromJSI(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "value")))
+      );
+    }
+    static inline jsi::Value toJSI(jsi::Runtime& runtime, const margelo::nitro::mmkv::WriteBatchEntry& arg) {
+      jsi::Object obj(runtime);
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "key"), JSIConverter<std::string>::toJSI(runtime, arg.key));
+      obj.setProperty(runtime, PropNameIDCache::get(runtime, "value"), JSIConverter<std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>>::toJSI(runtime, arg.value));
+      return obj;
+    }
+    static inline bool canConvert(jsi::Runtime& runtime, const jsi::Value& value) {
+      if (!value.isObject()) {
+        return false;
+      }
+      jsi::Object obj = value.getObject(runtime);
+      if (!nitro::isPlainObject(runtime, obj)) {
+        return false;
+      }
+      if (!JSIConverter<std::string>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "key")))) return false;
+      if (!JSIConverter<std::variant<bool, std::shared_ptr<ArrayBuffer>, std::string, double>>::canConvert(runtime, obj.getProperty(runtime, PropNameIDCache::get(runtime, "value")))) return false;
+      return true;
+    }
+  };
+
+} // namespace margelo::nitro
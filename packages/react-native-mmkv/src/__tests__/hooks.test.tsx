@@ -129,3 +129,22 @@ test('useMMKV hook stays consistent during rapid updates', async () => {
     expect(result.current[0]).toBe(100)
   })
 })
+
+test('hooks update when all values are cleared', () => {
+  mmkv.set('string-key', 'value')
+  const { result } = renderHook(() => useMMKVString('string-key', mmkv))
+  expect(result.current[0]).toBe('value')
+
+  const batches: string[][] = []
+  const listener = mmkv.addOnValuesChangedListener(
+    (keys) => batches.push(keys),
+    0
+  )
+  act(() => {
+    mmkv.clearAll()
+  })
+  listener.remove()
+
+  expect(result.current[0]).toBeUndefined()
+  expect(batches).toEqual([['string-key']])
+})
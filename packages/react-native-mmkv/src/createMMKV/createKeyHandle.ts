@@ -0,0 +1,38 @@
+import type { KeyHandle } from '../specs/KeyHandle.nitro'
+import type { MMKV } from '../specs/MMKV.nitro'
+
+// The instance and key each JS handle points to, so handles can be compared
+const targetsOfHandles = new WeakMap<object, { mmkv: MMKV; key: string }>()
+
+/**
+ * Creates a JS {@linkcode KeyHandle} that forwards all calls to the given
+ * {@linkcode MMKV} instance, for platforms without native handles.
+ */
+export function createKeyHandle(mmkv: MMKV, key: string): KeyHandle {
+  if (key === '') {
+    throw new Error('Cannot create a handle for an empty key!')
+  }
+
+  const handle: KeyHandle = {
+    key,
+    set: (value) => mmkv.set(key, value),
+    setString: (value) => mmkv.setString(key, value),
+    setNumber: (value) => mmkv.setNumber(key, value),
+    setBoolean: (value) => mmkv.setBoolean(key, value),
+    getBoolean: () => mmkv.getBoolean(key),
+    getString: () => mmkv.getString(key),
+    getNumber: () => mmkv.getNumber(key),
+    getBuffer: () => mmkv.getBuffer(key),
+    contains: () => mmkv.contains(key),
+    remove: () => mmkv.remove(key),
+    name: 'KeyHandle',
+    dispose: () => {},
+    // Two handles are equal if they point to the same key of the same instance
+    equals: (other) => {
+      const target = targetsOfHandles.get(other)
+      return target?.mmkv === mmkv && target.key === key
+    },
+  }
+  targetsOfHandles.set(handle, { mmkv, key })
+  return handle
+}
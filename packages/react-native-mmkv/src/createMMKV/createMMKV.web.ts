@@ -1,5 +1,7 @@
 import type { MMKV } from '../specs/MMKV.nitro'
 import type { Configuration } from '../specs/MMKVFactory.nitro'
+import { createKeyHandle } from './createKeyHandle'
+import { createEmptyStats } from '../getMMKVStats/createEmptyStats'
 import { createTextDecoder } from '../web/createTextDecoder'
 import { createTextEncoder } from '../web/createTextEncoder'
 import {
@@ -16,10 +18,21 @@ export function createMMKV(
   if (config.path != null) {
     throw new Error("MMKV: 'path' is not supported on Web!")
   }
+  if (config.defaultTTLSeconds != null) {
+    throw new Error("MMKV: 'defaultTTLSeconds' is not supported on Web!")
+  }
+  if (config.maxBytes != null) {
+    throw new Error("MMKV: 'maxBytes' is not supported on Web!")
+  }
+  if (config.maxEntries != null) {
+    throw new Error("MMKV: 'maxEntries' is not supported on Web!")
+  }
 
   const textDecoder = createTextDecoder()
   const textEncoder = createTextEncoder()
   const listeners = new Set<(key: string) => void>()
+  // Listeners that are called once with all keys that changed together
+  const batchListeners = new Set<(keys: string[]) => void>()
 
   if (config.id.includes(LOCAL_STORAGE_KEY_WILDCARD)) {
     throw new Error('MMKV: `id` cannot contain the backslash character (`\\`)!')
@@ -35,8 +48,13 @@ export function createMMKV(
     return `${keyPrefix}${key}`
   }
 
+  const callListenersForKeys = (keys: string[]) => {
+    if (keys.length === 0) return
+    keys.forEach((key) => listeners.forEach((l) => l(key)))
+    batchListeners.forEach((l) => l(keys))
+  }
   const callListeners = (key: string) => {
-    listeners.forEach((l) => l(key))
+    callListenersForKeys([key])
   }
 
   return {
@@ -71,9 +89,12 @@ export function createMMKV(
       if (wasRemoved) callListeners(key)
       return wasRemoved
     },
-    set: (key, value) => {
+    set: (key, value, options) => {
       const storage = getLocalStorage()
       if (key === '') throw new Error('Cannot set a value for an empty key!')
+      if (options?.ttlSeconds != null) {
+        throw new Error("MMKV: 'ttlSeconds' is not supported on Web!")
+      }
       if (value instanceof ArrayBuffer) {
         storage.setItem(prefixedKey(key), textDecoder.decode(value))
       } else {
@@ -81,6 +102,15 @@ export function createMMKV(
       }
       callListeners(key)
     },
+    setString(key, value) {
+      this.set(key, value)
+    },
+    setNumber(key, value) {
+      this.set(key, value)
+    },
+    setBoolean(key, value) {
+      this.set(key, value)
+    },
     getString: (key) => {
       const storage = getLocalStorage()
       return storage.getItem(prefixedKey(key)) ?? undefined
@@ -103,6 +133,14 @@ export function createMMKV(
       if (value == null) return undefined
       return textEncoder.encode(value).buffer
     },
+    getBufferInto(key, buffer) {
+      const value = this.getBuffer(key)
+      if (value == null) return undefined
+      if (value.byteLength <= buffer.byteLength) {
+        new Uint8Array(buffer).set(new Uint8Array(value))
+      }
+      return value.byteLength
+    },
     getAllKeys: () => {
       const storage = getLocalStorage()
       const keys = Object.keys(storage)
@@ -137,6 +175,141 @@ export function createMMKV(
         },
       }
     },
+    addOnKeyChangedListener(key, listener) {
+      return this.addOnValueChangedListener((changedKey) => {
+        if (changedKey === key) listener(changedKey)
+      })
+    },
+    addOnKeyPrefixChangedListener(prefix, listener) {
+      return this.addOnValueChangedListener((changedKey) => {
+        if (changedKey.startsWith(prefix)) listener(changedKey)
+      })
+    },
+    setAsync(key, value) {
+      // Buffers are copied right away, just like on native
+      const ownedValue = value instanceof ArrayBuffer ? value.slice(0) : value
+      return Promise.resolve().then(() => this.set(key, ownedValue))
+    },
+    getStringAsync(key) {
+      return Promise.resolve().then(() => this.getString(key))
+    },
+    getBufferAsync(key) {
+      return Promise.resolve().then(() => this.getBuffer(key))
+    },
+    importAllFromAsync(other) {
+      return Promise.resolve().then(() => this.importAllFrom(other))
+    },
+    trimAsync() {
+      return Promise.resolve().then(() => this.trim())
+    },
+    flush: () => {
+      // no-op
+    },
+    key(key) {
+      return createKeyHandle(this, key)
+    },
+    setInt(key, value) {
+      if (
+        !Number.isInteger(value) ||
+        value < -2147483648 ||
+        value > 2147483647
+      ) {
+        throw new Error(
+          `\`value\` must be a 32-bit integer! (received: ${value})`
+        )
+      }
+      this.set(key, value)
+    },
+    getInt(key) {
+      const value = this.getNumber(key)
+      return value != null && Number.isInteger(value) ? value : undefined
+    },
+    setInt64(key, value) {
+      this.setString(key, value.toString())
+    },
+    getInt64(key) {
+      const value = this.getString(key)
+      if (value == null) return undefined
+      try {
+        return BigInt(value)
+      } catch {
+        return undefined
+      }
+    },
+    increment(key, delta = 1) {
+      if (!Number.isInteger(delta)) {
+        throw new Error(`\`delta\` must be an integer! (received: ${delta})`)
+      }
+      // In BigInt, so values above 2^53 don't lose precision
+      const current = this.getInt64(key) ?? BigInt(0)
+      const next = current + BigInt(delta)
+      if (
+        next > BigInt(Number.MAX_SAFE_INTEGER) ||
+        next < BigInt(Number.MIN_SAFE_INTEGER)
+      ) {
+        throw new Error(
+          `Cannot increment "${key}" (${current}) by ${delta}, the result would not be a safe integer!`
+        )
+      }
+      this.setInt64(key, next)
+      return Number(next)
+    },
+    removeExpiredKeys: () => {
+      // Values never expire on Web
+      return Promise.resolve(0)
+    },
+    getCompactionStats: () => {
+      // There is no file to compact on Web
+      return {
+        count: 0,
+        bytesReclaimed: 0,
+        totalDurationMs: 0,
+        lastDurationMs: 0,
+        maxDurationMs: 0,
+      }
+    },
+    getStats: () => {
+      // Operations are not measured on Web
+      return createEmptyStats()
+    },
+    compareAndSet(key, expected, next) {
+      const current = this.getInt64(key)
+      if (current == null || current !== BigInt(expected)) return false
+      this.setInt64(key, BigInt(next))
+      return true
+    },
+    addOnValuesChangedListener(listener, flushIntervalMs = 16) {
+      if (flushIntervalMs <= 0) {
+        // Deliver right away - once per write, or once per batch
+        batchListeners.add(listener)
+        return {
+          remove: () => {
+            batchListeners.delete(listener)
+          },
+        }
+      }
+      const pendingKeys = new Set<string>()
+      let timeout: ReturnType<typeof setTimeout> | undefined
+      const onValuesChanged = (changedKeys: string[]) => {
+        changedKeys.forEach((changedKey) => pendingKeys.add(changedKey))
+        if (timeout != null) return
+        timeout = setTimeout(() => {
+          timeout = undefined
+          const keys = [...pendingKeys]
+          pendingKeys.clear()
+          listener(keys)
+        }, flushIntervalMs)
+      }
+      batchListeners.add(onValuesChanged)
+      return {
+        remove: () => {
+          batchListeners.delete(onValuesChanged)
+          if (timeout != null) clearTimeout(timeout)
+          timeout = undefined
+          pendingKeys.clear()
+        },
+      }
+    },
     importAllFrom: (other) => {
       const storage = getLocalStorage()
       const keys = other.getAllKeys()
@@ -150,5 +323,44 @@ export function createMMKV(
       }
       return imported
     },
+    writeBatch: (entries, removals) => {
+      if (entries.some((entry) => entry.key === '')) {
+        throw new Error('Cannot set a value for an empty key!')
+      }
+      const storage = getLocalStorage()
+      const changedKeys: string[] = []
+      for (const { key, value } of entries) {
+        if (value instanceof ArrayBuffer) {
+          storage.setItem(prefixedKey(key), textDecoder.decode(value))
+        } else {
+          storage.setItem(prefixedKey(key), String(value))
+        }
+        changedKeys.push(key)
+      }
+      for (const key of removals ?? []) {
+        if (storage.getItem(prefixedKey(key)) != null) {
+          storage.removeItem(prefixedKey(key))
+          changedKeys.push(key)
+        }
+      }
+      callListenersForKeys(changedKeys)
+    },
+    getMany(keys, types) {
+      if (types != null && types.length !== keys.length) {
+        throw new Error('`types` must have the same length as `keys`!')
+      }
+      return keys.map((key, i) => {
+        switch (types?.[i] ?? 'string') {
+          case 'string':
+            return this.getString(key)
+          case 'number':
+            return this.getNumber(key)
+          case 'boolean':
+            return this.getBoolean(key)
+          case 'buffer':
+            return this.getBuffer(key)
+        }
+      })
+    },
   }
 }
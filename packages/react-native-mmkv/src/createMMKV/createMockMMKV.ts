@@ -1,5 +1,7 @@
 import type { MMKV } from '../specs/MMKV.nitro'
 import type { Configuration } from '../specs/MMKVFactory.nitro'
+import { createKeyHandle } from './createKeyHandle'
+import { createEmptyStats } from '../getMMKVStats/createEmptyStats'
 
 /**
  * Mock MMKV instance when used in a Jest/Test environment.
@@ -7,19 +9,73 @@ import type { Configuration } from '../specs/MMKVFactory.nitro'
 export function createMockMMKV(
   config: Configuration = { id: 'mmkv.default' }
 ): MMKV {
-  const storage = new Map<string, string | boolean | number | ArrayBuffer>()
+  const storage = new Map<
+    string,
+    string | boolean | number | bigint | ArrayBuffer
+  >()
   const listeners = new Set<(key: string) => void>()
+  // Listeners that are called once with all keys that changed together
+  const batchListeners = new Set<(keys: string[]) => void>()
+  // The timestamp (in ms) at which each key with a TTL expires
+  const expirations = new Map<string, number>()
 
+  const isExpired = (key: string) => {
+    const expiresAt = expirations.get(key)
+    return expiresAt != null && expiresAt <= Date.now()
+  }
+  // Map iterates in insertion order, so re-inserting a key makes it the most recently used one
+  const touch = (key: string) => {
+    const value = storage.get(key)
+    if (config.maxEntries == null || value === undefined) return
+    storage.delete(key)
+    storage.set(key, value)
+  }
+  const read = (key: string) => {
+    if (isExpired(key)) return undefined
+    touch(key)
+    return storage.get(key)
+  }
+  const write = (
+    key: string,
+    value: string | boolean | number | bigint | ArrayBuffer,
+    ttlSeconds = config.defaultTTLSeconds ?? 0
+  ) => {
+    if (ttlSeconds > 0) {
+      expirations.set(key, Date.now() + ttlSeconds * 1000)
+    } else {
+      expirations.delete(key)
+    }
+    storage.delete(key)
+    storage.set(key, value)
+  }
+
+  const notifyListenersForKeys = (keys: string[]) => {
+    if (keys.length === 0) return
+    keys.forEach((key) => listeners.forEach((listener) => listener(key)))
+    batchListeners.forEach((listener) => listener(keys))
+  }
   const notifyListeners = (key: string) => {
-    listeners.forEach((listener) => {
-      listener(key)
-    })
+    notifyListenersForKeys([key])
+  }
+  // `maxBytes` is not enforced, as the mock cannot know the real file size
+  const evictIfNeeded = () => {
+    if (config.maxEntries == null || storage.size <= config.maxEntries) return
+    const targetEntries = Math.floor(config.maxEntries * 0.9)
+    const evictedKeys = Array.from(storage.keys()).slice(
+      0,
+      storage.size - targetEntries
+    )
+    for (const key of evictedKeys) {
+      storage.delete(key)
+      expirations.delete(key)
+    }
+    notifyListenersForKeys(evictedKeys)
   }
 
   return {
     id: config.id,
     get length(): number {
-      return storage.size
+      return this.getAllKeys().length
     },
     get size(): number {
       return this.byteSize
@@ -31,43 +87,63 @@ export function createMockMMKV(
     isReadOnly: false,
     isEncrypted: false,
     clearAll: () => {
-      const keysBefore = storage.keys()
+      // Copy the keys first, the iterator would be empty after clearing
+      const keysBefore = Array.from(storage.keys())
       storage.clear()
-      // Notify all listeners for all keys that were cleared
-      for (const key of keysBefore) {
-        notifyListeners(key)
-      }
+      expirations.clear()
+      // Notify all listeners for all keys that were cleared, as one batch
+      notifyListenersForKeys(keysBefore)
     },
     remove: (key) => {
       const deleted = storage.delete(key)
+      expirations.delete(key)
       if (deleted) {
         notifyListeners(key)
       }
       return deleted
     },
-    set: (key, value) => {
+    set: (key, value, options) => {
       if (key === '') throw new Error('Cannot set a value for an empty key!')
-      storage.set(key, value)
+      write(key, value, options?.ttlSeconds)
       notifyListeners(key)
+      evictIfNeeded()
+    },
+    setString(key, value) {
+      this.set(key, value)
+    },
+    setNumber(key, value) {
+      this.set(key, value)
+    },
+    setBoolean(key, value) {
+      this.set(key, value)
     },
     getString: (key) => {
-      const result = storage.get(key)
+      const result = read(key)
       return typeof result === 'string' ? result : undefined
     },
     getNumber: (key) => {
-      const result = storage.get(key)
+      const result = read(key)
       return typeof result === 'number' ? result : undefined
     },
     getBoolean: (key) => {
-      const result = storage.get(key)
+      const result = read(key)
       return typeof result === 'boolean' ? result : undefined
     },
     getBuffer: (key) => {
-      const result = storage.get(key)
+      const result = read(key)
       return result instanceof ArrayBuffer ? result : undefined
     },
-    getAllKeys: () => Array.from(storage.keys()),
-    contains: (key) => storage.has(key),
+    getBufferInto(key, buffer) {
+      const value = this.getBuffer(key)
+      if (value == null) return undefined
+      if (value.byteLength <= buffer.byteLength) {
+        new Uint8Array(buffer).set(new Uint8Array(value))
+      }
+      return value.byteLength
+    },
+    getAllKeys: () =>
+      Array.from(storage.keys()).filter((key) => !isExpired(key)),
+    contains: (key) => read(key) != null,
     recrypt: () => {
       console.warn('Encryption is not supported in mocked MMKV instances!')
     },
@@ -93,17 +169,192 @@ export function createMockMMKV(
         },
       }
     },
+    addOnKeyChangedListener(key, listener) {
+      return this.addOnValueChangedListener((changedKey) => {
+        if (changedKey === key) listener(changedKey)
+      })
+    },
+    addOnKeyPrefixChangedListener(prefix, listener) {
+      return this.addOnValueChangedListener((changedKey) => {
+        if (changedKey.startsWith(prefix)) listener(changedKey)
+      })
+    },
+    setAsync(key, value) {
+      // Buffers are copied right away, just like on native
+      const ownedValue = value instanceof ArrayBuffer ? value.slice(0) : value
+      return Promise.resolve().then(() => this.set(key, ownedValue))
+    },
+    getStringAsync(key) {
+      return Promise.resolve().then(() => this.getString(key))
+    },
+    getBufferAsync(key) {
+      return Promise.resolve().then(() => this.getBuffer(key))
+    },
+    importAllFromAsync(other) {
+      return Promise.resolve().then(() => this.importAllFrom(other))
+    },
+    trimAsync() {
+      return Promise.resolve().then(() => this.trim())
+    },
+    flush: () => {
+      // no-op
+    },
+    key(key) {
+      return createKeyHandle(this, key)
+    },
+    setInt(key, value) {
+      if (
+        !Number.isInteger(value) ||
+        value < -2147483648 ||
+        value > 2147483647
+      ) {
+        throw new Error(
+          `\`value\` must be a 32-bit integer! (received: ${value})`
+        )
+      }
+      this.set(key, value)
+    },
+    getInt: (key) => {
+      const result = read(key)
+      return typeof result === 'number' && Number.isInteger(result)
+        ? result
+        : undefined
+    },
+    setInt64: (key, value) => {
+      if (key === '') throw new Error('Cannot set a value for an empty key!')
+      write(key, value)
+      notifyListeners(key)
+      evictIfNeeded()
+    },
+    getInt64: (key) => {
+      const result = read(key)
+      if (typeof result === 'bigint') return result
+      if (typeof result === 'number' && Number.isInteger(result)) {
+        return BigInt(result)
+      }
+      return undefined
+    },
+    increment(key, delta = 1) {
+      if (!Number.isInteger(delta)) {
+        throw new Error(`\`delta\` must be an integer! (received: ${delta})`)
+      }
+      // In BigInt, so values above 2^53 don't lose precision
+      const current = this.getInt64(key) ?? BigInt(0)
+      const next = current + BigInt(delta)
+      if (
+        next > BigInt(Number.MAX_SAFE_INTEGER) ||
+        next < BigInt(Number.MIN_SAFE_INTEGER)
+      ) {
+        throw new Error(
+          `Cannot increment "${key}" (${current}) by ${delta}, the result would not be a safe integer!`
+        )
+      }
+      this.setInt64(key, next)
+      return Number(next)
+    },
+    removeExpiredKeys() {
+      const expiredKeys = Array.from(storage.keys()).filter(isExpired)
+      expiredKeys.forEach((key) => this.remove(key))
+      return Promise.resolve(expiredKeys.length)
+    },
+    getCompactionStats: () => {
+      // There is no file to compact in the mock
+      return {
+        count: 0,
+        bytesReclaimed: 0,
+        totalDurationMs: 0,
+        lastDurationMs: 0,
+        maxDurationMs: 0,
+      }
+    },
+    getStats: () => {
+      // Operations are not measured in the mock
+      return createEmptyStats()
+    },
+    compareAndSet(key, expected, next) {
+      const current = this.getInt64(key)
+      if (current == null || current !== BigInt(expected)) return false
+      this.setInt64(key, BigInt(next))
+      return true
+    },
+    addOnValuesChangedListener(listener, flushIntervalMs = 16) {
+      if (flushIntervalMs <= 0) {
+        // Deliver right away - once per write, or once per batch
+        batchListeners.add(listener)
+        return {
+          remove: () => {
+            batchListeners.delete(listener)
+          },
+        }
+      }
+      const pendingKeys = new Set<string>()
+      let timeout: ReturnType<typeof setTimeout> | undefined
+      const onValuesChanged = (changedKeys: string[]) => {
+        changedKeys.forEach((changedKey) => pendingKeys.add(changedKey))
+        if (timeout != null) return
+        timeout = setTimeout(() => {
+          timeout = undefined
+          const keys = [...pendingKeys]
+          pendingKeys.clear()
+          listener(keys)
+        }, flushIntervalMs)
+      }
+      batchListeners.add(onValuesChanged)
+      return {
+        remove: () => {
+          batchListeners.delete(onValuesChanged)
+          if (timeout != null) clearTimeout(timeout)
+          timeout = undefined
+          pendingKeys.clear()
+        },
+      }
+    },
     importAllFrom: (other) => {
       const keys = other.getAllKeys()
       let imported = 0
       for (const key of keys) {
         const data = other.getBuffer(key)
         if (data != null) {
-          storage.set(key, data)
+          write(key, data)
           imported++
         }
       }
+      evictIfNeeded()
       return imported
     },
+    writeBatch: (entries, removals) => {
+      if (entries.some((entry) => entry.key === '')) {
+        throw new Error('Cannot set a value for an empty key!')
+      }
+      const changedKeys: string[] = []
+      for (const { key, value } of entries) {
+        write(key, value)
+        changedKeys.push(key)
+      }
+      for (const key of removals ?? []) {
+        if (storage.delete(key)) {
+          changedKeys.push(key)
+        }
+      }
+      notifyListenersForKeys(changedKeys)
+      evictIfNeeded()
+    },
+    getMany(keys, types) {
+      if (types != null && types.length !== keys.length) {
+        throw new Error('`types` must have the same length as `keys`!')
+      }
+      return keys.map((key, i) => {
+        switch (types?.[i] ?? 'string') {
+          case 'string':
+            return this.getString(key)
+          case 'number':
+            return this.getNumber(key)
+          case 'boolean':
+            return this.getBoolean(key)
+          case 'buffer':
+            return this.getBuffer(key)
+        }
+      })
+    },
   }
 }
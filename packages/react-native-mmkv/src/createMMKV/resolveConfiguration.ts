@@ -0,0 +1,29 @@
+import type { Configuration } from '../specs/MMKVFactory.nitro'
+import { Platform } from 'react-native'
+import { getMMKVFactory, getPlatformContext } from '../getMMKVFactory'
+
+/**
+ * Fills in platform-specific defaults for the given {@linkcode Configuration},
+ * so the same configuration always resolves to the same native instance.
+ */
+export function resolveConfiguration(
+  configuration?: Configuration
+): Configuration {
+  const factory = getMMKVFactory()
+
+  // Pre-parse the config
+  const config = configuration ?? { id: factory.defaultMMKVInstanceId }
+
+  if (Platform.OS === 'ios') {
+    if (config.path == null) {
+      // If the user set an App Group directory in Info.plist, let's use
+      // the App Group as a MMKV path:
+      const platformContext = getPlatformContext()
+      const appGroupDirectory = platformContext.getAppGroupDirectory()
+      if (appGroupDirectory != null) {
+        config.path = appGroupDirectory
+      }
+    }
+  }
+  return config
+}
@@ -1,11 +1,11 @@
 import { getMMKVFactory } from '../getMMKVFactory'
 import { isTest } from '../isTest'
 
-export function deleteMMKV(id: string): boolean {
+export function deleteMMKV(id: string, path?: string): boolean {
   if (isTest()) {
     return true
   }
 
   const factory = getMMKVFactory()
-  return factory.deleteMMKV(id)
+  return factory.deleteMMKV(id, path)
 }
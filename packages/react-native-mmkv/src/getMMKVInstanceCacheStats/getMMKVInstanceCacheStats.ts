@@ -0,0 +1,19 @@
+import type { InstanceCacheStats } from '../specs/MMKVFactory.nitro'
+import { getMMKVFactory } from '../getMMKVFactory'
+import { isTest } from '../isTest'
+
+/**
+ * Get statistics about the instance cache of `createMMKV(...)`.
+ *
+ * Repeatedly calling `createMMKV(...)` with the same `id`, `path` and
+ * encryption settings returns the same instance as long as it is alive,
+ * which counts as a cache hit.
+ */
+export function getMMKVInstanceCacheStats(): InstanceCacheStats {
+  if (isTest()) {
+    return { hits: 0, misses: 0, size: 0 }
+  }
+
+  const factory = getMMKVFactory()
+  return factory.getInstanceCacheStats()
+}
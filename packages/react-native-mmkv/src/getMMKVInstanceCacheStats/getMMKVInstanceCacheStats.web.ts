@@ -0,0 +1,6 @@
+import type { InstanceCacheStats } from '../specs/MMKVFactory.nitro'
+
+export function getMMKVInstanceCacheStats(): InstanceCacheStats {
+  // On web, instances are thin wrappers around localStorage and are not cached
+  return { hits: 0, misses: 0, size: 0 }
+}
@@ -0,0 +1,31 @@
+import type { InstanceStats, OperationStats } from '../specs/MMKV.nitro'
+
+function createEmptyOperationStats(): OperationStats {
+  return {
+    count: 0,
+    meanMicroseconds: 0,
+    p50Microseconds: 0,
+    p99Microseconds: 0,
+    histogram: [],
+  }
+}
+
+/**
+ * Creates the stats of an instance that does not collect any,
+ * e.g. on Web or in tests.
+ */
+export function createEmptyStats(): InstanceStats {
+  return {
+    isEnabled: false,
+    get: createEmptyOperationStats(),
+    set: createEmptyOperationStats(),
+    remove: createEmptyOperationStats(),
+    notify: createEmptyOperationStats(),
+    bytesWritten: 0,
+    fileGrowths: 0,
+    fullWriteBacks: 0,
+    listenerCount: 0,
+    liveBytes: 0,
+    fileBytes: 0,
+  }
+}
@@ -0,0 +1,17 @@
+import type { InstanceStats } from '../specs/MMKV.nitro'
+import { getMMKVFactory } from '../getMMKVFactory'
+import { isTest } from '../isTest'
+import { createEmptyStats } from './createEmptyStats'
+
+/**
+ * Get the stats of all MMKV instances that are currently alive and open,
+ * summed up. See `MMKV.getStats()` for the stats of a single instance.
+ */
+export function getMMKVStats(): InstanceStats {
+  if (isTest()) {
+    return createEmptyStats()
+  }
+
+  const factory = getMMKVFactory()
+  return factory.getStats()
+}
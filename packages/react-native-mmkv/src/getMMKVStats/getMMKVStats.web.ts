@@ -0,0 +1,7 @@
+import type { InstanceStats } from '../specs/MMKV.nitro'
+import { createEmptyStats } from './createEmptyStats'
+
+export function getMMKVStats(): InstanceStats {
+  // On web, instances are thin wrappers around localStorage and don't collect stats
+  return createEmptyStats()
+}
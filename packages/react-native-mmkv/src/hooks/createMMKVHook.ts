@@ -16,10 +16,8 @@ export function createMMKVHook<
     const value = useSyncExternalStore(
       useCallback(
         (onStoreChange: () => void) => {
-          const listener = mmkv.addOnValueChangedListener((changedKey) => {
-            if (changedKey === key) {
-              onStoreChange()
-            }
+          const listener = mmkv.addOnKeyChangedListener(key, () => {
+            onStoreChange()
           })
           return () => listener.remove()
         },
@@ -35,9 +33,13 @@ export function createMMKVHook<
         const newValue = typeof v === 'function' ? v(getter(mmkv, key)) : v
         switch (typeof newValue) {
           case 'number':
+            mmkv.setNumber(key, newValue)
+            break
           case 'string':
+            mmkv.setString(key, newValue)
+            break
           case 'boolean':
-            mmkv.set(key, newValue)
+            mmkv.setBoolean(key, newValue)
             break
           case 'undefined':
             mmkv.remove(key)
@@ -1,6 +1,22 @@
 // All types
-export type { MMKV } from './specs/MMKV.nitro'
-export type { Configuration, Mode } from './specs/MMKVFactory.nitro'
+export type {
+  CompactionStats,
+  Durability,
+  InstanceStats,
+  MMKV,
+  OperationStats,
+  SetOptions,
+  ValueType,
+  WriteBatchEntry,
+} from './specs/MMKV.nitro'
+export type { KeyHandle } from './specs/KeyHandle.nitro'
+export type {
+  Compression,
+  Configuration,
+  InstanceCacheStats,
+  Mode,
+  SyncPolicy,
+} from './specs/MMKVFactory.nitro'
 
 // The create function
 export { createMMKV } from './createMMKV/createMMKV'
@@ -9,6 +25,19 @@ export { createMMKV } from './createMMKV/createMMKV'
 export { existsMMKV } from './existsMMKV/existsMMKV'
 export { deleteMMKV } from './deleteMMKV/deleteMMKV'
 
+// Preloading
+export { preloadMMKV } from './preloadMMKV/preloadMMKV'
+
+// Instance cache
+export { getMMKVInstanceCacheStats } from './getMMKVInstanceCacheStats/getMMKVInstanceCacheStats'
+
+// Stats
+export { getMMKVStats } from './getMMKVStats/getMMKVStats'
+
+// Tracing
+export { startMMKVTracing } from './startMMKVTracing/startMMKVTracing'
+export { stopMMKVTracing } from './stopMMKVTracing/stopMMKVTracing'
+
 // All the hooks
 export { useMMKV } from './hooks/useMMKV'
 export { useMMKVBoolean } from './hooks/useMMKVBoolean'
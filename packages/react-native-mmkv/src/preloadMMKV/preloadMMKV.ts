@@ -0,0 +1,26 @@
+import type { Configuration } from '../specs/MMKVFactory.nitro'
+import { getMMKVFactory } from '../getMMKVFactory'
+import { isTest } from '../isTest'
+import { resolveConfiguration } from '../createMMKV/resolveConfiguration'
+
+/**
+ * Opens all MMKV instances with the given {@linkcode configurations}
+ * concurrently on native background threads.
+ *
+ * Once the returned Promise resolves, `createMMKV(...)` calls with the same
+ * configurations return instantly, as the instances are already open.
+ *
+ * @example
+ * ```ts
+ * // At startup, before the first screen renders
+ * preloadMMKV([{ id: 'user' }, { id: 'settings' }, { id: 'cache' }])
+ * ```
+ */
+export function preloadMMKV(configurations: Configuration[]): Promise<void> {
+  if (isTest()) {
+    return Promise.resolve()
+  }
+
+  const factory = getMMKVFactory()
+  return factory.preloadMMKV(configurations.map(resolveConfiguration))
+}
@@ -0,0 +1,6 @@
+import type { Configuration } from '../specs/MMKVFactory.nitro'
+
+export function preloadMMKV(_configurations: Configuration[]): Promise<void> {
+  // localStorage does not need to be opened
+  return Promise.resolve()
+}
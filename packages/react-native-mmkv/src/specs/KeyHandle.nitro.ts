@@ -0,0 +1,70 @@
+import type { HybridObject } from 'react-native-nitro-modules'
+
+/**
+ * A handle to a single key in an `MMKV` instance,
+ * created via `MMKV.key(...)`.
+ *
+ * The key is converted to a native string once when the handle is created,
+ * instead of on every call - which makes handles faster for keys that are
+ * read or written very often (e.g. on every frame).
+ */
+export interface KeyHandle extends HybridObject<{
+  ios: 'c++'
+  android: 'c++'
+}> {
+  /**
+   * The key this handle refers to.
+   */
+  readonly key: string
+
+  /**
+   * Set a value for this key.
+   * @see `MMKV.set(...)`
+   */
+  set(value: boolean | string | number | ArrayBuffer): void
+  /**
+   * Set a string value for this key.
+   * @see `MMKV.setString(...)`
+   */
+  setString(value: string): void
+  /**
+   * Set a number value for this key.
+   * @see `MMKV.setNumber(...)`
+   */
+  setNumber(value: number): void
+  /**
+   * Set a boolean value for this key.
+   * @see `MMKV.setBoolean(...)`
+   */
+  setBoolean(value: boolean): void
+  /**
+   * Get the boolean value of this key.
+   * @see `MMKV.getBoolean(...)`
+   */
+  getBoolean(): boolean | undefined
+  /**
+   * Get the string value of this key.
+   * @see `MMKV.getString(...)`
+   */
+  getString(): string | undefined
+  /**
+   * Get the number value of this key.
+   * @see `MMKV.getNumber(...)`
+   */
+  getNumber(): number | undefined
+  /**
+   * Get the buffer value of this key.
+   * @see `MMKV.getBuffer(...)`
+   */
+  getBuffer(): ArrayBuffer | undefined
+  /**
+   * Checks whether this key has a value.
+   * @see `MMKV.contains(...)`
+   */
+  contains(): boolean
+  /**
+   * Removes the value of this key.
+   * @see `MMKV.remove(...)`
+   */
+  remove(): boolean
+}
@@ -1,10 +1,178 @@
 import type { HybridObject } from 'react-native-nitro-modules'
 import type { EncryptionType } from './MMKVFactory.nitro'
+import type { KeyHandle } from './KeyHandle.nitro'
 
 export interface Listener {
   remove: () => void
 }
 
+/**
+ * The type a value should be read as in batched reads.
+ * - `string`: Read as a string (see {@linkcode MMKV.getString | getString(...)})
+ * - `number`: Read as a number (see {@linkcode MMKV.getNumber | getNumber(...)})
+ * - `boolean`: Read as a boolean (see {@linkcode MMKV.getBoolean | getBoolean(...)})
+ * - `buffer`: Read as an ArrayBuffer (see {@linkcode MMKV.getBuffer | getBuffer(...)})
+ */
+export type ValueType = 'string' | 'number' | 'boolean' | 'buffer'
+
+/**
+ * How long {@linkcode MMKV.flush | flush(...)} waits for data to reach the disk.
+ * - `async`: Schedules writing all dirty pages to disk and returns immediately.
+ * - `sync`: Blocks until all dirty pages have been written to disk.
+ */
+export type Durability = 'async' | 'sync'
+
+/**
+ * Options for {@linkcode MMKV.set | set(...)}.
+ */
+export interface SetOptions {
+  /**
+   * The time-to-live of this value in seconds, after which it expires and
+   * is treated as if it did not exist.
+   * Pass `0` to never expire it, even if the instance has a `defaultTTLSeconds`.
+   * @default The instance's `defaultTTLSeconds`, or never.
+   */
+  ttlSeconds?: number
+}
+
+/**
+ * Statistics about the compactions of an MMKV instance's file,
+ * see {@linkcode MMKV.getCompactionStats | getCompactionStats()}.
+ */
+export interface CompactionStats {
+  /**
+   * The number of times the file was compacted, automatically
+   * or by {@linkcode MMKV.trim | trim()}.
+   */
+  count: number
+  /**
+   * The total number of bytes the file shrunk by.
+   */
+  bytesReclaimed: number
+  /**
+   * The total time spent compacting, in milliseconds.
+   */
+  totalDurationMs: number
+  /**
+   * The duration of the last compaction, in milliseconds.
+   */
+  lastDurationMs: number
+  /**
+   * The duration of the longest compaction, in milliseconds.
+   * Reads and writes of this instance wait while it is being compacted.
+   */
+  maxDurationMs: number
+}
+
+/**
+ * Latency statistics of one kind of operation, see {@linkcode InstanceStats}.
+ */
+export interface OperationStats {
+  /**
+   * The number of operations.
+   */
+  count: number
+  /**
+   * The mean duration of an operation, in microseconds.
+   */
+  meanMicroseconds: number
+  /**
+   * The median duration of an operation, in microseconds.
+   * This is the upper bound of its {@linkcode histogram} bucket, so it is
+   * accurate to within a factor of 2.
+   */
+  p50Microseconds: number
+  /**
+   * The 99th percentile duration of an operation, in microseconds.
+   * Like {@linkcode p50Microseconds}, accurate to within a factor of 2.
+   */
+  p99Microseconds: number
+  /**
+   * The number of operations per duration bucket, where bucket `i` counts
+   * operations that took less than `2^i` nanoseconds (and at least `2^(i-1)`).
+   * The last bucket also counts all slower operations.
+   * Empty if stats are disabled.
+   */
+  histogram: number[]
+}
+
+/**
+ * Statistics about the operations and the file of an MMKV instance,
+ * see {@linkcode MMKV.getStats | getStats()}.
+ */
+export interface InstanceStats {
+  /**
+   * Whether stats are collected at all. They can be disabled at build time,
+   * in which case all operation stats and file events are `0`.
+   */
+  isEnabled: boolean
+  /**
+   * Reads of single values, including reads in {@linkcode MMKV.getMany | getMany(...)}.
+   */
+  get: OperationStats
+  /**
+   * Writes of single values, including writes in {@linkcode MMKV.writeBatch | writeBatch(...)}.
+   */
+  set: OperationStats
+  /**
+   * Removals, where all removals of one {@linkcode MMKV.writeBatch | writeBatch(...)} count as one.
+   */
+  remove: OperationStats
+  /**
+   * Calls of all value-changed listeners for a change.
+   */
+  notify: OperationStats
+  /**
+   * The number of bytes appended to the file.
+   *
+   * The file is only looked at when stats are read, so this and the file
+   * events below cover what changed between two `getStats()` calls - bytes
+   * appended right before a full write-back are not counted, and several
+   * growths or write-backs in between count as one.
+   */
+  bytesWritten: number
+  /**
+   * The number of times the file was seen to have grown.
+   */
+  fileGrowths: number
+  /**
+   * The number of times the file was seen to have been rewritten from scratch,
+   * which MMKV does instead of growing it once it is full of overwritten and
+   * removed values.
+   */
+  fullWriteBacks: number
+  /**
+   * The number of value-changed listeners that are currently added.
+   */
+  listenerCount: number
+  /**
+   * The (estimated) number of bytes of the file that hold live values.
+   * Estimating it visits every key, so it is re-used for up to 5 seconds.
+   */
+  liveBytes: number
+  /**
+   * The size of the file, in bytes.
+   */
+  fileBytes: number
+}
+
+/**
+ * A single key/value pair to write in a {@linkcode MMKV.writeBatch | writeBatch(...)}.
+ */
+export interface WriteBatchEntry {
+  key: string
+  value: boolean | string | number | ArrayBuffer
+}
+
+/**
+ * An MMKV instance.
+ *
+ * The same instance can be used from multiple JS runtimes at the same time (e.g. the
+ * main JS runtime and worklet or background runtimes) - all of its methods are thread-safe.
+ * Reads do not go through the JS thread, but MMKV runs one operation at a time per
+ * instance, so concurrent reads from multiple runtimes are serialized.
+ * Value-changed listeners are always called on the JS runtime that added them.
+ */
 export interface MMKV extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   /**
    * Get the ID of this {@linkcode MMKV} instance.
@@ -38,10 +206,51 @@ export interface MMKV extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
   /**
    * Set a {@linkcode value} for the given {@linkcode key}.
    *
+   * @param options Optionally, a time-to-live after which the value expires.
    * @throws an Error if the {@linkcode key} is empty.
    * @throws an Error if the {@linkcode value} cannot be set.
+   *
+   * @example
+   * ```ts
+   * // Expires in one hour
+   * storage.set('response.user', json, { ttlSeconds: 60 * 60 })
+   * ```
    */
-  set(key: string, value: boolean | string | number | ArrayBuffer): void
+  set(
+    key: string,
+    value: boolean | string | number | ArrayBuffer,
+    options?: SetOptions
+  ): void
+  /**
+   * Set a string {@linkcode value} for the given {@linkcode key}.
+   *
+   * This is a faster alternative to {@linkcode set | set(...)} if
+   * the type of the value is known to be a string.
+   *
+   * @throws an Error if the {@linkcode key} is empty.
+   * @throws an Error if the {@linkcode value} cannot be set.
+   */
+  setString(key: string, value: string): void
+  /**
+   * Set a number {@linkcode value} for the given {@linkcode key}.
+   *
+   * This is a faster alternative to {@linkcode set | set(...)} if
+   * the type of the value is known to be a number.
+   *
+   * @throws an Error if the {@linkcode key} is empty.
+   * @throws an Error if the {@linkcode value} cannot be set.
+   */
+  setNumber(key: string, value: number): void
+  /**
+   * Set a boolean {@linkcode value} for the given {@linkcode key}.
+   *
+   * This is a faster alternative to {@linkcode set | set(...)} if
+   * the type of the value is known to be a boolean.
+   *
+   * @throws an Error if the {@linkcode key} is empty.
+   * @throws an Error if the {@linkcode value} cannot be set.
+   */
+  setBoolean(key: string, value: boolean): void
   /**
    * Get the boolean value for the given `key`, or `undefined` if it does not exist.
    *
@@ -66,6 +275,32 @@ export interface MMKV extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
    * @default undefined
    */
   getBuffer(key: string): ArrayBuffer | undefined
+  /**
+   * Reads the raw buffer value of the given `key` directly into the given
+   * {@linkcode buffer}, without allocating a new `ArrayBuffer`.
+   *
+   * The bytes are copied straight from MMKV's memory-mapped file into
+   * {@linkcode buffer}, so re-using the same {@linkcode buffer} for large values
+   * avoids an extra allocation and copy per read compared to
+   * {@linkcode getBuffer | getBuffer(...)}.
+   *
+   * @returns The size of the value in bytes, or `undefined` if it does not exist.
+   * If the returned size is larger than `buffer.byteLength`, nothing has been written
+   * and you need to try again with a larger {@linkcode buffer}.
+   * (For values stored with `compression`,
+   * the contents of {@linkcode buffer} are undefined in that case.)
+   *
+   * @example
+   * ```ts
+   * let buffer = new ArrayBuffer(1024 * 1024)
+   * let size = storage.getBufferInto('image', buffer)
+   * if (size != null && size > buffer.byteLength) {
+   *   buffer = new ArrayBuffer(size)
+   *   size = storage.getBufferInto('image', buffer)
+   * }
+   * ```
+   */
+  getBufferInto(key: string, buffer: ArrayBuffer): number | undefined
   /**
    * Checks whether the given `key` is being stored in this MMKV instance.
    */
@@ -140,11 +375,264 @@ export interface MMKV extends HybridObject<{ ios: 'c++'; android: 'c++' }> {
    * To unsubscribe from value changes, call `remove()` on the Listener.
    */
   addOnValueChangedListener(onValueChanged: (key: string) => void): Listener
+  /**
+   * Adds a value changed listener for a single {@linkcode key}. The Listener will only
+   * be called whenever the value for the given {@linkcode key} changes (set or delete).
+   *
+   * This is more efficient than filtering by key inside a listener added with
+   * {@linkcode addOnValueChangedListener | addOnValueChangedListener(...)}, as
+   * listeners for other keys are never called.
+   *
+   * To unsubscribe from value changes, call `remove()` on the Listener.
+   */
+  addOnKeyChangedListener(
+    key: string,
+    onValueChanged: (key: string) => void
+  ): Listener
+  /**
+   * Adds a value changed listener for all keys that start with the given
+   * {@linkcode prefix}. The Listener will only be called whenever the value for
+   * a key with the given {@linkcode prefix} changes (set or delete).
+   *
+   * To unsubscribe from value changes, call `remove()` on the Listener.
+   */
+  addOnKeyPrefixChangedListener(
+    prefix: string,
+    onValueChanged: (key: string) => void
+  ): Listener
+  /**
+   * Adds a batched value changed listener. Instead of being called synchronously
+   * for every single change, the Listener is called asynchronously (on the JS thread)
+   * with all keys that changed since the last call, de-duplicated.
+   *
+   * A burst of many writes (e.g. 1000x {@linkcode set | set(...)}) therefore only
+   * results in a single call, which makes it a good fit for triggering re-renders.
+   *
+   * To unsubscribe from value changes, call `remove()` on the Listener. Pending
+   * changes that have not been delivered yet will be dropped.
+   *
+   * With a {@linkcode flushIntervalMs} of `0`, changes are not collected - the Listener is
+   * called right away, once for every write and once with all keys of a
+   * {@linkcode writeBatch | writeBatch(...)}.
+   *
+   * @param onValuesChanged Called with all keys that changed (set or delete) since the last call.
+   * @param flushIntervalMs How long to collect changes after the first change before calling {@linkcode onValuesChanged}. Default: `16` (one frame)
+   */
+  addOnValuesChangedListener(
+    onValuesChanged: (keys: string[]) => void,
+    flushIntervalMs?: number
+  ): Listener
 
   /**
    * Imports all keys and values from the
    * given other {@linkcode MMKV} instance.
+   *
+   * Imported values are compressed or stored in blobs according
+   * to this instance's configuration, not the other one's.
    * @returns the number of imported keys/values.
    */
   importAllFrom(other: MMKV): number
+
+  /**
+   * Get the values for all of the given {@linkcode keys} in a single native call.
+   *
+   * This is faster than calling {@linkcode getString | getString(...)},
+   * {@linkcode getNumber | getNumber(...)}, {@linkcode getBoolean | getBoolean(...)}
+   * or {@linkcode getBuffer | getBuffer(...)} once per key, as all keys are read
+   * while holding the instance's lock only once.
+   *
+   * @param keys The keys to read.
+   * @param types The type to read each key as, at the same index as in {@linkcode keys}. Default: all `'string'`
+   * @returns The values for all {@linkcode keys} in the same order, or `undefined` for keys that do not exist.
+   * @throws an Error if {@linkcode types} is not the same length as {@linkcode keys}.
+   *
+   * @example
+   * ```ts
+   * const [name, age, isAdmin] = storage.getMany(
+   *   ['user.name', 'user.age', 'user.isAdmin'],
+   *   ['string', 'number', 'boolean']
+   * )
+   * ```
+   */
+  getMany(
+    keys: string[],
+    types?: ValueType[]
+  ): (boolean | string | number | ArrayBuffer | undefined)[]
+
+  /**
+   * Writes all given {@linkcode entries} and removes all given
+   * {@linkcode removals} in a single native call.
+   *
+   * All entries are validated (and large values compressed or written to
+   * their blobs) before anything is written, and the batch is applied while
+   * holding the instance's lock, so other threads or processes never observe
+   * a batch that is still being applied.
+   * This is not a transaction though - if writing a value fails, the entries
+   * before it stay written, listeners are notified about them, and then an
+   * Error is thrown.
+   * Listeners are notified after the whole batch has been applied. Listeners added with
+   * {@linkcode addOnValuesChangedListener | addOnValuesChangedListener(...)} receive all
+   * changed keys in a single call, while listeners for single keys are called once
+   * for every changed key.
+   *
+   * @throws an Error if any of the {@linkcode entries} has an empty key.
+   * @throws an Error if a value cannot be set.
+   *
+   * @example
+   * ```ts
+   * storage.writeBatch(
+   *   [
+   *     { key: 'user.name', value: 'Marc' },
+   *     { key: 'user.age', value: 21 },
+   *   ],
+   *   ['user.token']
+   * )
+   * ```
+   */
+  writeBatch(entries: WriteBatchEntry[], removals?: string[]): void
+
+  /**
+   * Asynchronously set a {@linkcode value} for the given {@linkcode key}.
+   *
+   * The write happens on a native background thread, so writing large strings or
+   * buffers (which may grow the file or trigger a full write-back) does not block the JS thread.
+   * {@linkcode ArrayBuffer}s are copied before the call returns, so the given buffer can be
+   * safely modified afterwards.
+   *
+   * @throws an Error (rejects) if the {@linkcode key} is empty.
+   * @throws an Error (rejects) if the {@linkcode value} cannot be set.
+   */
+  setAsync(
+    key: string,
+    value: boolean | string | number | ArrayBuffer
+  ): Promise<void>
+  /**
+   * Asynchronously get a string value for the given {@linkcode key}
+   * on a native background thread.
+   *
+   * @see {@linkcode getString | getString(...)}
+   */
+  getStringAsync(key: string): Promise<string | undefined>
+  /**
+   * Asynchronously get a buffer value for the given {@linkcode key}
+   * on a native background thread.
+   *
+   * @see {@linkcode getBuffer | getBuffer(...)}
+   */
+  getBufferAsync(key: string): Promise<ArrayBuffer | undefined>
+  /**
+   * Asynchronously imports all keys and values from the given other
+   * {@linkcode MMKV} instance on a native background thread.
+   *
+   * @see {@linkcode importAllFrom | importAllFrom(...)}
+   * @returns the number of imported keys/values.
+   */
+  importAllFromAsync(other: MMKV): Promise<number>
+  /**
+   * Asynchronously trims the storage space and clears memory cache
+   * on a native background thread.
+   *
+   * @see {@linkcode trim | trim()}
+   */
+  trimAsync(): Promise<void>
+  /**
+   * Writes all changes that have not been written to disk yet.
+   *
+   * Only dirty pages are written, so this is cheap if little has changed.
+   * Use this to make sure important data survives a crash or power loss,
+   * without configuring a stricter `syncPolicy` for the whole instance.
+   *
+   * @param durability Whether to wait until the data is on disk. Default: `'sync'`
+   */
+  flush(durability?: Durability): void
+  /**
+   * Get a {@linkcode KeyHandle} for the given {@linkcode key}.
+   *
+   * Reading or writing through a handle skips converting the key
+   * on every call, which is faster for keys that are used very often.
+   *
+   * @example
+   * ```ts
+   * const position = storage.key('playback.position')
+   * // On every frame:
+   * position.setNumber(player.currentTime)
+   * ```
+   */
+  key(key: string): KeyHandle
+  /**
+   * Set a 32-bit integer value for the given {@linkcode key}.
+   *
+   * Integers are stored as varints, which takes less space than a `number`
+   * for small values.
+   *
+   * @throws an Error if {@linkcode value} is not an integer in the 32-bit range.
+   */
+  setInt(key: string, value: number): void
+  /**
+   * Get the 32-bit integer value for the given {@linkcode key},
+   * or `undefined` if it does not exist.
+   *
+   * The value must have been written with {@linkcode setInt | setInt(...)}.
+   */
+  getInt(key: string): number | undefined
+  /**
+   * Set a 64-bit integer value for the given {@linkcode key}.
+   */
+  setInt64(key: string, value: bigint): void
+  /**
+   * Get the 64-bit integer value for the given {@linkcode key},
+   * or `undefined` if it does not exist.
+   *
+   * The value must have been written with {@linkcode setInt64 | setInt64(...)},
+   * {@linkcode increment | increment(...)} or {@linkcode compareAndSet | compareAndSet(...)}.
+   */
+  getInt64(key: string): bigint | undefined
+  /**
+   * Atomically adds {@linkcode delta} to the 64-bit integer value of the given
+   * {@linkcode key}, and returns the new value.
+   * A key that does not exist yet is treated as `0`.
+   *
+   * The read and the write happen under the instance's lock (and the cross-process
+   * lock in `multi-process` mode), so concurrent increments are never lost.
+   *
+   * @param delta The integer to add. Default: `1`
+   * @throws an Error if {@linkcode delta} is not an integer.
+   * @throws an Error if the new value would be outside of the safe integer
+   * range of a JS number (`Number.MAX_SAFE_INTEGER`) - then it is not changed.
+   */
+  increment(key: string, delta?: number): number
+  /**
+   * Atomically sets the 64-bit integer value of the given {@linkcode key} to
+   * {@linkcode next}, but only if its current value is {@linkcode expected}.
+   *
+   * @returns `true` if the value was set, `false` if the current value
+   * was different (or did not exist).
+   * @throws an Error if {@linkcode expected} or {@linkcode next} is not an integer.
+   */
+  compareAndSet(key: string, expected: number, next: number): boolean
+  /**
+   * Removes all expired values on a native background thread, and compacts
+   * the file afterwards if anything was removed.
+   *
+   * This also happens automatically about once a minute for instances that
+   * use expiration - see `defaultTTLSeconds` and {@linkcode SetOptions.ttlSeconds}.
+   *
+   * @returns The number of values that were removed.
+   */
+  removeExpiredKeys(): Promise<number>
+  /**
+   * Get statistics about the compactions of this instance's file since it was
+   * created, both automatic ones (see `autoCompactionThreshold`) and ones
+   * caused by {@linkcode trim | trim()}, evictions or expirations.
+   */
+  getCompactionStats(): CompactionStats
+  /**
+   * Get statistics about the operations on this instance since it was
+   * created - counts and latencies of reads, writes, removals and listener
+   * notifications, file events, and how much of the file holds live values.
+   *
+   * Collecting them costs a few nanoseconds per operation, see the
+   * README on how to disable them at build time.
+   */
+  getStats(): InstanceStats
 }
@@ -1,5 +1,5 @@
 import type { HybridObject } from 'react-native-nitro-modules'
-import type { MMKV } from './MMKV.nitro'
+import type { InstanceStats, MMKV } from './MMKV.nitro'
 
 /**
  * Configures the mode of the MMKV instance.
@@ -15,6 +15,22 @@ export type Mode = 'single-process' | 'multi-process'
  */
 export type EncryptionType = 'AES-128' | 'AES-256'
 
+/**
+ * Configures when written data is synced (flushed) to disk.
+ * - `os`: The OS decides when dirty pages are written back. Fastest, but recent writes may be lost if the device loses power.
+ * - `periodic`: Dirty pages are synced in the background at most every {@linkcode Configuration.syncIntervalMs | syncIntervalMs}.
+ * - `every-write`: Every write blocks until it is on disk. Slowest, but nothing is ever lost.
+ * - `every-batch`: Every {@linkcode MMKV.writeBatch | writeBatch(...)}, {@linkcode MMKV.importAllFrom | importAllFrom(...)} and {@linkcode MMKV.clearAll | clearAll()} blocks until it is on disk, single writes are left to the OS.
+ */
+export type SyncPolicy = 'os' | 'periodic' | 'every-write' | 'every-batch'
+
+/**
+ * How large values are compressed before they are stored.
+ * - `none`: Values are stored as-is.
+ * - `lz4`: Values of at least {@linkcode Configuration.compressionThresholdBytes | compressionThresholdBytes} are compressed with LZ4, a fast codec that typically shrinks JSON 3-10x.
+ */
+export type Compression = 'none' | 'lz4'
+
 /**
  * Used for configuration of a single MMKV instance.
  */
@@ -94,6 +110,172 @@ export interface Configuration {
    * @default false
    */
   compareBeforeSet?: boolean
+  /**
+   * Configures when written data is synced to disk.
+   *
+   * Only pay for durability where you need it - e.g. use `'every-write'` for
+   * payment or session state, and leave UI caches on `'os'`.
+   *
+   * @example
+   * ```ts
+   * const sessionStorage = createMMKV({ id: 'session', syncPolicy: 'every-write' })
+   * ```
+   *
+   * @default 'os'
+   */
+  syncPolicy?: SyncPolicy
+  /**
+   * The maximum interval between a write and the next sync if
+   * {@linkcode syncPolicy} is `'periodic'`, in milliseconds.
+   *
+   * @default 1000
+   */
+  syncIntervalMs?: number
+  /**
+   * If `true`, the MMKV instance is not opened when it is created, but
+   * in the background right after, or on its first use - whichever comes first.
+   *
+   * Opening an instance maps its file, verifies its checksum, decrypts it and
+   * parses all keys - so if you create many instances at startup that are not
+   * used right away, this moves that work off the JS thread.
+   *
+   * @note Errors while opening (e.g. an invalid `encryptionKey`) will be thrown by the first operation instead of by {@linkcode MMKVFactory.createMMKV | createMMKV(...)}.
+   * @default false
+   */
+  lazy?: boolean
+  /**
+   * The time-to-live of all values written to this instance, in seconds.
+   *
+   * Expired values are treated as if they did not exist, and are removed
+   * by a native background sweeper about once a minute.
+   * A single value can override this with
+   * {@linkcode MMKV.set | set(key, value, { ttlSeconds })}.
+   *
+   * @note Enabling expiration upgrades the MMKV file to a format that
+   * stores an expiration date per value.
+   * @default undefined (values never expire)
+   */
+  defaultTTLSeconds?: number
+  /**
+   * The maximum size of the MMKV file, in bytes.
+   *
+   * Once a write makes the file grow larger than this, it is compacted in
+   * the background, and if that is not enough, the least recently used
+   * keys are evicted until it is below 90% of this limit.
+   * Evicted keys are reported to value-changed listeners like removals.
+   *
+   * @note Recency is only tracked in memory - after a restart, all keys
+   * count as least recently used until they are read or written again.
+   * @default undefined (unlimited)
+   */
+  maxBytes?: number
+  /**
+   * The maximum number of keys in this instance.
+   *
+   * Once a write adds more keys than this, the least recently used keys
+   * are evicted in the background until there are at most 90% of this
+   * limit left.
+   * Evicted keys are reported to value-changed listeners like removals.
+   *
+   * @note Recency is only tracked in memory - after a restart, all keys
+   * count as least recently used until they are read or written again.
+   * @default undefined (unlimited)
+   */
+  maxEntries?: number
+  /**
+   * Compresses large string and buffer values before they are stored, and
+   * decompresses them transparently when they are read.
+   *
+   * This keeps the file small and makes writes of large values cheaper,
+   * at the cost of some CPU time per read and write of those values.
+   * Compressed and uncompressed values can live in the same instance, so
+   * this can be turned on or off at any time.
+   *
+   * @example
+   * ```ts
+   * const responseCache = createMMKV({ id: 'responses', compression: 'lz4' })
+   * ```
+   *
+   * @note Compressed values cannot be read by older versions of react-native-mmkv.
+   * @note Compressed values can only be read if this is set (or {@linkcode blobThresholdBytes}
+   * is) - to stop compressing new values of an instance, set it to `'none'` instead of removing it.
+   * @default 'none'
+   */
+  compression?: Compression
+  /**
+   * The minimum size of a value to be compressed if {@linkcode compression}
+   * is enabled, in bytes. Smaller values rarely shrink enough to be worth it.
+   *
+   * @default 4096
+   */
+  compressionThresholdBytes?: number
+  /**
+   * The minimum size of a value to be stored in its own file next to the
+   * MMKV instance instead of in the MMKV file itself, in bytes.
+   *
+   * MMKV appends every write to its file, so repeatedly updating a
+   * multi-megabyte value grows (and compacts) the whole file each time.
+   * Values at or above this size are instead written to a separate file,
+   * and only a small reference to it is kept in MMKV. Reading such a value
+   * maps its file into memory. Files that are no longer referenced are
+   * removed by {@linkcode MMKV.trim | trim()} and by automatic compaction
+   * (see {@linkcode autoCompactionThreshold}).
+   *
+   * This is transparent to all getters and setters, and applies to `string`
+   * and `ArrayBuffer` values after {@linkcode compression}.
+   *
+   * @example
+   * ```ts
+   * const storage = createMMKV({ id: 'drafts', blobThresholdBytes: 256 * 1024 })
+   * ```
+   *
+   * @note Blob files are not encrypted, so this cannot be combined with an {@linkcode encryptionKey}.
+   * @note Values stored in blobs cannot be read by older versions of react-native-mmkv,
+   * or by instances that do not set this (or {@linkcode compression}).
+   * @default undefined (all values are stored in the MMKV file)
+   */
+  blobThresholdBytes?: number
+  /**
+   * Automatically compacts the file on a native background thread once less
+   * than this fraction of it holds live data, e.g. `0.5` to compact once more
+   * than half of the file is taken up by overwritten or removed values.
+   *
+   * MMKV appends every write to its file, so instances that overwrite the same
+   * keys very often can grow to several times the size of their data.
+   * Compaction only runs once the instance had no writes for two seconds,
+   * never for files smaller than 256 KB, and is skipped if it is estimated to
+   * block reads and writes for more than 20 milliseconds - call
+   * {@linkcode MMKV.trim | trim()} at a convenient time for such instances.
+   *
+   * @example
+   * ```ts
+   * const playback = createMMKV({ id: 'playback', autoCompactionThreshold: 0.5 })
+   * ```
+   *
+   * @see {@linkcode MMKV.getCompactionStats | getCompactionStats()}
+   * @default undefined (the file is only compacted by MMKV itself once it is full, or by `trim()`)
+   */
+  autoCompactionThreshold?: number
+}
+
+/**
+ * Statistics about the cache of MMKV instances that
+ * {@linkcode MMKVFactory.createMMKV | createMMKV(...)} returns instances from.
+ */
+export interface InstanceCacheStats {
+  /**
+   * The number of `createMMKV(...)` calls that returned an
+   * already existing instance.
+   */
+  hits: number
+  /**
+   * The number of `createMMKV(...)` calls that had to create a new instance.
+   */
+  misses: number
+  /**
+   * The number of instances that are currently alive and cached.
+   */
+  size: number
 }
 
 export interface MMKVFactory extends HybridObject<{
@@ -107,15 +289,29 @@ export interface MMKVFactory extends HybridObject<{
   initializeMMKV(rootPath: string): void
 
   /**
-   * Create a new {@linkcode MMKV} instance with the given {@linkcode Configuration}
+   * Create a new {@linkcode MMKV} instance with the given {@linkcode Configuration}.
+   *
+   * If an instance with the same `id`, `path` and encryption settings is still
+   * alive, that instance is returned instead of creating a new one - also if it
+   * was created in a different JS runtime (e.g. a worklet or background runtime).
+   * If that instance was created with different options (e.g. a different `mode`),
+   * a warning is logged and a new instance is created.
    */
   createMMKV(configuration: Configuration): MMKV
 
   /**
    * Deletes the MMKV instance with the
    * given {@linkcode id}.
+   *
+   * If the instance was created with a custom `path`, the same
+   * {@linkcode path} must be passed here, otherwise the instance
+   * in the default root directory is deleted.
+   *
+   * Background work of instances of it (e.g. pending async calls)
+   * is finished or cancelled first. The instances themselves must
+   * not be used anymore afterwards.
    */
-  deleteMMKV(id: string): boolean
+  deleteMMKV(id: string, path?: string): boolean
 
   /**
    * Returns `true` if an MMKV instance with the
@@ -123,6 +319,45 @@ export interface MMKVFactory extends HybridObject<{
    */
   existsMMKV(id: string): boolean
 
+  /**
+   * Opens all MMKV instances with the given {@linkcode configurations}
+   * concurrently on native background threads.
+   *
+   * Once the returned Promise resolves, {@linkcode createMMKV} calls with the same
+   * {@linkcode Configuration} return instantly, as the instances are already open.
+   *
+   * @throws an Error (rejects) if any of the instances could not be opened.
+   */
+  preloadMMKV(configurations: Configuration[]): Promise<void>
+
+  /**
+   * Get the hit/miss statistics of the instance cache used by {@linkcode createMMKV}.
+   */
+  getInstanceCacheStats(): InstanceCacheStats
+
+  /**
+   * Get the {@linkcode MMKV.getStats | stats} of all MMKV instances that are
+   * currently alive and open, summed up.
+   */
+  getStats(): InstanceStats
+
+  /**
+   * Starts tracing all MMKV operations (creating and opening instances,
+   * reads, writes, `trim()`, imports, encryption and listener calls) to a
+   * Chrome trace file, which can be opened in https://ui.perfetto.dev.
+   *
+   * @param filePath The file to write to, replaced if it exists.
+   * Defaults to `mmkv-trace.json` in MMKV's root directory.
+   * @returns The path of the trace file.
+   */
+  startTracing(filePath?: string): string
+
+  /**
+   * Stops tracing started by {@linkcode startTracing}, and completes the
+   * trace file.
+   */
+  stopTracing(): void
+
   /**
    * Get the default MMKV instance's ID.
    * @default 'mmkv.default'
@@ -0,0 +1,23 @@
+import { getMMKVFactory } from '../getMMKVFactory'
+import { isTest } from '../isTest'
+
+/**
+ * Starts tracing all MMKV operations on native threads and the JS thread
+ * to a Chrome trace file, until {@linkcode stopMMKVTracing} is called.
+ *
+ * Each event contains the operation, the instance ID and the sizes of the
+ * key and value. Open the file in https://ui.perfetto.dev to see whether
+ * MMKV was busy when a frame was dropped.
+ *
+ * @param filePath The file to write to, replaced if it exists.
+ * Defaults to `mmkv-trace.json` in MMKV's root directory.
+ * @returns The path of the trace file.
+ */
+export function startMMKVTracing(filePath?: string): string {
+  if (isTest()) {
+    return filePath ?? ''
+  }
+
+  const factory = getMMKVFactory()
+  return factory.startTracing(filePath)
+}
@@ -0,0 +1,4 @@
+export function startMMKVTracing(filePath?: string): string {
+  // localStorage operations are already visible in the browser's profiler
+  return filePath ?? ''
+}
@@ -0,0 +1,15 @@
+import { getMMKVFactory } from '../getMMKVFactory'
+import { isTest } from '../isTest'
+
+/**
+ * Stops tracing started by `startMMKVTracing(...)`, and completes the
+ * trace file.
+ */
+export function stopMMKVTracing(): void {
+  if (isTest()) {
+    return
+  }
+
+  const factory = getMMKVFactory()
+  factory.stopTracing()
+}
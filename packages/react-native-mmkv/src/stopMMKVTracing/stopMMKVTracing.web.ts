@@ -0,0 +1,3 @@
+export function stopMMKVTracing(): void {
+  // Tracing is never started on web
+}
@@ -6,6 +6,8 @@ CPP_DIRS=(
   # react-native-mmkv
   "packages/react-native-mmkv/android/src/main/cpp"
   "packages/react-native-mmkv/cpp"
+  "packages/react-native-mmkv/native-tests"
+  "packages/react-native-mmkv/native-benchmarks"
   "packages/react-native-mmkv/ios"
 )
 